@@ -46,6 +46,8 @@ Rps_Agenda::agenda_priority_names[Rps_Agenda::AgPrio__Last];
 std::atomic<Rps_Agenda::workthread_state_en>
 Rps_Agenda::agenda_work_thread_state_[RPS_NBJOBS_MAX+2];
 std::atomic<bool> Rps_Agenda::agenda_needs_garbcoll_;
+std::atomic<bool> Rps_Agenda::agenda_pause_requested_;
+std::atomic<int> Rps_Agenda::agenda_gcdefer_count_;
 std::atomic<uint64_t> Rps_Agenda::agenda_cumulw_gc_;
 std::atomic<Rps_CallFrame*> Rps_Agenda::agenda_work_gc_callframe_[RPS_NBJOBS_MAX+2];
 
@@ -131,6 +133,7 @@ Rps_Agenda::add_tasklet(agenda_prio_en prio, Rps_ObjectRef obtasklet)
   std::lock_guard<std::recursive_mutex> gu(agenda_mtx_);
   agenda_fifo_[prio].push_back(obtasklet);
   agenda_add_counter_.fetch_add(1);
+  the_agenda()->touch_now();
   Rps_Agenda::agenda_changed_condvar_.notify_all();
 } // end Rps_Agenda::add_tasklet
 
@@ -148,6 +151,7 @@ Rps_Agenda::fetch_tasklet_to_run(void)
         continue;
       res = curfifo.front();
       curfifo.pop_front();
+      the_agenda()->touch_now();
       return res;
     }
   return nullptr;
@@ -202,13 +206,37 @@ Rps_Agenda::run_agenda_worker(int ix)
   }
   while (agenda_is_running_.load())
     {
+      if (Rps_Agenda::agenda_pause_requested_.load())
+        {
+          agenda_work_thread_state_[ix].store(WthrAg_Paused);
+          Rps_Agenda::agenda_changed_condvar_.notify_all();
+          std::unique_lock<std::recursive_mutex> ulock(agenda_mtx_);
+          Rps_Agenda::agenda_changed_condvar_.wait_for(ulock, 5ms, []
+          {
+            return !Rps_Agenda::agenda_pause_requested_.load();
+          });
+          if (!Rps_Agenda::agenda_pause_requested_.load())
+            agenda_work_thread_state_[ix].store(WthrAg_Idle);
+          continue;
+        }
       if (Rps_Agenda::agenda_cumulw_gc_.load() + Rps_Agenda::agenda_gc_threshold
           > Rps_QuasiZone::cumulative_allocated_wordcount())
         {
           Rps_Agenda::agenda_needs_garbcoll_.store(true);
           std::this_thread::sleep_for(1ms/2);
         }
-      if (Rps_Agenda::agenda_needs_garbcoll_.load())
+      /// a deferred garbage collection is not started, but one
+      /// already started by another worker thread is joined
+      bool dogc = false;
+      {
+        std::lock_guard<std::recursive_mutex> gu(agenda_mtx_);
+        dogc = Rps_Agenda::agenda_needs_garbcoll_.load()
+               && (Rps_Agenda::agenda_gcdefer_count_.load() == 0
+                   || some_worker_collects_garbage());
+        if (dogc)
+          agenda_work_thread_state_[ix].store(WthrAg_GC);
+      }
+      if (dogc)
         Rps_Agenda::do_garbage_collect(ix, &_);
       else
         try
@@ -239,6 +267,9 @@ Rps_Agenda::run_agenda_worker(int ix)
                   }
               }
               break;
+              case WthrAg_Paused:
+                agenda_work_thread_state_[ix].store(WthrAg_Idle);
+                break;
               case WthrAg_GC:
               {
                 std::this_thread::sleep_for(1ms);
@@ -350,6 +381,85 @@ Rps_Agenda::do_garbage_collect(int ix, Rps_CallFrame*callframe)
   // thread will resume usual work if agenda is non-empty....
 } // end of Rps_Agenda::do_garbage_collect
 
+bool
+Rps_Agenda::some_worker_collects_garbage(void)
+{
+  for (int wix=1; wix<=rps_nbjobs && wix<=RPS_NBJOBS_MAX; wix++)
+    if (agenda_thread_array_[wix].load()
+        && agenda_work_thread_state_[wix].load() == WthrAg_GC)
+      return true;
+  return false;
+} // end Rps_Agenda::some_worker_collects_garbage
+
+int
+Rps_Agenda::current_worker_index(void)
+{
+  for (int wix=1; wix<=rps_nbjobs && wix<=RPS_NBJOBS_MAX; wix++)
+    {
+      std::thread*curthr = agenda_thread_array_[wix].load();
+      if (curthr && curthr->get_id() == std::this_thread::get_id())
+        return wix;
+    }
+  return 0;
+} // end Rps_Agenda::current_worker_index
+
+void
+Rps_Agenda::defer_garbage_collection(void)
+{
+  using namespace std::chrono_literals;
+  {
+    std::lock_guard<std::recursive_mutex> gu(agenda_mtx_);
+    agenda_gcdefer_count_.fetch_add(1);
+  }
+  while (some_worker_collects_garbage())
+    {
+      agenda_changed_condvar_.notify_all();
+      std::this_thread::sleep_for(1ms);
+    }
+} // end Rps_Agenda::defer_garbage_collection
+
+void
+Rps_Agenda::allow_garbage_collection(void)
+{
+  RPS_ASSERT(agenda_gcdefer_count_.load() > 0);
+  agenda_gcdefer_count_.fetch_sub(1);
+  agenda_changed_condvar_.notify_all();
+} // end Rps_Agenda::allow_garbage_collection
+
+/// Worker threads check for a pause before fetching their next
+/// tasklet, so a running tasklet is completed before its thread is
+/// paused.
+void
+Rps_Agenda::pause_workers(void)
+{
+  using namespace std::chrono_literals;
+  int selfix = current_worker_index();
+  agenda_pause_requested_.store(true);
+  for (;;)
+    {
+      agenda_changed_condvar_.notify_all();
+      bool allpaused = true;
+      for (int wix=1; wix<=rps_nbjobs && wix<=RPS_NBJOBS_MAX && allpaused; wix++)
+        {
+          if (wix == selfix || !agenda_thread_array_[wix].load())
+            continue;
+          workthread_state_en st = agenda_work_thread_state_[wix].load();
+          if (st != WthrAg_Paused && st != WthrAg__None)
+            allpaused = false;
+        }
+      if (allpaused)
+        break;
+      std::this_thread::sleep_for(1ms/4);
+    }
+} // end Rps_Agenda::pause_workers
+
+void
+Rps_Agenda::resume_workers(void)
+{
+  agenda_pause_requested_.store(false);
+  agenda_changed_condvar_.notify_all();
+} // end Rps_Agenda::resume_workers
+
 /// start and run the agenda mechanism. This does not return till the
 /// agenda has stopped.
 void
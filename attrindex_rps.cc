@@ -0,0 +1,445 @@
+/****************************************************************
+ * file attrindex_rps.cc
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * Description:
+ *      This file is part of the Reflective Persistent System.
+ *
+ *      It has the code for attribute indexes, secondary indexes
+ *      associating the values of some attribute to the set of
+ *      objects having that attribute with that value.
+ *
+ * Author(s):
+ *      Basile Starynkevitch <basile@starynkevitch.net>
+ *      Abhishek Chakravarti <abhishek@taranjali.org>
+ *      Nimesh Neema <nimeshneema@gmail.com>
+ *
+ *      © Copyright 2026 The Reflective Persistent System Team
+ *      team@refpersys.org & http://refpersys.org/
+ *
+ * License:
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "refpersys.hh"
+
+extern "C" const char rps_attrindex_gitid[];
+const char rps_attrindex_gitid[]= RPS_GITID;
+
+extern "C" const char rps_attrindex_date[];
+const char rps_attrindex_date[]= __DATE__;
+
+/// Locking order: the ob_mtx of an indexed object, then
+/// attrix_regmtx, then the attrix_mtx of some index.  The owned
+/// objects are weakly indexed: the garbage collector does not mark
+/// them, and Rps_ObjectZone::~Rps_ObjectZone removes them. Likewise
+/// the dump keeps only the owned objects which it reached otherwise.
+
+std::recursive_mutex Rps_PayloadAttrIndex::attrix_regmtx;
+std::unordered_map<Rps_ObjectZone*,std::set<Rps_PayloadAttrIndex*>> Rps_PayloadAttrIndex::attrix_registry;
+std::atomic<unsigned> Rps_PayloadAttrIndex::attrix_count;
+
+Rps_PayloadAttrIndex::Rps_PayloadAttrIndex(Rps_ObjectZone*obz)
+  : Rps_Payload(Rps_Type::PaylAttrIndex, obz),
+    attrix_attr(nullptr),
+    attrix_mtx(),
+    attrix_hashmap(),
+    attrix_sortedkeys(),
+    attrix_ownermap()
+{
+} // end Rps_PayloadAttrIndex::Rps_PayloadAttrIndex
+
+
+Rps_PayloadAttrIndex::~Rps_PayloadAttrIndex()
+{
+  if (attrix_attr)
+    {
+      std::lock_guard<std::recursive_mutex> gureg(attrix_regmtx);
+      auto it = attrix_registry.find(attrix_attr.optr());
+      if (it != attrix_registry.end())
+        {
+          if (it->second.erase(this) > 0)
+            attrix_count.fetch_sub(1);
+          if (it->second.empty())
+            attrix_registry.erase(it);
+        }
+    }
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  attrix_hashmap.clear();
+  attrix_sortedkeys.clear();
+  attrix_ownermap.clear();
+  attrix_attr = nullptr;
+} // end Rps_PayloadAttrIndex::~Rps_PayloadAttrIndex
+
+
+/// put this index in the registry of its attribute, so that later
+/// changes of that attribute in any object are noticed.
+void
+Rps_PayloadAttrIndex::register_attribute(Rps_ObjectRef obattr)
+{
+  RPS_ASSERT(obattr);
+  if (obattr->ob_magicgetterfun.load())
+    throw RPS_RUNTIME_ERROR_OUT("cannot index magic attribute " << obattr);
+  if (attrix_attr)
+    throw RPS_RUNTIME_ERROR_OUT("attribute index " << Rps_ObjectRef(owner())
+                                << " already indexes " << attrix_attr);
+  std::lock_guard<std::recursive_mutex> gureg(attrix_regmtx);
+  attrix_attr = obattr;
+  if (attrix_registry[obattr.optr()].insert(this).second)
+    attrix_count.fetch_add(1);
+  touch_owner();
+} // end Rps_PayloadAttrIndex::register_attribute
+
+
+void
+Rps_PayloadAttrIndex::note_attribute_change(Rps_ObjectZone*obz, Rps_ObjectZone*obattr, Rps_Value val)
+{
+  RPS_ASSERT(obz != nullptr);
+  std::lock_guard<std::recursive_mutex> gureg(attrix_regmtx);
+  auto it = attrix_registry.find(obattr);
+  if (RPS_LIKELY(it == attrix_registry.end()))
+    return;
+  for (Rps_PayloadAttrIndex*paylix : it->second)
+    paylix->reindex_owner(obz, val);
+} // end Rps_PayloadAttrIndex::note_attribute_change
+
+
+void
+Rps_PayloadAttrIndex::reindex_owner(Rps_ObjectZone*obz, Rps_Value val)
+{
+  RPS_ASSERT(obz != nullptr);
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  auto ownit = attrix_ownermap.find(obz);
+  if (ownit != attrix_ownermap.end())
+    {
+      Rps_Value oldval = ownit->second;
+      if (!val.is_empty() && oldval == val)
+        return;
+      auto hashit = attrix_hashmap.find(oldval);
+      if (hashit != attrix_hashmap.end())
+        {
+          hashit->second.erase(Rps_ObjectRef(obz));
+          if (hashit->second.empty())
+            {
+              attrix_sortedkeys.erase(hashit->first);
+              attrix_hashmap.erase(hashit);
+            }
+        }
+      attrix_ownermap.erase(ownit);
+      if (val.is_empty())
+        touch_owner();
+    }
+  if (val.is_empty())
+    return;
+  auto hashit = attrix_hashmap.find(val);
+  if (hashit == attrix_hashmap.end())
+    {
+      hashit = attrix_hashmap.insert({val, std::set<Rps_ObjectRef>{}}).first;
+      attrix_sortedkeys.insert(val);
+    }
+  hashit->second.insert(Rps_ObjectRef(obz));
+  attrix_ownermap.insert({obz, hashit->first});
+  touch_owner();
+} // end Rps_PayloadAttrIndex::reindex_owner
+
+
+void
+Rps_PayloadAttrIndex::gc_mark(Rps_GarbageCollector&gc) const
+{
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  if (attrix_attr)
+    attrix_attr->gc_mark(gc);
+  for (Rps_Value keyv : attrix_sortedkeys)
+    keyv.gc_mark(gc);
+} // end Rps_PayloadAttrIndex::gc_mark
+
+
+/// An index whose owner is not marked goes away in the sweep, and so
+/// may the keys it alone marked. The destructor of an owned object
+/// swept after them would reindex it by a freed key, so such indexes
+/// are unregistered before the sweep starts.
+void
+Rps_PayloadAttrIndex::forget_unmarked_indexes(Rps_GarbageCollector&gc)
+{
+  std::lock_guard<std::recursive_mutex> gureg(attrix_regmtx);
+  for (auto regit = attrix_registry.begin(); regit != attrix_registry.end(); )
+    {
+      for (auto ixit = regit->second.begin(); ixit != regit->second.end(); )
+        {
+          Rps_ObjectZone*ownobz = (*ixit)->owner();
+          if (!ownobz || !ownobz->is_gcmarked(gc))
+            {
+              ixit = regit->second.erase(ixit);
+              attrix_count.fetch_sub(1);
+            }
+          else
+            ixit++;
+        }
+      if (regit->second.empty())
+        regit = attrix_registry.erase(regit);
+      else
+        regit++;
+    }
+} // end Rps_PayloadAttrIndex::forget_unmarked_indexes
+
+
+void
+Rps_PayloadAttrIndex::dump_scan(Rps_Dumper*du) const
+{
+  RPS_ASSERT(du != nullptr);
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  if (!attrix_attr)
+    return;
+  rps_dump_scan_object(du, attrix_attr);
+  // the owners are weak, so not scanned
+  for (auto it : attrix_hashmap)
+    if (rps_is_dumpable_value(du, it.first))
+      rps_dump_scan_value(du, it.first, 0);
+} // end Rps_PayloadAttrIndex::dump_scan
+
+
+void
+Rps_PayloadAttrIndex::dump_json_content(Rps_Dumper*du, Json::Value&jv) const
+{
+  /// see function rpsldpy_attribute_index below
+  RPS_ASSERT(du != nullptr);
+  RPS_ASSERT(jv.type() == Json::objectValue);
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  if (!attrix_attr || !rps_is_dumpable_objref(du, attrix_attr))
+    return;
+  Json::Value jarr(Json::arrayValue);
+  for (Rps_Value keyv : attrix_sortedkeys)
+    {
+      if (!rps_is_dumpable_value(du, keyv))
+        continue;
+      auto hashit = attrix_hashmap.find(keyv);
+      RPS_ASSERT(hashit != attrix_hashmap.end());
+      Json::Value jowners(Json::arrayValue);
+      for (Rps_ObjectRef obown : hashit->second)
+        if (rps_is_scanned_objref(du, obown))
+          jowners.append(rps_dump_json_objectref(du, obown));
+      if (jowners.size() == 0)
+        continue;
+      Json::Value jent(Json::objectValue);
+      jent["val"] = rps_dump_json_value(du, keyv);
+      jent["owners"] = jowners;
+      jarr.append(jent);
+    }
+  jv["payload"] = "attribute_index";
+  jv["attrindex_attr"] = rps_dump_json_objectref(du, attrix_attr);
+  jv["attrindex_entries"] = jarr;
+} // end Rps_PayloadAttrIndex::dump_json_content
+
+
+//// loading of Rps_PayloadAttrIndex; see above Rps_PayloadAttrIndex::dump_json_content
+void
+rpsldpy_attribute_index(Rps_ObjectZone*obz, Rps_Loader*ld, const Json::Value& jv, Rps_Id spacid, unsigned lineno)
+{
+  RPS_ASSERT(obz != nullptr);
+  RPS_ASSERT(ld != nullptr);
+  RPS_ASSERT(obz->get_payload() == nullptr);
+  RPS_ASSERT(jv.type() == Json::objectValue);
+  if (!jv.isMember("attrindex_attr") || !jv.isMember("attrindex_entries"))
+    {
+      RPS_FATALOUT("rpsldpy_attribute_index: object " << obz->oid()
+                   << " in space " << spacid << " lineno#" << lineno
+                   << " has incomplete payload"
+                   << std::endl
+                   << " jv " << (jv));
+    }
+  Rps_ObjectRef obattr(jv["attrindex_attr"], ld);
+  if (!obattr)
+    RPS_FATALOUT("rpsldpy_attribute_index: object " << obz->oid()
+                 << " in space " << spacid << " lineno#" << lineno
+                 << " has bad attrindex_attr "
+                 << jv["attrindex_attr"]);
+  Json::Value jarr = jv["attrindex_entries"];
+  if (!jarr.isArray())
+    RPS_FATALOUT("rpsldpy_attribute_index: object " << obz->oid()
+                 << " in space " << spacid << " lineno#" << lineno
+                 << " has bad attrindex_entries "
+                 << std::endl
+                 << jarr);
+  auto paylix = obz->put_new_plain_payload<Rps_PayloadAttrIndex>();
+  /// the magic getters are not yet all known in the second loading
+  /// pass, so we don't use register_attribute here.
+  {
+    std::lock_guard<std::recursive_mutex> gureg(Rps_PayloadAttrIndex::attrix_regmtx);
+    paylix->attrix_attr = obattr;
+    if (Rps_PayloadAttrIndex::attrix_registry[obattr.optr()].insert(paylix).second)
+      Rps_PayloadAttrIndex::attrix_count.fetch_add(1);
+  }
+  unsigned nbent = jarr.size();
+  for (int entix=0; entix<(int)nbent; entix++)
+    {
+      Json::Value jcurent = jarr[entix];
+      if (!jcurent.isObject()
+          || !jcurent.isMember("val")
+          || !jcurent.isMember("owners"))
+        continue;
+      Rps_Value curval(jcurent["val"], ld);
+      if (!curval)
+        continue;
+      Json::Value jowners = jcurent["owners"];
+      if (!jowners.isArray())
+        continue;
+      unsigned nbown = jowners.size();
+      for (int ownix=0; ownix<(int)nbown; ownix++)
+        {
+          // a weak owner may be gone since the index was dumped
+          Rps_ObjectZone*obzown = Rps_ObjectZone::find(Rps_Id(jowners[ownix].asString()));
+          if (obzown)
+            paylix->reindex_owner(obzown, curval);
+        }
+    }
+} // end rpsldpy_attribute_index
+
+
+unsigned
+Rps_PayloadAttrIndex::nb_keys(void) const
+{
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  return attrix_hashmap.size();
+} // end Rps_PayloadAttrIndex::nb_keys
+
+
+unsigned
+Rps_PayloadAttrIndex::nb_owners(void) const
+{
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  return attrix_ownermap.size();
+} // end Rps_PayloadAttrIndex::nb_owners
+
+
+Rps_SetValue
+Rps_PayloadAttrIndex::find_equal(const Rps_Value val) const
+{
+  if (val.is_empty())
+    return Rps_SetValue(std::set<Rps_ObjectRef> {});
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  auto hashit = attrix_hashmap.find(val);
+  if (hashit == attrix_hashmap.end())
+    return Rps_SetValue(std::set<Rps_ObjectRef> {});
+  return Rps_SetValue(hashit->second);
+} // end Rps_PayloadAttrIndex::find_equal
+
+
+unsigned
+Rps_PayloadAttrIndex::count_equal(const Rps_Value val) const
+{
+  if (val.is_empty())
+    return 0;
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  auto hashit = attrix_hashmap.find(val);
+  if (hashit == attrix_hashmap.end())
+    return 0;
+  return hashit->second.size();
+} // end Rps_PayloadAttrIndex::count_equal
+
+
+void
+Rps_PayloadAttrIndex::iterate_range(const Rps_Value lo, const Rps_Value hi,
+                                    const std::function<bool(const Rps_Value,const std::set<Rps_ObjectRef>&)>& stopfun) const
+{
+  RPS_ASSERT(stopfun);
+  std::lock_guard<std::recursive_mutex> gu(attrix_mtx);
+  auto keyit = lo.is_empty()
+               ? attrix_sortedkeys.begin()
+               : attrix_sortedkeys.lower_bound(lo);
+  value_less lessfun;
+  for (; keyit != attrix_sortedkeys.end(); keyit++)
+    {
+      Rps_Value keyv = *keyit;
+      if (!hi.is_empty() && lessfun(hi, keyv))
+        break;
+      auto hashit = attrix_hashmap.find(keyv);
+      RPS_ASSERT(hashit != attrix_hashmap.end());
+      if (stopfun(keyv, hashit->second))
+        return;
+    }
+} // end Rps_PayloadAttrIndex::iterate_range
+
+
+Rps_SetValue
+Rps_PayloadAttrIndex::find_range(const Rps_Value lo, const Rps_Value hi) const
+{
+  std::set<Rps_ObjectRef> setown;
+  iterate_range(lo, hi,
+                [&](const Rps_Value, const std::set<Rps_ObjectRef>&owners)
+  {
+    setown.insert(owners.begin(), owners.end());
+    return false;
+  });
+  return Rps_SetValue(setown);
+} // end Rps_PayloadAttrIndex::find_range
+
+
+Rps_ObjectRef
+Rps_PayloadAttrIndex::the_attribute_index_class(void)
+{
+  return RPS_ROOT_OB(_3vG1NkL6esh4351Thb);
+} // end Rps_PayloadAttrIndex::the_attribute_index_class
+
+
+Rps_ObjectRef
+Rps_PayloadAttrIndex::make_attribute_index_object(Rps_CallFrame*callframe, Rps_ObjectRef obattrarg, Rps_ObjectRef obclassarg, Rps_ObjectRef obspacearg)
+{
+  RPS_ASSERT(!callframe || callframe->is_good_call_frame());
+  RPS_LOCALFRAME(the_attribute_index_class(),
+                 callframe,
+                 Rps_ObjectRef obattrix;
+                 Rps_ObjectRef obattr;
+                 Rps_ObjectRef obclass;
+                 Rps_ObjectRef obspace;
+                );
+  _f.obattr = obattrarg;
+  _f.obclass = obclassarg;
+  _f.obspace = obspacearg;
+  if (!_f.obattr)
+    throw std::runtime_error("missing attribute for make_attribute_index_object");
+  if (!_f.obclass)
+    _f.obclass = the_attribute_index_class();
+  if (_f.obclass != the_attribute_index_class()
+      && !Rps_Value(_f.obclass).is_subclass_of(&_,
+          the_attribute_index_class()))
+    throw std::runtime_error("invalid class for make_attribute_index_object");
+  _f.obattrix = Rps_ObjectRef::make_object(&_, _f.obclass, _f.obspace);
+  auto paylix = _f.obattrix->put_new_plain_payload<Rps_PayloadAttrIndex>();
+  RPS_ASSERT(paylix);
+  paylix->register_attribute(_f.obattr);
+  /// Once registered, every change of obattr is noticed, so we can
+  /// fill the index by scanning all the objects, each under its own
+  /// lock, after having copied them.
+  std::vector<Rps_ObjectZone*> vecobz;
+  {
+    std::lock_guard<std::recursive_mutex> guid(Rps_ObjectZone::ob_idmtx_);
+    vecobz.reserve(Rps_ObjectZone::ob_idmap_.size());
+    for (auto it : Rps_ObjectZone::ob_idmap_)
+      vecobz.push_back(it.second);
+  }
+  for (Rps_ObjectZone*obz : vecobz)
+    {
+      std::lock_guard<std::recursive_mutex> guob(obz->ob_mtx);
+      auto atit = obz->ob_attrs.find(_f.obattr);
+      if (atit != obz->ob_attrs.end())
+        paylix->reindex_owner(obz, atit->second);
+    }
+  RPS_DEBUG_LOG(LOWREP, "make_attribute_index_object " << _f.obattrix
+                << " for attribute " << _f.obattr
+                << " with " << paylix->nb_owners() << " objects and "
+                << paylix->nb_keys() << " keys");
+  return _f.obattrix;
+} // end of Rps_PayloadAttrIndex::make_attribute_index_object
+
+//// end of file attrindex_rps.cc
@@ -154,6 +154,8 @@ Rps_GarbageCollector::mark_gcroots(void)
     this->mark_root_objectref(obr);
   });
   rps_garbcoll_application(*this);
+  /// the objects noted in the write-ahead journal but not yet written
+  rps_journal_gc_mark(this);
   ///
   /// mark the hardcoded global roots
 #define RPS_INSTALL_ROOT_OB(Oid)    {			\
@@ -204,17 +206,30 @@ Rps_GarbageCollector::run_gc(void)
         gc.gc_nbscan++;
       };
   });
+  Rps_PayloadAttrIndex::forget_unmarked_indexes(*this);
+  /// the space counters are recomputed from the surviving objects
+  std::unordered_map<Rps_ObjectZone*,Rps_PayloadSpace::space_counters> spacecountmap;
   Rps_QuasiZone::every_zone
   (*this,
-   [] (Rps_GarbageCollector&gc, Rps_QuasiZone*qz)
+   [&spacecountmap] (Rps_GarbageCollector&gc, Rps_QuasiZone*qz)
   {
     gc.gc_nbmark++;
     if (qz->is_gcmarked(gc))
-      return;
+      {
+        if (qz->stored_type() == Rps_Type::Object)
+          {
+            Rps_ObjectZone*obz = static_cast<Rps_ObjectZone*>(qz);
+            Rps_ObjectZone*obzspace = obz->get_space().optr();
+            if (obzspace)
+              Rps_PayloadSpace::add_footprint(spacecountmap[obzspace], obz, 1);
+          }
+        return;
+      }
     RPS_ASSERT(Rps_QuasiZone::raw_nth_zone(qz->qz_rank,gc) == qz);
     delete qz;
     gc.gc_nbdelete++;
   });
+  Rps_PayloadSpace::replace_counters_after_gc(spacecountmap);
   gc_running.store(false);
 #warning Rps_GarbageCollector::run_gc could be incomplete or wrong
 } // end Rps_GarbageCollector::run_gc
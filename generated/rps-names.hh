@@ -21,6 +21,7 @@
 #endif /*undefined RPS_INSTALL_NAMED_ROOT_OB*/
 
 RPS_INSTALL_NAMED_ROOT_OB(_006mAbXTG4G00QR5HS,display)
+RPS_INSTALL_NAMED_ROOT_OB(_01J4W8C1qaL0NLbbX2,instances)
 RPS_INSTALL_NAMED_ROOT_OB(_0deGTf5hQwu01xJkyi,display_value_web)
 RPS_INSTALL_NAMED_ROOT_OB(_0jdbikGJFq100dgX1n,comment)
 RPS_INSTALL_NAMED_ROOT_OB(_0D6zqQNe4eC02bjfGs,email)
@@ -46,11 +47,12 @@ RPS_INSTALL_NAMED_ROOT_OB(_6fmq7pZkmNd03UyPuO,class)
 RPS_INSTALL_NAMED_ROOT_OB(_6JbWqOsjX5T03M1eGM,closure_for_method_selector)
 RPS_INSTALL_NAMED_ROOT_OB(_6QAanFi9yLx00spBST,last_name)
 RPS_INSTALL_NAMED_ROOT_OB(_7X9eGs8601M021nMue,object)
+RPS_INSTALL_NAMED_ROOT_OB(_8uJ1qjobOWp4hhJzIK,space_counters)
 RPS_INSTALL_NAMED_ROOT_OB(_8xCV6GDXYMa02mK5xy,display_object_content_web)
 RPS_INSTALL_NAMED_ROOT_OB(_9uwZtDshW4401x6MsY,space)
 
 #undef RPS_NB_NAMED_ROOT_OB
-#define RPS_NB_NAMED_ROOT_OB 28
+#define RPS_NB_NAMED_ROOT_OB 30
 
 #undef RPS_INSTALL_NAMED_ROOT_OB
 /// end of RefPerSys roots file generated/rps-names.hh
@@ -21,6 +21,7 @@
 #endif /*undefined RPS_INSTALL_ROOT_OB*/
 
 RPS_INSTALL_ROOT_OB(_006mAbXTG4G00QR5HS) //display∈symbol
+RPS_INSTALL_ROOT_OB(_01J4W8C1qaL0NLbbX2) //instances∈symbol
 RPS_INSTALL_ROOT_OB(_02iWbXmFx8f04ldLRt) //"display_object_content_web"∈named_selector
 RPS_INSTALL_ROOT_OB(_0cSUtWqTYdZ00mjeNR) //named_selector∈class
 RPS_INSTALL_ROOT_OB(_0deGTf5hQwu01xJkyi) //display_value_web∈symbol
@@ -56,6 +57,7 @@ RPS_INSTALL_ROOT_OB(_36I1BY2NetN03WjrOv) //symbol∈class
 RPS_INSTALL_ROOT_OB(_39OsVkAJDdV00ohD5r) //"repl_command"∈object
 RPS_INSTALL_ROOT_OB(_3rXxMck40kz03RxRLM) //code_chunk∈class
 RPS_INSTALL_ROOT_OB(_3s7ztCCoJsj04puTdQ) //agenda∈class
+RPS_INSTALL_ROOT_OB(_3vG1NkL6esh4351Thb) //attribute_index∈class
 RPS_INSTALL_ROOT_OB(_3FztYBKABxZ02DUPRm) //string_dictionary∈class
 RPS_INSTALL_ROOT_OB(_3GHJQW0IIqS01QY8qD) //json∈class
 RPS_INSTALL_ROOT_OB(_3HIxVgAGg5303g7AZs) //temporary_cplusplus_code∈class
@@ -93,6 +95,7 @@ RPS_INSTALL_ROOT_OB(_7X9eGs8601M021nMue) //object∈symbol
 RPS_INSTALL_ROOT_OB(_7Y3AyF9gNx700bQJXc) //string_buffer∈class
 RPS_INSTALL_ROOT_OB(_8coaw0RX8kD03J64aj) //"root_web_handler"∈web_handler
 RPS_INSTALL_ROOT_OB(_8fYqEw8vTED03wsznt) //tasklet∈class
+RPS_INSTALL_ROOT_OB(_8uJ1qjobOWp4hhJzIK) //space_counters∈symbol
 RPS_INSTALL_ROOT_OB(_8xCV6GDXYMa02mK5xy) //display_object_content_web∈symbol
 RPS_INSTALL_ROOT_OB(_8zNtuRpzXUP013WG9S) //web_exchange∈class
 RPS_INSTALL_ROOT_OB(_8CncrUdoSL303T5lOK) //repl_command∈class
@@ -105,7 +108,7 @@ RPS_INSTALL_ROOT_OB(_9BnrMLXUhfG00llx8X) //function∈class
 RPS_INSTALL_ROOT_OB(_9Gz1oNPCnkB00I6VRS) //core_function∈class
 
 #undef RPS_NB_ROOT_OB
-#define RPS_NB_ROOT_OB 83
+#define RPS_NB_ROOT_OB 86
 
 #undef RPS_INSTALL_ROOT_OB
 /// end of RefPerSys roots file generated/rps-roots.hh
@@ -87,6 +87,11 @@ public:
   {
     return "webex";
   };
+  /// nothing of a web exchange is dumped
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   Rps_PayloadWebex(Rps_ObjectZone*,uint64_t,Onion::Request*,Onion::Response*);
   virtual ~Rps_PayloadWebex();
   /// if ob is of class web_exchange, gives its payload. Otherwise
@@ -213,6 +218,10 @@ public:
   {
     return "web_handler";
   };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   static bool valid_path_element(const std::string&pathelem);
   Rps_PayloadWebHandler(Rps_ObjectZone*obz);
   virtual ~Rps_PayloadWebHandler();
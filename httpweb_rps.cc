@@ -532,6 +532,7 @@ Rps_PayloadWebHandler::put_path_element(const std::string&pathelem)
                 << " pathelem=" << Rps_Cjson_String(pathelem)
                 << " thread=" << thrname);
   webh_pathelem = pathelem;
+  touch_owner();
 } // end Rps_PayloadWebHandler::put_path_element
 
 void
@@ -543,7 +544,10 @@ Rps_PayloadWebHandler::put_get_handler(Rps_Value val)
   memset(thrname, 0, sizeof(thrname));
   pthread_getname_np(pthread_self(),thrname,sizeof(thrname));
   if (!val || val.is_closure())
-    webh_gethandler = Rps_ClosureValue(val);
+    {
+      webh_gethandler = Rps_ClosureValue(val);
+      touch_owner();
+    }
   else
     {
       RPS_WARNOUT("invalid get handler " << val << " for Rps_PayloadWebHandler owned by " << owner()
@@ -565,7 +569,10 @@ Rps_PayloadWebHandler::put_post_handler(Rps_Value val)
   memset(thrname, 0, sizeof(thrname));
   pthread_getname_np(pthread_self(),thrname,sizeof(thrname));
   if (!val || val.is_closure())
-    webh_posthandler = Rps_ClosureValue(val);
+    {
+      webh_posthandler = Rps_ClosureValue(val);
+      touch_owner();
+    }
   else
     {
       RPS_WARNOUT("invalid post handler " << val << " for Rps_PayloadWebHandler owned by " << owner()
@@ -605,6 +612,7 @@ Rps_PayloadWebHandler::add_dict_handler(const std::string& path, Rps_Value val)
       return;
     }
   webh_dicthandler.insert({path,val});
+  touch_owner();
   RPS_DEBUG_LOG(WEB, "Rps_PayloadWebHandler::add_dict_handler owner=" << owner()
                 << " path=" <<  Rps_Cjson_String(path)
                 << " val=" << val << " thread:" << thrname);
@@ -176,11 +176,62 @@ bool Rps_Value::is_ptr() const
          && (((intptr_t)_pval) & (sizeof(void*)-1)) == 0;
 }
 
+bool
+Rps_Value::is_immediate_double() const
+{
+  return (_ival & immediate_double_mask) == immediate_double_tag;
+} // end Rps_Value::is_immediate_double
+
+bool
+Rps_Value::double_fits_immediate(double d)
+{
+  uint64_t bits = 0;
+  static_assert(sizeof(bits) == sizeof(d));
+  memcpy(&bits, &d, sizeof(d));
+  return (bits & immediate_double_mask) == 0;
+} // end Rps_Value::double_fits_immediate
+
+bool
+Rps_Value::is_immediate_string() const
+{
+  return (_ival & immediate_string_mask) == immediate_string_tag;
+} // end Rps_Value::is_immediate_string
+
+bool
+Rps_Value::string_fits_immediate(const char*str, int len)
+{
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "immediate strings need a little endian word");
+  if (len > (int)immediate_string_maxlen)
+    return false;
+  if (len > 0 && memchr(str, 0, len))
+    return false;
+  return rps_utf8_check_count(str, len, nullptr) == nullptr;
+} // end Rps_Value::string_fits_immediate
+
+Rps_Value
+Rps_Value::make_string(const char*str, int len)
+{
+  if (str == nullptr || str == (const char*)RPS_EMPTYSLOT)
+    str = "";
+  int shortlen = (len < 0) ? (int)strnlen(str, immediate_string_maxlen+1) : len;
+  if (!string_fits_immediate(str, shortlen))
+    return Rps_Value(Rps_String::make(str, len), Rps_ValPtrTag{});
+  Rps_Value res;
+  res._ival = immediate_string_tag | (shortlen << 3);
+  memcpy(((char*)&res._ival)+1, str, shortlen);
+  return res;
+} // end Rps_Value::make_string
+
 Rps_Type
 Rps_Value::type() const
 {
   if (is_int())
     return Rps_Type::Int;
+  else if (is_immediate_double())
+    return Rps_Type::Double;
+  else if (is_immediate_string())
+    return Rps_Type::String;
   else if (is_empty())
     return Rps_Type::None;
   else
@@ -237,6 +288,10 @@ Rps_Value::output(std::ostream&out, unsigned depth) const
 {
   if (is_int())
     out << as_int();
+  else if (is_immediate_double())
+    out << as_double();
+  else if (is_immediate_string())
+    out << Json::Value(as_cstring());
   else if (is_empty())
     out << "___";
   else if (is_ptr())
@@ -279,6 +334,10 @@ Rps_Value::valhash() const noexcept
       RPS_ASSERT(h != 0);
       return h;
     }
+  else if (is_immediate_double())
+    return Rps_Double::double_hash(as_double());
+  else if (is_immediate_string())
+    return rps_hash_cstr(as_cstring(), (_ival >> 3) & 7);
   else if (is_ptr())
     {
       const Rps_ZoneValue*pval = as_ptr();
@@ -327,14 +386,16 @@ bool Rps_Value::is_lextoken() const
 
 bool Rps_Value::is_string() const
 {
-  return is_ptr()
-         && as_ptr()->stored_type() == Rps_Type::String;
+  return is_immediate_string()
+         || (is_ptr()
+             && as_ptr()->stored_type() == Rps_Type::String);
 } //end  Rps_Value::is_string()
 
 bool Rps_Value::is_double() const
 {
-  return is_ptr()
-         && as_ptr()->stored_type() == Rps_Type::Double;
+  return is_immediate_double()
+         || (is_ptr()
+             && as_ptr()->stored_type() == Rps_Type::Double);
 } //end  Rps_Value::is_double()
 
 bool Rps_Value::is_json() const
@@ -512,6 +573,8 @@ Rps_SetOb::element_index(const Rps_ObjectRef obelem) const
   RPS_ASSERT(obelem->stored_type() == Rps_Type::Object);
   unsigned card = cnt();
   RPS_ASSERT(card <= maxsize);
+  if (card >= sideindex_threshold)
+    return side_index_find(side_index(), obelem.optr());
   auto setdata = (raw_const_data());
   int lo = 0, hi = (int)card - 1;
   while (lo + 4 < hi)
@@ -527,7 +590,7 @@ Rps_SetOb::element_index(const Rps_ObjectRef obelem) const
       else
         hi = md;
     };
-  for (int md = lo; md < hi; md++)
+  for (int md = lo; md <= hi; md++)
     {
       auto curobr = setdata[md];
       if (RPS_UNLIKELY(curobr == obelem))
@@ -536,6 +599,23 @@ Rps_SetOb::element_index(const Rps_ObjectRef obelem) const
   return -1;
 } // end Rps_SetValue::element_index
 
+/// lower bound of ob in the sorted range, probing positions 1, 2, 4,
+/// 8... from beg then bisecting, so cheap when ob is near beg
+const Rps_ObjectRef*
+Rps_SetOb::gallop_lower_bound(const Rps_ObjectRef*beg, const Rps_ObjectRef*end,
+                              const Rps_ObjectRef ob)
+{
+  size_t step = 1;
+  const Rps_ObjectRef*lo = beg;
+  while (lo + step < end && lo[step] < ob)
+    {
+      lo += step;
+      step *= 2;
+    }
+  const Rps_ObjectRef*hi = (lo + step < end) ? (lo + step + 1) : end;
+  return std::lower_bound(lo, hi, ob);
+} // end Rps_SetOb::gallop_lower_bound
+
 Rps_SetValue::Rps_SetValue (void)
   : Rps_Value (&Rps_SetOb::the_empty_set(), Rps_ValPtrTag{})
 {
@@ -647,9 +727,13 @@ Rps_TupleValue::Rps_TupleValue(const Rps_Value val)
 {
 } // end Rps_TupleValue::Rps_TupleValue dynamic
 
+// an immediate string is never boxed here, since the new Rps_String
+// would not be rooted; use as_cppstring or as_cstring instead
 const Rps_String*
 Rps_Value::as_string() const
 {
+  if (is_immediate_string())
+    throw std::domain_error("Rps_Value::as_string: immediate string is not boxed");
   if (is_string())
     return reinterpret_cast<const Rps_String*>(_pval);
   else throw std::domain_error("Rps_Value::as_string: value is not genuine string");
@@ -658,6 +742,8 @@ Rps_Value::as_string() const
 const std::string
 Rps_Value::as_cppstring() const
 {
+  if (is_immediate_string())
+    return std::string(as_cstring());
   if (is_string())
     return to_string()->cppstring();
   else
@@ -665,8 +751,10 @@ Rps_Value::as_cppstring() const
 } // end Rps_Value::as_cppstring
 
 const char*
-Rps_Value::as_cstring() const
+Rps_Value::as_cstring() const &
 {
+  if (is_immediate_string())
+    return ((const char*)&_ival)+1;
   if (is_string())
     return to_string()->cstr();
   else
@@ -676,7 +764,7 @@ Rps_Value::as_cstring() const
 const Rps_String*
 Rps_Value::to_string(const Rps_String*defstr) const
 {
-  if (is_string())
+  if (is_string() && !is_immediate_string())
     return reinterpret_cast<const Rps_String*>(const_cast<Rps_ZoneValue*>(_pval));
   else return defstr;
 } // end Rps_Value::to_string
@@ -684,8 +772,8 @@ Rps_Value::to_string(const Rps_String*defstr) const
 const std::string
 Rps_Value::to_cppstring(std::string defstr) const
 {
-  auto strp = to_string();
-  if (strp) return strp->cppstring();
+  if (is_string())
+    return as_cppstring();
   else return defstr;
 } // end of Rps_Value::to_cppstring
 
@@ -729,7 +817,7 @@ Rps_Value::to_instance(const Rps_InstanceZone*definst) const
 const Rps_Double*
 Rps_Value::as_boxed_double() const
 {
-  if (is_double())
+  if (is_double() && !is_immediate_double())
     return reinterpret_cast<const Rps_Double*>(_pval);
   else throw std::domain_error("Rps_Value::as_boxed_double: value is not genuine double");
 } // end Rps_Value::as_boxed_double
@@ -738,6 +826,13 @@ Rps_Value::as_boxed_double() const
 double
 Rps_Value::as_double() const
 {
+  if (is_immediate_double())
+    {
+      uint64_t bits = (uint64_t)(_ival & ~immediate_double_mask);
+      double d = 0.0;
+      memcpy(&d, &bits, sizeof(d));
+      return d;
+    }
   if (is_double())
     return as_boxed_double()->dval();
   else throw std::domain_error("Rps_Value::as_double: value is not genuine double");
@@ -762,12 +857,37 @@ Rps_Value::to_json(const Json::Value defjv) const
 } // end Rps_Value::to_json
 
 
+unsigned
+rps_common_word_prefix(const void*l, const void*r, unsigned nbw)
+{
+  // compare by blocks of eight words, vectorized by the C library's
+  // memcmp, then word per word inside the first different block
+  constexpr unsigned blockw = 8;
+  const char*lc = static_cast<const char*>(l);
+  const char*rc = static_cast<const char*>(r);
+  if (RPS_UNLIKELY(lc == rc))
+    return nbw;
+  unsigned ix = 0;
+  while (ix + blockw <= nbw
+         && !memcmp(lc + ix*sizeof(void*), rc + ix*sizeof(void*), blockw*sizeof(void*)))
+    ix += blockw;
+  while (ix < nbw
+         && !memcmp(lc + ix*sizeof(void*), rc + ix*sizeof(void*), sizeof(void*)))
+    ix++;
+  return ix;
+} // end rps_common_word_prefix
+
 bool
 Rps_Value::operator == (const Rps_Value v) const
 {
   if  (v._wptr == _wptr) return true;
   if (is_empty() || is_null()) return v.is_empty() || v.is_null();
   if (is_int()) return false;
+  if (is_immediate_double() || v.is_immediate_double())
+    return is_double() && v.is_double() && as_double() == v.as_double();
+  if (is_immediate_string() || v.is_immediate_string())
+    return is_string() && v.is_string() && !strcmp(as_cstring(), v.as_cstring());
+  if (v.is_int() || v.is_empty()) return false;
   return (*as_ptr()) == (*v.as_ptr());
 }   // end Rps_Value::operator ==
 
@@ -788,6 +908,19 @@ Rps_Value::operator <= (const Rps_Value v) const
     return false;
   if (is_int())
     return (v.is_int() && (as_int() <= v.as_int() || v.is_ptr()));
+  if (is_immediate_double() || v.is_immediate_double())
+    {
+      if (is_double() && v.is_double())
+        return as_double() <= v.as_double();
+      // as zone values, compare types
+      return !v.is_int() && type() < v.type();
+    }
+  if (is_immediate_string() || v.is_immediate_string())
+    {
+      if (is_string() && v.is_string())
+        return strcmp(as_cstring(), v.as_cstring()) <= 0;
+      return !v.is_int() && type() < v.type();
+    }
   if (is_ptr() && v.is_ptr())
     return (*as_ptr()) <= (*v.as_ptr());
   return false;
@@ -804,8 +937,20 @@ Rps_Value::operator < (const Rps_Value v) const
     return false;
   if (is_int())
     return (v.is_int() && (as_int() < v.as_int() || v.is_ptr()));
+  if (is_immediate_double() || v.is_immediate_double())
+    {
+      if (is_double() && v.is_double())
+        return as_double() < v.as_double();
+      return !v.is_int() && type() < v.type();
+    }
+  if (is_immediate_string() || v.is_immediate_string())
+    {
+      if (is_string() && v.is_string())
+        return strcmp(as_cstring(), v.as_cstring()) < 0;
+      return !v.is_int() && type() < v.type();
+    }
   if (is_ptr() && v.is_ptr())
-    return (*as_ptr()) <= (*v.as_ptr());
+    return (*as_ptr()) < (*v.as_ptr());
   return false;
 }   // end Rps_Value::operator <
 
@@ -1047,10 +1192,10 @@ rps_hash_cstr(const char*cstr, int len)
 }     // end of rps_hash_cstr
 
 Rps_Value::Rps_Value(const std::string&str)
-  : Rps_Value(Rps_String::make(str.c_str(), str.size()), Rps_ValPtrTag{}) {};
+  : Rps_Value(make_string(str.c_str(), str.size())) {};
 
 Rps_Value::Rps_Value(const char*str, int len)
-  : Rps_Value(Rps_String::make(str, len), Rps_ValPtrTag{}) {};
+  : Rps_Value(make_string(str, len)) {};
 
 
 const char*
@@ -1078,9 +1223,10 @@ Rps_String::safe_utf8len(const char*cstr, int len)
       || !*cstr) return 0;
   if (len<0)
     len = strlen(cstr);
-  if (RPS_UNLIKELY(u8_check((const uint8_t*)cstr, (size_t)len) != nullptr))
+  uint32_t utf8cnt = 0;
+  if (RPS_UNLIKELY(rps_utf8_check_count(cstr, (size_t)len, &utf8cnt) != nullptr))
     RPS_FATAL("corrupted UTF8 string %.*s", len, cstr);
-  return u8_mblen((const uint8_t*)cstr, (size_t)len);
+  return utf8cnt;
 }; // end of Rps_String::safe_utf8len
 
 Rps_String::Rps_String (const char*cstr, int len)
@@ -1094,6 +1240,17 @@ Rps_String::Rps_String (const char*cstr, int len)
   _alignbuf[_bytsiz] = (char)0;
 }; // end of Rps_String::Rps_String
 
+Rps_String::Rps_String (const char*cstr, int len, uint32_t utf8len)
+  : Rps_LazyHashedZoneValue (Rps_Type::String),
+    _bytsiz(normalize_len(cstr,len)),
+    _utf8len(utf8len)
+{
+  cstr = normalize_cstr(cstr);
+  if (_bytsiz>0)
+    memcpy(_alignbuf, cstr, _bytsiz);
+  _alignbuf[_bytsiz] = (char)0;
+}; // end of Rps_String::Rps_String with utf8len
+
 const Rps_String*
 Rps_String::make(const std::string&s)
 {
@@ -1102,17 +1259,17 @@ Rps_String::make(const std::string&s)
 
 
 Rps_StringValue::Rps_StringValue (const char*cstr, int len)
-  : Rps_Value(Rps_String::make(cstr, len), Rps_ValPtrTag{})
+  : Rps_Value(make_string(cstr, len))
 {
 } // end Rps_StringValue::Rps_StringValue (const char*cstr, int len)
 
 Rps_StringValue::Rps_StringValue(const std::string str)
-  : Rps_Value(Rps_String::make(str), Rps_ValPtrTag{})
+  : Rps_Value(make_string(str.c_str(), str.size()))
 {
 } // end Rps_StringValue::Rps_StringValue
 
 Rps_StringValue::Rps_StringValue(const Rps_Value val)
-  : Rps_Value(val.is_string()?(val.to_string()):nullptr, Rps_ValPtrTag{})
+  : Rps_Value(val.is_string()?val:Rps_Value(nullptr))
 {
 } // end Rps_StringValue::Rps_StringValue(const Rps_Value val)
 
@@ -1127,17 +1284,26 @@ Rps_StringValue::Rps_StringValue(std::nullptr_t)
 } // end of Rps_StringValue::Rps_StringValue(nullptr_t)
 //////////////////////////////////////////////////////////// boxed doubles
 Rps_Value::Rps_Value (double d, Rps_DoubleTag)
-  : Rps_Value(Rps_Double::make(d), Rps_ValPtrTag())
+  : _wptr(nullptr)
 {
   if (RPS_UNLIKELY(std::isnan(d)))
     throw std::invalid_argument("NaN cannot be an Rps_Value");
+  if (RPS_LIKELY(double_fits_immediate(d)))
+    {
+      uint64_t bits = 0;
+      memcpy(&bits, &d, sizeof(d));
+      _ival = (intptr_t)bits | immediate_double_tag;
+    }
+  else
+    _pval = Rps_Double::make(d);
 };      // end Rps_Value::Rps_Value (double d, Rps_DoubleTag)
 
 Rps_Value::Rps_Value (double d) : Rps_Value::Rps_Value (d, Rps_DoubleTag{}) {};
 
 const Rps_Double* Rps_Value::to_boxed_double(const Rps_Double*defdbl) const
 {
-  if (is_double()) return reinterpret_cast<const Rps_Double*>(_pval);
+  if (is_double() && !is_immediate_double())
+    return reinterpret_cast<const Rps_Double*>(_pval);
   else return defdbl;
 }
 
@@ -1157,12 +1323,12 @@ Rps_Double::make(double d)
 } // end  Rps_Double::make
 
 Rps_DoubleValue::Rps_DoubleValue (double d)
-  : Rps_Value(Rps_Double::make(d), Rps_ValPtrTag{})
+  : Rps_Value(d, Rps_DoubleTag{})
 {
 } // end Rps_DoubleValue::Rps_DoubleValue (double d=0.0)
 
 Rps_DoubleValue::Rps_DoubleValue(const Rps_Value val)
-  : Rps_Value(val.is_double()?val.to_boxed_double():nullptr,  Rps_ValPtrTag{})
+  : Rps_Value(val.is_double()?val:Rps_Value(nullptr))
 {
 } // end Rps_DoubleValue::Rps_DoubleValue
 
@@ -1186,12 +1352,6 @@ Rps_Value::to_boxed_json(const Rps_JsonZone*defjs) const
   else return defjs;
 } // end Rps_Value::to_boxed_json
 
-//////////////////////////////////////////////////////////////// json
-
-Rps_JsonZone::Rps_JsonZone(const Json::Value& jv)
-  : Rps_LazyHashedZoneValue(Rps_Type::Json), _jsonval(jv)
-{
-} // end of Rps_JsonZone::Rps_JsonZone
 
 
 
@@ -1250,6 +1410,7 @@ Rps_ObjectZone::clear_payload(void)
           oldpayl->clear_owner();
         }
       delete oldpayl;
+      touch_now();
     }
 } // end Rps_ObjectZone::clear_payload
 
@@ -1375,6 +1536,19 @@ Rps_ObjectZone::get_mtime(void) const
   return ob_mtime.load();
 } // end Rps_ObjectZone::get_mtime
 
+/// every mutation of an object should touch it, and note it in the
+/// write-ahead journal when it is active; a dying object, whose mtime
+/// is negative, is left alone
+void
+Rps_ObjectZone::touch_now(void)
+{
+  if (RPS_UNLIKELY(ob_mtime.load() < 0.0))
+    return;
+  ob_mtime.store(rps_wallclock_real_time());
+  if (RPS_UNLIKELY(rps_journal_active.load()))
+    rps_journal_note_mutation(this);
+} // end Rps_ObjectZone::touch_now
+
 //////////////////////////////////////////////////////////// objects references
 Rps_HashInt
 Rps_ObjectRef::obhash(void) const
@@ -1511,14 +1685,55 @@ template<typename RpsTree, Rps_Type treety, unsigned k1, unsigned k2, unsigned k
 std::pair<Rps_ObjectZone*,int32_t> const
 Rps_TreeZone<RpsTree,treety,k1,k2,k3,k4>::get_metadata(void) const
 {
-  Rps_HashInt h = val_hash ();
-  std::lock_guard<std::mutex> gu(lazy_mtxarr[h % lazy_nbmutexes]);
-  Rps_ObjectZone*mobz = metaobject();
-  int32_t mr = metarank();
-  return std::pair<Rps_ObjectZone*,int32_t> {mobz,mr};
+  // a sequence lock: readers never write, so they never contend, and
+  // retry in the rare case a change happened meanwhile
+  for (;;)
+    {
+      uint32_t version = _treemetaversion.load(std::memory_order_acquire);
+      if (RPS_UNLIKELY(version & 1))
+        {
+          std::this_thread::yield();
+          continue;
+        }
+      Rps_ObjectZone*mobz = _treemetaob.load(std::memory_order_relaxed);
+      int32_t mr = _treemetarank.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (RPS_LIKELY(_treemetaversion.load(std::memory_order_relaxed) == version))
+        return std::pair<Rps_ObjectZone*,int32_t> {mobz,mr};
+    }
 } // end Rps_TreeZone::get_metadata
 
 
+template<typename RpsTree, Rps_Type treety, unsigned k1, unsigned k2, unsigned k3, unsigned k4>
+uint32_t
+Rps_TreeZone<RpsTree,treety,k1,k2,k3,k4>::begin_metadata_change(void)
+{
+  uint32_t version = _treemetaversion.load(std::memory_order_relaxed);
+  for (;;)
+    {
+      if (RPS_UNLIKELY(version & 1))
+        {
+          std::this_thread::yield();
+          version = _treemetaversion.load(std::memory_order_relaxed);
+        }
+      else if (_treemetaversion.compare_exchange_weak(version, version+1,
+               std::memory_order_relaxed))
+        break;
+    }
+  std::atomic_thread_fence(std::memory_order_release);
+  return version;
+} // end Rps_TreeZone::begin_metadata_change
+
+
+template<typename RpsTree, Rps_Type treety, unsigned k1, unsigned k2, unsigned k3, unsigned k4>
+void
+Rps_TreeZone<RpsTree,treety,k1,k2,k3,k4>::end_metadata_change(uint32_t version)
+{
+  RPS_ASSERT((version & 1) == 0);
+  _treemetaversion.store(version+2, std::memory_order_release);
+} // end Rps_TreeZone::end_metadata_change
+
+
 template<typename RpsTree, Rps_Type treety, unsigned k1, unsigned k2, unsigned k3, unsigned k4>
 const Rps_Value
 Rps_TreeZone<RpsTree,treety,k1,k2,k3,k4>::at(int rk, bool dontfail) const
@@ -1536,13 +1751,13 @@ template<typename RpsTree, Rps_Type treety, unsigned k1, unsigned k2, unsigned k
 void
 Rps_TreeZone<RpsTree,treety,k1,k2,k3,k4>::put_metadata(Rps_ObjectRef obr, int32_t num, bool transient)
 {
-  Rps_HashInt h = val_hash ();
-  std::lock_guard<std::mutex> gu(lazy_mtxarr[h % lazy_nbmutexes]);
   Rps_ObjectZone* obz = nullptr;
   if (!obr.is_empty()) obz = *obr;
-  _treemetaob.store(obz);
-  _treemetarank.store(num);
-  _treemetatransient.store(transient);
+  uint32_t version = begin_metadata_change();
+  _treemetaob.store(obz, std::memory_order_relaxed);
+  _treemetarank.store(num, std::memory_order_relaxed);
+  _treemetatransient.store(transient, std::memory_order_relaxed);
+  end_metadata_change(version);
 } // end Rps_TreeZone::put_metadata
 
 
@@ -1550,16 +1765,91 @@ template<typename RpsTree, Rps_Type treety, unsigned k1, unsigned k2, unsigned k
 std::pair<Rps_ObjectZone*,int32_t>
 Rps_TreeZone<RpsTree,treety,k1,k2,k3,k4>::swap_metadata(Rps_ObjectRef obr, int32_t num, bool transient)
 {
-  Rps_HashInt h = val_hash ();
-  std::lock_guard<std::mutex> gu(lazy_mtxarr[h % lazy_nbmutexes]);
   Rps_ObjectZone* obz = nullptr;
   if (!obr.is_empty()) obz = *obr;
-  Rps_ObjectZone* oldobz=_treemetaob.exchange(obz);
-  int32_t oldnum = _treemetarank.exchange(num);
-  _treemetatransient.store(transient);
+  uint32_t version = begin_metadata_change();
+  Rps_ObjectZone* oldobz=_treemetaob.exchange(obz, std::memory_order_relaxed);
+  int32_t oldnum = _treemetarank.exchange(num, std::memory_order_relaxed);
+  _treemetatransient.store(transient, std::memory_order_relaxed);
+  end_metadata_change(version);
   return   std::pair<Rps_ObjectZone*,int32_t> {oldobz, oldnum};
 } // end Rps_TreeZone::swap_metadata
 
+//////////////// tree builders
+template<typename RpsTree, typename RpsTreeTag>
+Rps_TreeBuilder<RpsTree,RpsTreeTag>::Rps_TreeBuilder(Rps_ObjectRef connob, unsigned capacity)
+  : treb_connob(connob), treb_tree(nullptr), treb_count(0),
+    treb_gccount(Rps_GarbageCollector::count()), treb_hasher(connob)
+{
+  if (connob && capacity > 0)
+    reallocate(capacity);
+} // end Rps_TreeBuilder::Rps_TreeBuilder
+
+
+template<typename RpsTree, typename RpsTreeTag>
+void
+Rps_TreeBuilder<RpsTree,RpsTreeTag>::grow(unsigned mincapacity)
+{
+  unsigned oldcap = capacity();
+  unsigned newcap = (oldcap > 0) ? 2*oldcap : default_capacity;
+  if (newcap < mincapacity)
+    newcap = mincapacity;
+  reallocate(newcap);
+} // end Rps_TreeBuilder::grow
+
+
+template<typename RpsTree, typename RpsTreeTag>
+void
+Rps_TreeBuilder<RpsTree,RpsTreeTag>::reallocate(unsigned newcap)
+{
+  RPS_ASSERT(newcap >= treb_count);
+  check_gc_marked();
+  if (RPS_UNLIKELY(newcap > RpsTree::maxsize))
+    throw std::length_error("Rps_TreeBuilder with too many sons");
+  RpsTree* newtree =
+    Rps_QuasiZone::rps_allocate_with_wordgap<RpsTree,unsigned,Rps_ObjectRef,RpsTreeTag>
+    ((newcap*sizeof(Rps_Value)/sizeof(void*)),
+     newcap, treb_connob, RpsTreeTag{});
+  // the old zone, never given, becomes garbage
+  if (treb_count > 0)
+    memcpy((void*)newtree->_treesons, (const void*)treb_tree->_treesons,
+           treb_count*sizeof(Rps_Value));
+  treb_tree = newtree;
+} // end Rps_TreeBuilder::reallocate
+
+
+template<typename RpsTree, typename RpsTreeTag>
+void
+Rps_TreeBuilder<RpsTree,RpsTreeTag>::gc_mark(Rps_GarbageCollector&gc) const
+{
+  gc.mark_obj(treb_connob);
+  treb_gccount = Rps_GarbageCollector::count();
+  if (!treb_tree)
+    return;
+  Rps_Value treev(treb_tree, Rps_Value::Rps_ValPtrTag{});
+  gc.mark_value(treev);
+} // end Rps_TreeBuilder::gc_mark
+
+
+template<typename RpsTree, typename RpsTreeTag>
+RpsTree*
+Rps_TreeBuilder<RpsTree,RpsTreeTag>::seal(void)
+{
+  if (!treb_connob)
+    return nullptr;
+  if (!treb_tree)
+    reallocate(0);
+  check_gc_marked();
+  RpsTree*tree = treb_tree;
+  RPS_ASSERT(treb_count <= tree->_treelen);
+  tree->_treelen = treb_count;
+  tree->put_precomputed_hash(treb_hasher.result());
+  treb_tree = nullptr;
+  treb_count = 0;
+  treb_hasher = typename RpsTree::hasher(treb_connob);
+  return tree;
+} // end Rps_TreeBuilder::seal
+
 //////////////// closures
 
 Rps_ClosureValue::Rps_ClosureValue (const Rps_ObjectRef connob, const std::initializer_list<Rps_Value>& valil)
@@ -1926,6 +2216,13 @@ Rps_Payload::Rps_Payload(Rps_Type ptyp, Rps_ObjectRef obr)
   RPS_ASSERT(obr && obr->stored_type() == Rps_Type::Object);
 } // end Rps_Payload::Rps_Payload
 
+void
+Rps_Payload::touch_owner(void)
+{
+  if (payl_owner)
+    payl_owner->touch_now();
+} // end Rps_Payload::touch_owner
+
 ////// class information payload - for PaylClassInfo
 Rps_PayloadClassInfo::Rps_PayloadClassInfo(Rps_ObjectZone*owner)
   : Rps_Payload(Rps_Type::PaylClassInfo, owner),
@@ -71,15 +71,16 @@ Rps_Value
 Rps_TokenSource::name_val(Rps_CallFrame*callframe, Rps_Value*namerefptr)
 {
   RPS_ASSERT(callframe==nullptr || callframe->is_good_call_frame());
-  if (namerefptr && *namerefptr && (*namerefptr).is_string()
-      && (*namerefptr).to_cppstring() == toksrc_name)
+  const Rps_String*oldstr = namerefptr ? namerefptr->to_string() : nullptr;
+  if (oldstr && toksrc_name == oldstr->cstr())
     return *namerefptr;
   RPS_LOCALFRAME(/*descr:*/nullptr,
                            callframe,
                            Rps_Value strval;
                 );
   RPS_ASSERT(namerefptr);
-  _f.strval = Rps_StringValue(toksrc_name);
+  // boxed once here, since every token keeps it as a Rps_String
+  _f.strval = Rps_StringValue(Rps_String::make(toksrc_name));
   *namerefptr = _f.strval;
   return _f.strval;
 } // end Rps_TokenSource::name_val
@@ -81,4 +81,54 @@ rpsget_9uwZtDshW4401x6MsY(const Rps_Value valarg, const Rps_ObjectRef obattrarg,
   return nullptr;
 } // end of rpsget_9uwZtDshW4401x6MsY - magic getter `space`
 
+/// the `instances` magic attribute _01J4W8C1qaL0NLbbX2, giving for a
+/// class the set of its direct instances, from the class extents
+extern "C" rps_magicgetterfun_t rpsget_01J4W8C1qaL0NLbbX2;
+
+Rps_Value
+rpsget_01J4W8C1qaL0NLbbX2(Rps_CallFrame*callerframe, const Rps_Value valarg, const Rps_ObjectRef obattrarg)
+{
+  RPS_LOCALFRAME(RPS_ROOT_OB(_01J4W8C1qaL0NLbbX2),
+                 callerframe,
+                 Rps_Value val; // the value
+                 Rps_ObjectRef obattr; // the attribute
+                 Rps_Value setv; // the resulting set
+                );
+  _f.obattr = obattrarg;
+  _f.val = valarg;
+  RPS_ASSERT (_f.obattr == RPS_ROOT_OB(_01J4W8C1qaL0NLbbX2));
+  if (_f.val.is_empty() || !_f.val.is_object())
+    return nullptr;
+  if (!_f.val.as_object()->is_class())
+    return nullptr;
+  _f.setv = Rps_ObjectZone::class_extent_set(Rps_ObjectRef(_f.val.as_object()));
+  return _f.setv;
+} // end of rpsget_01J4W8C1qaL0NLbbX2 - magic getter `instances`
+
+
+/// the `space_counters` magic attribute _8uJ1qjobOWp4hhJzIK, giving
+/// for a space object a JSON object with its live counters, see
+/// Rps_PayloadSpace::json_space_counters
+extern "C" rps_magicgetterfun_t rpsget_8uJ1qjobOWp4hhJzIK;
+
+Rps_Value
+rpsget_8uJ1qjobOWp4hhJzIK(Rps_CallFrame*callerframe, const Rps_Value valarg, const Rps_ObjectRef obattrarg)
+{
+  RPS_LOCALFRAME(RPS_ROOT_OB(_8uJ1qjobOWp4hhJzIK),
+                 callerframe,
+                 Rps_Value val; // the value
+                 Rps_ObjectRef obattr; // the attribute
+                 Rps_Value jsonv; // the resulting JSON
+                );
+  _f.obattr = obattrarg;
+  _f.val = valarg;
+  RPS_ASSERT (_f.obattr == RPS_ROOT_OB(_8uJ1qjobOWp4hhJzIK));
+  if (_f.val.is_empty() || !_f.val.is_object())
+    return nullptr;
+  if (!_f.val.as_object()->get_dynamic_payload<Rps_PayloadSpace>())
+    return nullptr;
+  _f.jsonv = Rps_JsonValue(Rps_PayloadSpace::json_space_counters(_f.val.as_object()));
+  return _f.jsonv;
+} // end of rpsget_8uJ1qjobOWp4hhJzIK - magic getter `space_counters`
+
 // end of file magicattrs_rps.cc
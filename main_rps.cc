@@ -242,6 +242,58 @@ struct argp_option rps_progoptions[] =
     " (this option might become obsolete)", //
     /*group:*/0 ///
   },
+  /* ======= UTF-8 checker testing ======= */
+  {/*name:*/ "test-utf8", ///
+    /*key:*/ RPSPROGOPT_TEST_UTF8, ///
+    /*arg:*/ nullptr, ///
+    /*flags:*/ 0, ///
+    /*doc:*/ "Compare the UTF-8 checker with libunistring, then exit without loading.", //
+    /*group:*/0 ///
+  },
+  /* ======= JSON tape testing ======= */
+  {/*name:*/ "test-json-tape", ///
+    /*key:*/ RPSPROGOPT_TEST_JSON_TAPE, ///
+    /*arg:*/ nullptr, ///
+    /*flags:*/ 0, ///
+    /*doc:*/ "Check that dumped doubles are loaded back, then exit without loading.", //
+    /*group:*/0 ///
+  },
+  /* ======= class extents ======= */
+  {/*name:*/ "class-extents", ///
+    /*key:*/ RPSPROGOPT_CLASS_EXTENTS, ///
+    /*arg:*/ nullptr, ///
+    /*flags:*/ 0, ///
+    /*doc:*/ "Maintain from start the extent of every class, that is the set of its direct instances.\n"
+    " (otherwise they are computed at first query)", //
+    /*group:*/0 ///
+  },
+  /* ======= binary snapshot ======= */
+  {/*name:*/ "binary-snapshot", ///
+    /*key:*/ RPSPROGOPT_BINARY_SNAPSHOT, ///
+    /*arg:*/ nullptr, ///
+    /*flags:*/ 0, ///
+    /*doc:*/ "When dumping, write also a binary snapshot of the heap, used by later loads\n"
+    " while the JSON space files are unchanged.", //
+    /*group:*/0 ///
+  },
+  /* ======= incremental dump ======= */
+  {/*name:*/ "incremental-dump", ///
+    /*key:*/ RPSPROGOPT_INCREMENTAL_DUMP, ///
+    /*arg:*/ nullptr, ///
+    /*flags:*/ 0, ///
+    /*doc:*/ "When dumping into the directory loaded from or last dumped into, keep\n"
+    " the space files whose objects are all unchanged since.", //
+    /*group:*/0 ///
+  },
+  /* ======= write-ahead journal ======= */
+  {/*name:*/ "journal", ///
+    /*key:*/ RPSPROGOPT_JOURNAL, ///
+    /*arg:*/ nullptr, ///
+    /*flags:*/ 0, ///
+    /*doc:*/ "Append every object mutated after loading to the " RPS_JOURNAL_FILE " journal\n"
+    " of the load directory, replayed by the next load till the next dump.", //
+    /*group:*/0 ///
+  },
   /* ======= number of jobs or threads ======= */
   {/*name:*/ "jobs", ///
     /*key:*/ RPSPROGOPT_JOBS, ///
@@ -277,7 +329,12 @@ bool rps_disable_aslr = false;
 bool rps_without_terminal_escape = false;
 bool rps_without_quick_tests = false;
 bool rps_run_repl = false;
+bool rps_dump_snapshot = false;
+bool rps_dump_incremental = false;
+bool rps_journal_enabled = false;
 bool rps_test_repl_lexer = false;
+bool rps_test_utf8 = false;
+bool rps_test_json_tape = false;
 bool rps_syslog_enabled = false;
 bool rps_stdout_istty = false;
 bool rps_stderr_istty = false;
@@ -702,12 +759,18 @@ main (int argc, char** argv)
              (void*)main,
              (rps_batch?"batch":"interactive"),
              rps_nbjobs);
+  if (rps_test_utf8)
+    exit(rps_utf8_check_count_test()==0 ? EXIT_SUCCESS : EXIT_FAILURE);
+  if (rps_test_json_tape)
+    exit(rps_json_tape_real_test()==0 ? EXIT_SUCCESS : EXIT_FAILURE);
   ////
   Rps_QuasiZone::initialize();
   rps_check_mtime_files();
   if (rps_my_load_dir.empty())
     rps_my_load_dir = std::string(rps_topdirectory);
   rps_load_from(rps_my_load_dir);
+  if (rps_journal_enabled)
+    rps_journal_start(rps_my_load_dir);
   rps_run_application(argc, argv);
   ////
   if (!rps_dumpdir_str.empty())
@@ -722,6 +785,7 @@ main (int argc, char** argv)
                  rps_dumpdir_str.c_str(), cwdbuf);
       rps_dump_into(rps_dumpdir_str);
     }
+  rps_journal_stop();
   asm volatile (".globl rps_end_of_main; .type rps_end_of_main, @function");
   asm volatile ("rps_end_of_main: nop; nop; nop; nop; nop; nop");
   asm volatile (".size rps_end_of_main, . - rps_end_of_main");
@@ -886,6 +950,37 @@ rps_parse1opt (int key, char *arg, struct argp_state *state)
         RPS_DEBUG_LOG(REPL, "will run with a textual Read-Eval-Print-Loop lexer GNU readline");
     }
     return 0;
+    case RPSPROGOPT_TEST_UTF8:
+    {
+      rps_test_utf8 = true;
+    }
+    return 0;
+    case RPSPROGOPT_TEST_JSON_TAPE:
+    {
+      rps_test_json_tape = true;
+    }
+    return 0;
+    case RPSPROGOPT_CLASS_EXTENTS:
+    {
+      if (side_effect)
+        Rps_ObjectZone::enable_class_extents();
+    }
+    return 0;
+    case RPSPROGOPT_BINARY_SNAPSHOT:
+    {
+      rps_dump_snapshot = true;
+    }
+    return 0;
+    case RPSPROGOPT_INCREMENTAL_DUMP:
+    {
+      rps_dump_incremental = true;
+    }
+    return 0;
+    case RPSPROGOPT_JOURNAL:
+    {
+      rps_journal_enabled = true;
+    }
+    return 0;
     case RPSPROGOPT_DEBUG_AFTER_LOAD:
     {
       if (side_effect)
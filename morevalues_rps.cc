@@ -45,17 +45,23 @@ Rps_InstanceZone::make_from_components(Rps_ObjectRef classob, const std::initial
 {
   if (!classob)
     return nullptr;
-  auto nbsons = valil.size();
-  Rps_InstanceZone* inst
-    = Rps_QuasiZone::rps_allocate_with_wordgap<Rps_InstanceZone,unsigned,Rps_ObjectRef,Rps_InstanceTag>((nbsons*sizeof(Rps_Value)/sizeof(void*)),
-        (unsigned)nbsons, classob,  Rps_InstanceTag{});
-  int ix=0;
-  Rps_Value*sonarr = inst->raw_data_sons();
+  Rps_InstanceBuilder instb(classob, valil.size());
   for (auto val: valil)
-    sonarr[ix++] = val;
-  return inst;
+    instb.push_back(val);
+  return instb.seal();
 } // end Rps_InstanceZone::make_from_components
 
+Rps_InstanceZone*
+Rps_InstanceZone::make_from_components(Rps_ObjectRef classob, const std::vector<Rps_Value>& valvec)
+{
+  if (!classob)
+    return nullptr;
+  Rps_InstanceBuilder instb(classob, valvec.size());
+  for (auto val: valvec)
+    instb.push_back(val);
+  return instb.seal();
+} // end Rps_InstanceZone::make_from_components of vector
+
 
 const Rps_SetOb*
 Rps_InstanceZone::class_attrset(Rps_ObjectRef obclass)
@@ -187,6 +193,11 @@ Rps_InstanceZone::make_from_attributes_components(Rps_ObjectRef classob,
       Rps_Value curcomp = valvec[cix];
       sonarr[2*nbattrs+cix] = curcomp;
     }
+  // the attributes were put in their class order, so hash afterwards
+  hasher hs(classob);
+  for (unsigned ix=0; ix<physiz; ix++)
+    hs.add(sonarr[ix]);
+  res->put_precomputed_hash(hs.result());
   return res;
 } // end Rps_InstanceZone::make_from_attributes_components
 
@@ -195,102 +206,482 @@ Rps_InstanceZone::make_from_attributes_components(Rps_ObjectRef classob,
 
 ////////////////////////////////////////////////////// json
 
-static void
-rps_recursive_hash_json(const Json::Value&jv, std::uint64_t& h1,std::uint64_t& h2, unsigned depth)
+// a bijective 64 bits finalizer, so that summing the hashes of
+// object members stays a good hash
+static inline std::uint64_t
+rps_json_mix_hash(std::uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+} // end rps_json_mix_hash
+
+
+/// The tape is built in two passes over the jsoncpp value: the first
+/// counts the tape words and interns the strings in the pool, the
+/// second fills the allocated zone.
+struct Rps_JsonZone::tape_builder
+{
+  std::unordered_map<std::string_view,uint32_t> tb_strmap;
+  std::vector<std::string_view> tb_strvec;
+  size_t tb_tapelen = 0;
+  size_t tb_poolsize = 0;
+  uint64_t*tb_tape = nullptr;
+  size_t tb_pos = 0;
+  uint32_t intern(const char*str, const char*end)
+  {
+    std::string_view sv(str, end-str);
+    auto it = tb_strmap.find(sv);
+    if (it != tb_strmap.end())
+      return it->second;
+    if (RPS_UNLIKELY(tb_poolsize + sv.size() >= UINT32_MAX))
+      throw std::length_error("too big JSON for Rps_JsonZone");
+    uint32_t off = (uint32_t)tb_poolsize;
+    tb_strmap.insert({sv, off});
+    tb_strvec.push_back(sv);
+    tb_poolsize += sv.size();
+    return off;
+  };
+  void count(const Json::Value&jv)
+  {
+    switch (jv.type())
+      {
+      case Json::nullValue:
+      case Json::booleanValue:
+        tb_tapelen++;
+        return;
+      case Json::intValue:
+      case Json::uintValue:
+      case Json::realValue:
+        tb_tapelen += 2;
+        return;
+      case Json::stringValue:
+      {
+        const char*str = nullptr;
+        const char*end = nullptr;
+        jv.getString(&str, &end);
+        intern(str, end);
+        tb_tapelen += 2;
+      }
+      return;
+      case Json::arrayValue:
+        tb_tapelen += 2;
+        for (const Json::Value&jcomp: jv)
+          count(jcomp);
+        return;
+      case Json::objectValue:
+        tb_tapelen += 2 + 2*jv.size();
+        for (auto it = jv.begin(); it != jv.end(); it++)
+          {
+            const char*kend = nullptr;
+            const char*kstr = it.memberName(&kend);
+            intern(kstr, kend);
+            count(*it);
+          }
+        return;
+      }
+    RPS_FATALOUT("corrupted JSON type#" << jv.type());
+  };
+  void put_header(jsonkind_en kd, uint64_t payl)
+  {
+    tb_tape[tb_pos++] = (payl << 8) | (uint64_t)kd;
+  };
+  void emit(const Json::Value&jv)
+  {
+    switch (jv.type())
+      {
+      case Json::nullValue:
+        put_header(jsk_null, 0);
+        return;
+      case Json::booleanValue:
+        put_header(jsk_bool, jv.asBool()?1:0);
+        return;
+      case Json::intValue:
+        put_header(jsk_int, 0);
+        tb_tape[tb_pos++] = (uint64_t)jv.asInt64();
+        return;
+      case Json::uintValue:
+        put_header(jsk_uint, 0);
+        tb_tape[tb_pos++] = (uint64_t)jv.asUInt64();
+        return;
+      case Json::realValue:
+      {
+        double d = jv.asDouble();
+        put_header(jsk_real, 0);
+        memcpy(&tb_tape[tb_pos++], &d, sizeof(d));
+      }
+      return;
+      case Json::stringValue:
+      {
+        const char*str = nullptr;
+        const char*end = nullptr;
+        jv.getString(&str, &end);
+        put_header(jsk_string, end-str);
+        tb_tape[tb_pos++] = intern(str, end);
+      }
+      return;
+      case Json::arrayValue:
+      {
+        put_header(jsk_array, jv.size());
+        size_t endpos = tb_pos++;
+        for (const Json::Value&jcomp: jv)
+          emit(jcomp);
+        tb_tape[endpos] = tb_pos;
+      }
+      return;
+      case Json::objectValue:
+      {
+        put_header(jsk_object, jv.size());
+        size_t endpos = tb_pos++;
+        size_t mempos = tb_pos;
+        tb_pos += 2*jv.size();
+        // jsoncpp iterates on members by increasing keys
+        for (auto it = jv.begin(); it != jv.end(); it++)
+          {
+            const char*kend = nullptr;
+            const char*kstr = it.memberName(&kend);
+            uint64_t koff = intern(kstr, kend);
+            tb_tape[mempos++] = (koff << 32) | (uint64_t)(kend-kstr);
+            tb_tape[mempos++] = tb_pos;
+            emit(*it);
+          }
+        tb_tape[endpos] = tb_pos;
+      }
+      return;
+      }
+    RPS_FATALOUT("corrupted JSON type#" << jv.type());
+  };
+};				// end struct Rps_JsonZone::tape_builder
+
+
+Rps_JsonZone::Rps_JsonZone(uint32_t tapelen, uint32_t poolsize, Rps_JsonTag)
+  : Rps_LazyHashedZoneValue(Rps_Type::Json),
+    _jstapelen(tapelen), _jspoolsize(poolsize), _jscache(nullptr)
+{
+  memset((void*)_jstape, 0,
+         tapelen*sizeof(uint64_t) + poolsize);
+} // end Rps_JsonZone::Rps_JsonZone
+
+Rps_JsonZone::~Rps_JsonZone()
+{
+  delete _jscache.load();
+} // end Rps_JsonZone::~Rps_JsonZone
+
+
+const Json::Value&
+Rps_JsonZone::json(void) const
+{
+  Json::Value*jcache = _jscache.load(std::memory_order_acquire);
+  if (RPS_LIKELY(jcache != nullptr))
+    return *jcache;
+  Json::Value*newjv = new Json::Value(json_node(0));
+  // several threads might rebuild it concurrently, the first one wins
+  if (_jscache.compare_exchange_strong(jcache, newjv,
+                                       std::memory_order_acq_rel))
+    return *newjv;
+  delete newjv;
+  return *jcache;
+} // end Rps_JsonZone::json
+
+
+Rps_JsonZone*
+Rps_JsonZone::make(const Json::Value& jv)
+{
+  tape_builder tb;
+  tb.count(jv);
+  if (RPS_UNLIKELY(tb.tb_tapelen >= UINT32_MAX))
+    throw std::length_error("too big JSON for Rps_JsonZone");
+  unsigned wordgap = (unsigned)(tb.tb_tapelen
+                                + (tb.tb_poolsize+sizeof(uint64_t)-1)/sizeof(uint64_t));
+  Rps_JsonZone*jz =
+    Rps_QuasiZone::rps_allocate_with_wordgap<Rps_JsonZone,uint32_t,uint32_t,Rps_JsonTag>
+    (wordgap, (uint32_t)tb.tb_tapelen, (uint32_t)tb.tb_poolsize, Rps_JsonTag{});
+  char*pooldata = const_cast<char*>(jz->pool());
+  for (std::string_view sv: tb.tb_strvec)
+    {
+      memcpy(pooldata, sv.data(), sv.size());
+      pooldata += sv.size();
+    }
+  tb.tb_tape = jz->_jstape;
+  tb.emit(jv);
+  RPS_ASSERT(tb.tb_pos == tb.tb_tapelen);
+  return jz;
+} // end Rps_JsonZone::make
+
+
+uint32_t
+Rps_JsonZone::node_end(uint32_t node) const
+{
+  switch (kind(node))
+    {
+    case jsk_null:
+    case jsk_bool:
+      return node+1;
+    case jsk_array:
+    case jsk_object:
+      return (uint32_t)_jstape[node+1];
+    default:
+      return node+2;
+    }
+} // end Rps_JsonZone::node_end
+
+
+uint32_t
+Rps_JsonZone::size(uint32_t node) const
+{
+  if (kind(node) == jsk_array || kind(node) == jsk_object)
+    return (uint32_t) payload(node);
+  return 0;
+} // end Rps_JsonZone::size
+
+
+int64_t
+Rps_JsonZone::int_at(uint32_t node) const
+{
+  if (kind(node) == jsk_int || kind(node) == jsk_uint)
+    return (int64_t)_jstape[node+1];
+  throw std::domain_error("Rps_JsonZone::int_at: not an integer node");
+} // end Rps_JsonZone::int_at
+
+
+double
+Rps_JsonZone::real_at(uint32_t node) const
+{
+  if (kind(node) == jsk_real)
+    {
+      double d = 0.0;
+      memcpy(&d, &_jstape[node+1], sizeof(d));
+      return d;
+    }
+  else if (kind(node) == jsk_int)
+    return (double)(int64_t)_jstape[node+1];
+  else if (kind(node) == jsk_uint)
+    return (double)_jstape[node+1];
+  throw std::domain_error("Rps_JsonZone::real_at: not a numerical node");
+} // end Rps_JsonZone::real_at
+
+
+bool
+Rps_JsonZone::bool_at(uint32_t node) const
+{
+  if (kind(node) == jsk_bool)
+    return payload(node) != 0;
+  throw std::domain_error("Rps_JsonZone::bool_at: not a boolean node");
+} // end Rps_JsonZone::bool_at
+
+
+std::string_view
+Rps_JsonZone::string_at(uint32_t node) const
+{
+  if (kind(node) == jsk_string)
+    return std::string_view(pool() + _jstape[node+1], payload(node));
+  throw std::domain_error("Rps_JsonZone::string_at: not a string node");
+} // end Rps_JsonZone::string_at
+
+
+int
+Rps_JsonZone::element_node(uint32_t rank, uint32_t node) const
+{
+  if (kind(node) != jsk_array || rank >= size(node))
+    return -1;
+  uint32_t cur = node+2;
+  for (uint32_t ix=0; ix<rank; ix++)
+    cur = node_end(cur);
+  return (int)cur;
+} // end Rps_JsonZone::element_node
+
+
+// compare keys like jsoncpp does for its member maps
+static inline int
+rps_json_key_compare(std::string_view l, std::string_view r)
+{
+  size_t minlen = std::min(l.size(), r.size());
+  int c = minlen?memcmp(l.data(), r.data(), minlen):0;
+  if (c)
+    return c;
+  return (l.size() < r.size())?-1:((l.size() > r.size())?1:0);
+} // end rps_json_key_compare
+
+
+int
+Rps_JsonZone::member_node(std::string_view key, uint32_t node) const
+{
+  if (kind(node) != jsk_object)
+    return -1;
+  int lo = 0, hi = (int)size(node) - 1;
+  const uint64_t*members = _jstape + node + 2;
+  while (lo <= hi)
+    {
+      int md = (lo + hi) / 2;
+      uint64_t kw = members[2*md];
+      std::string_view curkey(pool() + (kw >> 32), kw & 0xffffffff);
+      int c = rps_json_key_compare(curkey, key);
+      if (c == 0)
+        return (int)members[2*md+1];
+      else if (c < 0)
+        lo = md+1;
+      else
+        hi = md-1;
+    }
+  return -1;
+} // end Rps_JsonZone::member_node
+
+
+Json::Value
+Rps_JsonZone::json_node(uint32_t node) const
+{
+  switch (kind(node))
+    {
+    case jsk_null:
+      return Json::Value(Json::nullValue);
+    case jsk_bool:
+      return Json::Value(bool_at(node));
+    case jsk_int:
+      return Json::Value((Json::Int64)int_at(node));
+    case jsk_uint:
+      return Json::Value((Json::UInt64)_jstape[node+1]);
+    case jsk_real:
+      return Json::Value(real_at(node));
+    case jsk_string:
+    {
+      std::string_view sv = string_at(node);
+      return Json::Value(sv.data(), sv.data()+sv.size());
+    }
+    case jsk_array:
+    {
+      Json::Value jarr(Json::arrayValue);
+      uint32_t nb = size(node);
+      jarr.resize(nb);
+      uint32_t cur = node+2;
+      for (uint32_t ix=0; ix<nb; ix++)
+        {
+          jarr[ix] = json_node(cur);
+          cur = node_end(cur);
+        }
+      return jarr;
+    }
+    case jsk_object:
+    {
+      Json::Value jobj(Json::objectValue);
+      uint32_t nb = size(node);
+      const uint64_t*members = _jstape + node + 2;
+      for (uint32_t ix=0; ix<nb; ix++)
+        {
+          uint64_t kw = members[2*ix];
+          const char*kstr = pool() + (kw >> 32);
+          jobj[std::string(kstr, kw & 0xffffffff)] = json_node((uint32_t)members[2*ix+1]);
+        }
+      return jobj;
+    }
+    }
+  RPS_FATALOUT("corrupted JSON tape node#" << node << " kind#" << (int)kind(node));
+} // end Rps_JsonZone::json_node
+
+
+void
+Rps_JsonZone::hash_node(uint32_t node, std::uint64_t& h1,std::uint64_t& h2, unsigned depth) const
 {
   static constexpr unsigned maxrecurdepth=32;
   if (depth>maxrecurdepth) return;
-  switch (jv.type())
+  switch (kind(node))
     {
-    case Json::nullValue:
+    case jsk_null:
       h1++;
       h2 -= depth;
       return;
-    case Json::intValue:
+    case jsk_int:
     {
-      auto i = jv.asInt64();
+      auto i = int_at(node);
       h1 += ((31*depth) ^ (i % 200579));
       h2 ^= (i >> 48) - (i % 300593);
     }
     return;
-    case Json::uintValue:
+    case jsk_uint:
     {
-      auto u = jv.asUInt64();
+      uint64_t u = _jstape[node+1];
       h1 += ((17*depth) ^ (u % 200569));
       h2 ^= (u >> 42) + (u % 300557);
     }
     return;
-    case Json::realValue:
+    case jsk_real:
     {
-      double d = jv.asDouble();
-      auto hd = std::hash<double> {}(d);
+      auto hd = std::hash<double> {}(real_at(node));
       h1 ^= 11 * (hd % 400597);
       h2 += hd;
     }
     return;
-    case Json::stringValue:
+    case jsk_string:
     {
-      const char* cs = jv.asCString();
+      std::string_view sv = string_at(node);
       int64_t hs[2] = {0,0};
-      int ln = rps_compute_cstr_two_64bits_hash(hs,cs);
+      int ln = rps_compute_cstr_two_64bits_hash(hs, sv.data(), (int)sv.size());
       h1 ^= hs[0] + (31*ln);
       h2 -= hs[1] + (17*ln);
     }
     return;
-    case Json::booleanValue:
+    case jsk_bool:
     {
-      if (jv.asBool())
+      if (bool_at(node))
         h1 += 23 + (h2 & 0xffff);
       else
         h2 += 13159 + (h1 & 0xffff);
     }
     return;
-    case Json::arrayValue:
+    case jsk_array:
     {
-      auto sz = jv.size();
-      for (int ix=0; ix<(int)sz; ix++)
+      uint32_t nb = size(node);
+      uint32_t cur = node+2;
+      for (int ix=0; ix<(int)nb; ix++)
         {
           if (ix % 2)
-            rps_recursive_hash_json(jv[ix], h1, h2, depth+1);
+            hash_node(cur, h1, h2, depth+1);
           else
-            rps_recursive_hash_json(jv[ix], h2, h1, depth+1);
+            hash_node(cur, h2, h1, depth+1);
           h2 += ix;
           if (ix % 2 == 0)
             h1 ^= 13*ix;
           else
             h1 ^= ((h2+31*ix)&0xffff);
+          cur = node_end(cur);
         }
     }
     return;
-    case Json::objectValue:
+    case jsk_object:
     {
-      auto mem = jv.getMemberNames();
-      std::sort(mem.begin(), mem.end());
-      int n = 0;
-      for (const std::string& key: mem)
+      // Each member is hashed on its own, from a fresh state, then
+      // mixed; the members are combined by addition, which does not
+      // depend on their order.
+      std::uint64_t o1 = 0, o2 = 0;
+      uint32_t nb = size(node);
+      const uint64_t*members = _jstape + node + 2;
+      for (uint32_t ix=0; ix<nb; ix++)
         {
-          auto jmem=jv[key];
+          uint64_t kw = members[2*ix];
           int64_t hsk[2] = {0,0};
-          int lnk = rps_compute_cstr_two_64bits_hash(hsk,key.c_str(),key.size());
-          h1 ^= 11*hsk[0] + (317*lnk);
-          h2 -= 7*hsk[1] + (331*lnk);
-          if (n % 2)
-            rps_recursive_hash_json(jmem, h1, h2, depth+1);
-          else
-            rps_recursive_hash_json(jmem, h2, h1, depth+1);
+          int lnk = rps_compute_cstr_two_64bits_hash(hsk, pool() + (kw >> 32),
+                    (int)(kw & 0xffffffff));
+          std::uint64_t m1 = 11*(std::uint64_t)hsk[0] + (317*lnk);
+          std::uint64_t m2 = 7*(std::uint64_t)hsk[1] + (331*lnk);
+          hash_node((uint32_t)members[2*ix+1], m1, m2, depth+1);
+          o1 += rps_json_mix_hash(m1 ^ (m2 >> 29));
+          o2 += rps_json_mix_hash(m2 + (m1 << 7) + 0x9e3779b97f4a7c15ULL);
         }
+      h1 ^= o1 + 31*nb;
+      h2 -= o2 + 17*depth;
     }
     return;
-    default:
-      RPS_FATALOUT("corrupted JSON type#" << jv.type() << " at depth " << depth);
     }
-} // end of rps_recursive_hash_json
+  RPS_FATALOUT("corrupted JSON tape node#" << node << " kind#" << (int)kind(node));
+} // end of Rps_JsonZone::hash_node
 
 Rps_HashInt
 Rps_JsonZone::compute_hash(void) const
 {
   std::uint64_t h1=0, h2=0;
-  rps_recursive_hash_json(_jsonval, h1, h2, 0);
+  hash_node(0, h1, h2, 0);
   Rps_HashInt h = (h1 * 13151) ^ (h2 * 13291);
   if (RPS_UNLIKELY(h==0))
     h= (h1&0xffff) + (h2&0xfffff) + 17;
@@ -311,17 +702,11 @@ Rps_JsonZone::dump_json(Rps_Dumper*du) const
   RPS_ASSERT(du != nullptr);
   Json::Value jv(Json::objectValue);
   jv["vtype"] = "json";
-  jv["json"] = _jsonval;
+  jv["json"] = json();
   return jv;
 } // end Rps_JsonZone::dump_json
 
 
-Rps_JsonZone*
-Rps_JsonZone::make(const Json::Value& jv)
-{
-  return Rps_QuasiZone::rps_allocate<Rps_JsonZone,const Json::Value&>(jv);
-} // end Rps_JsonZone::make
-
 Rps_JsonZone*
 Rps_JsonZone::load_from_json(Rps_Loader*ld, const Json::Value& jv)
 {
@@ -331,11 +716,130 @@ Rps_JsonZone::load_from_json(Rps_Loader*ld, const Json::Value& jv)
   return make(jv["json"]);
 } // end Rps_JsonZone::load_from_json
 
+
+// output a JSON string literal; UTF-8 bytes are kept as they are
+static void
+rps_output_json_string(std::ostream&outs, const char*str, size_t len)
+{
+  outs << '"';
+  for (size_t ix=0; ix<len; ix++)
+    {
+      unsigned char c = (unsigned char)str[ix];
+      switch (c)
+        {
+        case '"':
+          outs << "\\\"";
+          break;
+        case '\\':
+          outs << "\\\\";
+          break;
+        case '\n':
+          outs << "\\n";
+          break;
+        case '\r':
+          outs << "\\r";
+          break;
+        case '\t':
+          outs << "\\t";
+          break;
+        default:
+          if (c < ' ')
+            {
+              char ubuf[8];
+              memset(ubuf, 0, sizeof(ubuf));
+              snprintf(ubuf, sizeof(ubuf), "\\u%04x", (unsigned)c);
+              outs << ubuf;
+            }
+          else
+            outs << (char)c;
+        }
+    }
+  outs << '"';
+} // end rps_output_json_string
+
+
+void
+Rps_JsonZone::output_node(std::ostream& outs, uint32_t node) const
+{
+  switch (kind(node))
+    {
+    case jsk_null:
+      outs << "null";
+      return;
+    case jsk_bool:
+      outs << (bool_at(node)?"true":"false");
+      return;
+    case jsk_int:
+      outs << int_at(node);
+      return;
+    case jsk_uint:
+      outs << _jstape[node+1];
+      return;
+    case jsk_real:
+    {
+      // like jsoncpp, with a ".0" suffix on integral reals
+      double d = real_at(node);
+      if (RPS_UNLIKELY(!std::isfinite(d)))
+        {
+          outs << (std::isnan(d) ? "null" : (d < 0) ? "-1e+9999" : "1e+9999");
+          return;
+        }
+      char buf[40];
+      memset(buf, 0, sizeof(buf));
+      snprintf(buf, sizeof(buf), "%.17g", d);
+      if (!strpbrk(buf, ".eE"))
+        strcat(buf, ".0");
+      outs << buf;
+    }
+    return;
+    case jsk_string:
+    {
+      std::string_view sv = string_at(node);
+      rps_output_json_string(outs, sv.data(), sv.size());
+    }
+    return;
+    case jsk_array:
+    {
+      uint32_t nb = size(node);
+      uint32_t cur = node+2;
+      outs << '[';
+      for (uint32_t ix=0; ix<nb; ix++)
+        {
+          if (ix>0)
+            outs << ',';
+          output_node(outs, cur);
+          cur = node_end(cur);
+        }
+      outs << ']';
+    }
+    return;
+    case jsk_object:
+    {
+      uint32_t nb = size(node);
+      const uint64_t*members = _jstape + node + 2;
+      outs << '{';
+      for (uint32_t ix=0; ix<nb; ix++)
+        {
+          if (ix>0)
+            outs << ',';
+          uint64_t kw = members[2*ix];
+          rps_output_json_string(outs, pool() + (kw >> 32), kw & 0xffffffff);
+          outs << ':';
+          output_node(outs, (uint32_t)members[2*ix+1]);
+        }
+      outs << '}';
+    }
+    return;
+    }
+  RPS_FATALOUT("corrupted JSON tape node#" << node << " kind#" << (int)kind(node));
+} // end Rps_JsonZone::output_node
+
+
 void
 Rps_JsonZone::val_output(std::ostream& outs, unsigned depth) const
 {
   std::ostringstream tempouts;
-  tempouts << _jsonval << std::endl;
+  tempouts << json() << std::endl;
   if (depth==0)
     outs << tempouts.str();
   else
@@ -352,6 +856,139 @@ Rps_JsonZone::val_output(std::ostream& outs, unsigned depth) const
     }
 } // end Rps_JsonZone::val_output
 
+
+// same semantics as Json::Value::operator==
+bool
+Rps_JsonZone::equal_nodes(const Rps_JsonZone*lz, uint32_t lnode, const Rps_JsonZone*rz, uint32_t rnode)
+{
+  jsonkind_en lk = lz->kind(lnode);
+  if (lk != rz->kind(rnode))
+    return false;
+  switch (lk)
+    {
+    case jsk_null:
+      return true;
+    case jsk_bool:
+      return lz->bool_at(lnode) == rz->bool_at(rnode);
+    case jsk_int:
+    case jsk_uint:
+      return lz->_jstape[lnode+1] == rz->_jstape[rnode+1];
+    case jsk_real:
+      return lz->real_at(lnode) == rz->real_at(rnode);
+    case jsk_string:
+      return lz->string_at(lnode) == rz->string_at(rnode);
+    case jsk_array:
+    {
+      uint32_t nb = lz->size(lnode);
+      if (nb != rz->size(rnode))
+        return false;
+      uint32_t lcur = lnode+2, rcur = rnode+2;
+      for (uint32_t ix=0; ix<nb; ix++)
+        {
+          if (!equal_nodes(lz, lcur, rz, rcur))
+            return false;
+          lcur = lz->node_end(lcur);
+          rcur = rz->node_end(rcur);
+        }
+      return true;
+    }
+    case jsk_object:
+    {
+      uint32_t nb = lz->size(lnode);
+      if (nb != rz->size(rnode))
+        return false;
+      const uint64_t*lmem = lz->_jstape + lnode + 2;
+      const uint64_t*rmem = rz->_jstape + rnode + 2;
+      for (uint32_t ix=0; ix<nb; ix++)
+        {
+          uint64_t lkw = lmem[2*ix], rkw = rmem[2*ix];
+          if ((lkw & 0xffffffff) != (rkw & 0xffffffff)
+              || memcmp(lz->pool() + (lkw >> 32), rz->pool() + (rkw >> 32),
+                        lkw & 0xffffffff))
+            return false;
+          if (!equal_nodes(lz, (uint32_t)lmem[2*ix+1], rz, (uint32_t)rmem[2*ix+1]))
+            return false;
+        }
+      return true;
+    }
+    }
+  return false;
+} // end Rps_JsonZone::equal_nodes
+
+
+// negative, zero or positive, with the ordering of Json::Value::operator<
+int
+Rps_JsonZone::compare_nodes(const Rps_JsonZone*lz, uint32_t lnode, const Rps_JsonZone*rz, uint32_t rnode)
+{
+  jsonkind_en lk = lz->kind(lnode);
+  jsonkind_en rk = rz->kind(rnode);
+  if (lk != rk)
+    return (lk < rk)?-1:1;
+  switch (lk)
+    {
+    case jsk_null:
+      return 0;
+    case jsk_bool:
+      return (int)lz->bool_at(lnode) - (int)rz->bool_at(rnode);
+    case jsk_int:
+    {
+      int64_t li = lz->int_at(lnode), ri = rz->int_at(rnode);
+      return (li < ri)?-1:((li > ri)?1:0);
+    }
+    case jsk_uint:
+    {
+      uint64_t lu = lz->_jstape[lnode+1], ru = rz->_jstape[rnode+1];
+      return (lu < ru)?-1:((lu > ru)?1:0);
+    }
+    case jsk_real:
+    {
+      double ld = lz->real_at(lnode), rd = rz->real_at(rnode);
+      return (ld < rd)?-1:((ld > rd)?1:0);
+    }
+    case jsk_string:
+      return rps_json_key_compare(lz->string_at(lnode), rz->string_at(rnode));
+    case jsk_array:
+    case jsk_object:
+    {
+      // jsoncpp compares sizes first, then elements or (key, value)
+      // members lexicographically
+      uint32_t lnb = lz->size(lnode), rnb = rz->size(rnode);
+      if (lnb != rnb)
+        return (lnb < rnb)?-1:1;
+      if (lk == jsk_array)
+        {
+          uint32_t lcur = lnode+2, rcur = rnode+2;
+          for (uint32_t ix=0; ix<lnb; ix++)
+            {
+              int c = compare_nodes(lz, lcur, rz, rcur);
+              if (c)
+                return c;
+              lcur = lz->node_end(lcur);
+              rcur = rz->node_end(rcur);
+            }
+          return 0;
+        }
+      const uint64_t*lmem = lz->_jstape + lnode + 2;
+      const uint64_t*rmem = rz->_jstape + rnode + 2;
+      for (uint32_t ix=0; ix<lnb; ix++)
+        {
+          uint64_t lkw = lmem[2*ix], rkw = rmem[2*ix];
+          int c = rps_json_key_compare
+                  (std::string_view(lz->pool() + (lkw >> 32), lkw & 0xffffffff),
+                   std::string_view(rz->pool() + (rkw >> 32), rkw & 0xffffffff));
+          if (c)
+            return c;
+          c = compare_nodes(lz, (uint32_t)lmem[2*ix+1], rz, (uint32_t)rmem[2*ix+1]);
+          if (c)
+            return c;
+        }
+      return 0;
+    }
+    }
+  return 0;
+} // end Rps_JsonZone::compare_nodes
+
+
 bool
 Rps_JsonZone::equal(const Rps_ZoneValue&zv) const
 {
@@ -361,7 +998,12 @@ Rps_JsonZone::equal(const Rps_ZoneValue&zv) const
       auto lh = lazy_hash();
       auto othlh = othj->lazy_hash();
       if (lh != 0 && othlh != 0 && lh != othlh) return false;
-      return _jsonval == othj->_jsonval;
+      // equal values nearly always have identical tapes and pools
+      if (_jstapelen == othj->_jstapelen && _jspoolsize == othj->_jspoolsize
+          && !memcmp(_jstape, othj->_jstape,
+                     _jstapelen*sizeof(uint64_t) + _jspoolsize))
+        return true;
+      return equal_nodes(this, 0, othj, 0);
     }
   else return false;
 } // end Rps_JsonZone::equal
@@ -373,7 +1015,7 @@ Rps_JsonZone::less(const Rps_ZoneValue&zv) const
   if (zv.stored_type() == Rps_Type::Json)
     {
       auto othj = reinterpret_cast<const Rps_JsonZone*>(&zv);
-      return _jsonval < othj->_jsonval;
+      return compare_nodes(this, 0, othj, 0) < 0;
     }
   else
     return  Rps_Type::Json < zv.stored_type();
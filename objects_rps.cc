@@ -45,6 +45,10 @@ std::unordered_map<Rps_Id,Rps_ObjectZone*,Rps_Id::Hasher> Rps_ObjectZone::ob_idm
 std::map<Rps_Id,Rps_ObjectZone*> Rps_ObjectZone::ob_idbucketmap_[Rps_Id::maxbuckets];
 std::recursive_mutex Rps_ObjectZone::ob_idmtx_;
 
+std::atomic<bool> Rps_ObjectZone::ob_classextent_enabled_;
+std::unordered_map<Rps_ObjectZone*,std::unordered_set<Rps_ObjectZone*>> Rps_ObjectZone::ob_classextent_map_;
+std::recursive_mutex Rps_ObjectZone::ob_classextent_mtx_;
+
 
 
 // build an object from its existing string oid, or else fail with C++ exception
@@ -225,7 +229,7 @@ Rps_ObjectZone::Rps_ObjectZone(Rps_Id oid, registermode_en regmod)
   // Every object should have a class, initially `object`; the
   // ob_class can later be replaced, but we need something which is
   // not null.... That atomic field could be later overwritten.
-  ob_class.store(RPS_ROOT_OB(_5yhJGgxLwLp00X0xEQ)); //object∈class
+  store_class(RPS_ROOT_OB(_5yhJGgxLwLp00X0xEQ)); //object∈class
 } // end Rps_ObjectZone::Rps_ObjectZone
 
 
@@ -233,11 +237,33 @@ Rps_ObjectZone::~Rps_ObjectZone()
 {
   //  RPS_INFORMOUT("destroying object " << oid());
   Rps_Id curid = oid();
-  clear_payload();
+  // a negative mtime marks a dying object, never touched nor journaled
+  ob_mtime.store(-1.0);
+  if (ob_space.load())
+    Rps_PayloadSpace::account_object(this, ob_space.exchange(nullptr), nullptr);
+  // not clear_payload, which touches the object and checks erasability
+  {
+    Rps_Payload*oldpayl = ob_payload.exchange(nullptr);
+    if (oldpayl)
+      {
+        if (oldpayl->owner() == this)
+          oldpayl->clear_owner();
+        delete oldpayl;
+      }
+  }
+  if (RPS_UNLIKELY(Rps_PayloadAttrIndex::has_attribute_indexes()))
+    {
+      for (auto it : ob_attrs)
+        Rps_PayloadAttrIndex::note_attribute_change(this, it.first.optr(), nullptr);
+    }
   ob_attrs.clear();
   ob_comps.clear();
-  ob_class.store(nullptr);
-  ob_mtime.store(0.0);
+  store_class(nullptr);
+  if (RPS_UNLIKELY(ob_classextent_enabled_.load()))
+    {
+      std::lock_guard<std::recursive_mutex> guext(ob_classextent_mtx_);
+      ob_classextent_map_.erase(this);
+    }
   std::lock_guard<std::recursive_mutex> gu(ob_idmtx_);
   RPS_DEBUG_LOG(LOWREP,"~Rps_ObjectZone curid=" << curid << " this=" << this);
   ob_idmap_.erase(curid);
@@ -264,6 +290,7 @@ Rps_ObjectZone::put_applying_function(rps_applyingfun_t*afun)
                   << std::endl
                   << RPS_FULL_BACKTRACE_HERE(1, "put_applying_function"));
     };
+  touch_now();
 } // end Rps_ObjectZone::put_applying_function
 
 Rps_ObjectZone*
@@ -282,7 +309,7 @@ Rps_ObjectZone::make(void)
   // Every object should have a class, initially `object`; the
   // ob_class can later be replaced, but we need something which is
   // not null.... That atomic field could be later overwritten.
-  obz->ob_class.store(RPS_ROOT_OB(_5yhJGgxLwLp00X0xEQ)); //object∈class
+  obz->store_class(RPS_ROOT_OB(_5yhJGgxLwLp00X0xEQ)); //object∈class
   RPS_DEBUG_LOG(LOWREP, "Rps_ObjectZone::make oid=" << oid << " obz=" << obz
                 << std::endl
                 << RPS_FULL_BACKTRACE_HERE(1, "Rps_ObjectZone::make"));
@@ -301,7 +328,7 @@ Rps_ObjectZone::make_loaded(Rps_Id oid, Rps_Loader* ld)
   // Every object should have a class, initially `object`; the
   // ob_class can later be replaced, but we need something which is
   // not null.... The loader could later overwrite that.
-  obz->ob_class.store(RPS_ROOT_OB(_5yhJGgxLwLp00X0xEQ)); //object∈class
+  obz->store_class(RPS_ROOT_OB(_5yhJGgxLwLp00X0xEQ)); //object∈class
   return obz;
 } // end Rps_ObjectZone::make_loaded
 
@@ -351,6 +378,123 @@ Rps_ObjectZone::mark_gc_inside(Rps_GarbageCollector&gc)
     payl->gc_mark(gc);
 } // end Rps_ObjectZone::mark_gc_inside
 
+void
+Rps_ObjectZone::store_class(Rps_ObjectZone*obzclass)
+{
+  if (RPS_LIKELY(!ob_classextent_enabled_.load()))
+    {
+      Rps_ObjectZone*oldclass = ob_class.exchange(obzclass);
+      // the class extents could have been enabled meanwhile by
+      // another thread, so check again:
+      if (RPS_LIKELY(!ob_classextent_enabled_.load()))
+        return;
+      std::lock_guard<std::recursive_mutex> guext(ob_classextent_mtx_);
+      move_in_class_extent(oldclass, ob_class.load());
+      return;
+    }
+  std::lock_guard<std::recursive_mutex> guext(ob_classextent_mtx_);
+  Rps_ObjectZone*oldclass = ob_class.exchange(obzclass);
+  move_in_class_extent(oldclass, obzclass);
+} // end Rps_ObjectZone::store_class
+
+/// should be called with ob_classextent_mtx_ locked
+void
+Rps_ObjectZone::move_in_class_extent(Rps_ObjectZone*oldclass, Rps_ObjectZone*newclass)
+{
+  if (oldclass && oldclass != newclass)
+    {
+      auto oldit = ob_classextent_map_.find(oldclass);
+      if (oldit != ob_classextent_map_.end())
+        {
+          oldit->second.erase(this);
+          if (oldit->second.empty())
+            ob_classextent_map_.erase(oldit);
+        }
+    };
+  if (newclass)
+    ob_classextent_map_[newclass].insert(this);
+} // end Rps_ObjectZone::move_in_class_extent
+
+void
+Rps_ObjectZone::enable_class_extents(void)
+{
+  std::lock_guard<std::recursive_mutex> guext(ob_classextent_mtx_);
+  if (ob_classextent_enabled_.load())
+    return;
+  // setting the flag first ensures that concurrent store_class-es
+  // are not lost while we scan every object
+  ob_classextent_enabled_.store(true);
+  std::lock_guard<std::recursive_mutex> gu(ob_idmtx_);
+  for (auto it: ob_idmap_)
+    {
+      Rps_ObjectZone*obz = it.second;
+      if (!obz)
+        continue;
+      Rps_ObjectZone*obcla = obz->ob_class.load();
+      if (obcla)
+        ob_classextent_map_[obcla].insert(obz);
+    };
+  RPS_DEBUG_LOG(LOWREP, "Rps_ObjectZone::enable_class_extents with "
+                << ob_classextent_map_.size() << " classes for "
+                << ob_idmap_.size() << " objects");
+} // end Rps_ObjectZone::enable_class_extents
+
+unsigned
+Rps_ObjectZone::class_extent_count(Rps_ObjectRef obclass)
+{
+  if (!obclass)
+    return 0;
+  if (RPS_UNLIKELY(!ob_classextent_enabled_.load()))
+    enable_class_extents();
+  std::lock_guard<std::recursive_mutex> guext(ob_classextent_mtx_);
+  auto it = ob_classextent_map_.find(obclass.optr());
+  if (it == ob_classextent_map_.end())
+    return 0;
+  return (unsigned) it->second.size();
+} // end Rps_ObjectZone::class_extent_count
+
+unsigned
+Rps_ObjectZone::iterate_class_extent(Rps_ObjectRef obclass, const std::function<bool(Rps_ObjectZone*)>&stopfun)
+{
+  if (!obclass)
+    return 0;
+  if (RPS_UNLIKELY(!ob_classextent_enabled_.load()))
+    enable_class_extents();
+  // copy the extent, since stopfun could change the class of some
+  // objects...
+  std::vector<Rps_ObjectZone*> vecinst;
+  {
+    std::lock_guard<std::recursive_mutex> guext(ob_classextent_mtx_);
+    auto it = ob_classextent_map_.find(obclass.optr());
+    if (it == ob_classextent_map_.end())
+      return 0;
+    vecinst.reserve(it->second.size());
+    for (Rps_ObjectZone*obz: it->second)
+      vecinst.push_back(obz);
+  }
+  unsigned cnt = 0;
+  for (Rps_ObjectZone*obz: vecinst)
+    {
+      cnt++;
+      if (stopfun(obz))
+        break;
+    };
+  return cnt;
+} // end Rps_ObjectZone::iterate_class_extent
+
+Rps_SetValue
+Rps_ObjectZone::class_extent_set(Rps_ObjectRef obclass)
+{
+  std::vector<Rps_ObjectRef> vecinst;
+  vecinst.reserve(class_extent_count(obclass));
+  iterate_class_extent(obclass, [&](Rps_ObjectZone*obz)
+  {
+    vecinst.push_back(Rps_ObjectRef(obz));
+    return false;
+  });
+  return Rps_SetValue(vecinst);
+} // end Rps_ObjectZone::class_extent_set
+
 void
 Rps_ObjectZone::put_space(Rps_ObjectRef obr)
 {
@@ -359,11 +503,36 @@ Rps_ObjectZone::put_space(Rps_ObjectRef obr)
       if (obr->get_class() != RPS_ROOT_OB(_2i66FFjmS7n03HNNBx))
         throw std::runtime_error("invalid space object");
     };
-  ob_space.store(obr);
-  ob_mtime.store(rps_wallclock_real_time());
+  store_space(obr.optr());
+  touch_now();
 } // end Rps_ObjectZone::put_space
 
 
+void
+Rps_ObjectZone::store_space(Rps_ObjectZone*obzspace)
+{
+  std::lock_guard<std::recursive_mutex> gu(ob_mtx);
+  Rps_ObjectZone*oldspace = ob_space.exchange(obzspace);
+  if (oldspace != obzspace)
+    Rps_PayloadSpace::account_object(this, oldspace, obzspace);
+} // end Rps_ObjectZone::store_space
+
+
+
+void
+Rps_ObjectZone::update_attribute_indexes(const Rps_ObjectRef obattr)
+{
+  if (RPS_LIKELY(!Rps_PayloadAttrIndex::has_attribute_indexes()))
+    return;
+  if (!obattr)
+    return;
+  Rps_Value curval;
+  auto it = ob_attrs.find(obattr);
+  if (it != ob_attrs.end())
+    curval = it->second;
+  Rps_PayloadAttrIndex::note_attribute_change(this, obattr.optr(), curval);
+} // end Rps_ObjectZone::update_attribute_indexes
+
 
 void
 Rps_ObjectZone::remove_attr(const Rps_ObjectRef obattr)
@@ -379,7 +548,8 @@ Rps_ObjectZone::remove_attr(const Rps_ObjectRef obattr)
   }
   std::lock_guard<std::recursive_mutex> gu(ob_mtx);
   ob_attrs.erase(obattr);
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr);
+  touch_now();
 } // end Rps_ObjectZone::remove_attr
 
 
@@ -498,7 +668,8 @@ Rps_ObjectZone::put_attr(const Rps_ObjectRef obattr, const Rps_Value valattr)
     ob_attrs.erase(obattr);
   else
     ob_attrs.insert({obattr, valattr});
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr);
+  touch_now();
 } // end Rps_ObjectZone::put_attr
 
 
@@ -532,7 +703,9 @@ Rps_ObjectZone::put_attr2(const Rps_ObjectRef obattr0, const Rps_Value valattr0,
     ob_attrs.erase(obattr1);
   else
     ob_attrs.insert({obattr1, valattr1});
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr0);
+  update_attribute_indexes(obattr1);
+  touch_now();
 } // end Rps_ObjectZone::put_attr2
 
 void
@@ -578,7 +751,10 @@ Rps_ObjectZone::put_attr3(const Rps_ObjectRef obattr0, const Rps_Value valattr0,
     ob_attrs.erase(obattr2);
   else
     ob_attrs.insert({obattr2, valattr2});
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr0);
+  update_attribute_indexes(obattr1);
+  update_attribute_indexes(obattr2);
+  touch_now();
 } // end Rps_ObjectZone::put_attr3
 
 
@@ -638,7 +814,11 @@ Rps_ObjectZone::put_attr4(const Rps_ObjectRef obattr0, const Rps_Value valattr0,
     ob_attrs.erase(obattr3);
   else
     ob_attrs.insert({obattr3, valattr3});
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr0);
+  update_attribute_indexes(obattr1);
+  update_attribute_indexes(obattr2);
+  update_attribute_indexes(obattr3);
+  touch_now();
 } // end Rps_ObjectZone::put_attr4
 
 
@@ -668,7 +848,8 @@ Rps_ObjectZone::exchange_attr(const Rps_ObjectRef obattr, const Rps_Value valatt
     ob_attrs.insert({obattr, valattr});
   if (poldval)
     *poldval = oldval;
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr);
+  touch_now();
 } // end Rps_ObjectZone::exchange_attr
 
 
@@ -720,7 +901,9 @@ Rps_ObjectZone::exchange_attr2(const Rps_ObjectRef obattr0, const Rps_Value vala
     *poldval0 = oldval0;
   if (poldval1)
     *poldval1 = oldval1;
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr0);
+  update_attribute_indexes(obattr1);
+  touch_now();
 } // end Rps_ObjectZone::exchange_attr2
 
 void
@@ -793,7 +976,10 @@ Rps_ObjectZone::exchange_attr3(const Rps_ObjectRef obattr0, const Rps_Value vala
     *poldval1 = oldval1;
   if (poldval2)
     *poldval1 = oldval2;
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr0);
+  update_attribute_indexes(obattr1);
+  update_attribute_indexes(obattr2);
+  touch_now();
 } // end Rps_ObjectZone::exchange_attr3
 
 
@@ -889,7 +1075,11 @@ Rps_ObjectZone::exchange_attr4(const Rps_ObjectRef obattr0, const Rps_Value vala
     *poldval1 = oldval2;
   if (poldval3)
     *poldval1 = oldval3;
-  ob_mtime.store(rps_wallclock_real_time());
+  update_attribute_indexes(obattr0);
+  update_attribute_indexes(obattr1);
+  update_attribute_indexes(obattr2);
+  update_attribute_indexes(obattr3);
+  touch_now();
 } // end Rps_ObjectZone::exchange_attr4
 
 
@@ -924,6 +1114,7 @@ Rps_ObjectZone::append_comp1(Rps_Value comp0)
     comp0.clear();
   std::lock_guard gu(ob_mtx);
   ob_comps.push_back(comp0);
+  touch_now();
 } // end Rps_ObjectZone::append_comp1
 
 
@@ -945,6 +1136,7 @@ Rps_ObjectZone::append_comp2(Rps_Value comp0, Rps_Value comp1)
     };
   ob_comps.push_back(comp0);
   ob_comps.push_back(comp1);
+  touch_now();
 } // end Rps_ObjectZone::append_comp2
 
 
@@ -969,6 +1161,7 @@ Rps_ObjectZone::append_comp3(Rps_Value comp0, Rps_Value comp1, Rps_Value comp2)
   ob_comps.push_back(comp0);
   ob_comps.push_back(comp1);
   ob_comps.push_back(comp2);
+  touch_now();
 } // end Rps_ObjectZone::append_comp3
 
 void
@@ -994,6 +1187,7 @@ Rps_ObjectZone::append_comp4(Rps_Value comp0, Rps_Value comp1, Rps_Value comp2,
   ob_comps.push_back(comp1);
   ob_comps.push_back(comp2);
   ob_comps.push_back(comp3);
+  touch_now();
 } // end Rps_ObjectZone::append_comp4
 
 
@@ -1015,6 +1209,7 @@ Rps_ObjectZone::append_components(const std::initializer_list<Rps_Value>&compil)
         v.clear();
       ob_comps.push_back(v);
     }
+  touch_now();
 } // end Rps_ObjectZone::append_components
 
 
@@ -1037,6 +1232,7 @@ Rps_ObjectZone::append_components(const std::vector<Rps_Value>&compvec)
         v.clear();
       ob_comps.push_back(v);
     }
+  touch_now();
 } // end Rps_ObjectZone::append_components
 
 
@@ -1486,6 +1682,7 @@ Rps_PayloadClassInfo::put_symbname(Rps_ObjectRef obr)
     {
       symb->symbol_put_value(owner());
       pclass_symbname = obr;
+      touch_owner();
     }
 } // end Rps_PayloadClassInfo::put_symbname
 
@@ -1668,6 +1865,113 @@ Rps_PayloadSpace::dump_json_content(Rps_Dumper*du, Json::Value&jv) const
 } // end Rps_PayloadSpace::dump_json_content
 
 
+std::recursive_mutex Rps_PayloadSpace::space_countmtx;
+std::unordered_map<Rps_ObjectZone*,Rps_PayloadSpace::space_counters> Rps_PayloadSpace::space_countmap;
+
+std::recursive_mutex Rps_PayloadSpace::space_dumpmtx;
+std::unordered_map<Rps_ObjectZone*,Rps_PayloadSpace::space_dump_record> Rps_PayloadSpace::space_dumpmap;
+
+Rps_PayloadSpace::~Rps_PayloadSpace()
+{
+  {
+    std::lock_guard<std::recursive_mutex> gu(space_countmtx);
+    space_countmap.erase(owner());
+  }
+  std::lock_guard<std::recursive_mutex> gu(space_dumpmtx);
+  space_dumpmap.erase(owner());
+} // end Rps_PayloadSpace::~Rps_PayloadSpace
+
+void
+Rps_PayloadSpace::add_footprint(space_counters&sc, Rps_ObjectZone*obz, int sign)
+{
+  RPS_ASSERT(obz != nullptr);
+  RPS_ASSERT(sign == 1 || sign == -1);
+  std::lock_guard<std::recursive_mutex> gu(obz->ob_mtx);
+  sc.spc_nbobjects += sign;
+  sc.spc_attrwords += sign * 2 * (int64_t)obz->ob_attrs.size();
+  sc.spc_compwords += sign * (int64_t)obz->ob_comps.size();
+  Rps_Payload*payl = obz->ob_payload.load();
+  if (payl)
+    sc.spc_paylbytes += sign * (int64_t)payl->wordsize() * (int64_t)sizeof(void*);
+} // end Rps_PayloadSpace::add_footprint
+
+void
+Rps_PayloadSpace::account_object(Rps_ObjectZone*obz, Rps_ObjectZone*oldspace, Rps_ObjectZone*newspace)
+{
+  RPS_ASSERT(obz != nullptr);
+  if (oldspace == newspace)
+    return;
+  std::lock_guard<std::recursive_mutex> gu(space_countmtx);
+  if (oldspace)
+    add_footprint(space_countmap[oldspace], obz, -1);
+  if (newspace)
+    add_footprint(space_countmap[newspace], obz, 1);
+} // end Rps_PayloadSpace::account_object
+
+void
+Rps_PayloadSpace::replace_counters_after_gc(std::unordered_map<Rps_ObjectZone*,space_counters>&newmap)
+{
+  std::lock_guard<std::recursive_mutex> gu(space_countmtx);
+  space_countmap.swap(newmap);
+} // end Rps_PayloadSpace::replace_counters_after_gc
+
+Rps_PayloadSpace::space_counters
+Rps_PayloadSpace::counters_of_space(Rps_ObjectRef obspace)
+{
+  space_counters sc = {0,0,0,0};
+  if (!obspace)
+    return sc;
+  std::lock_guard<std::recursive_mutex> gu(space_countmtx);
+  auto it = space_countmap.find(obspace.optr());
+  if (it != space_countmap.end())
+    sc = it->second;
+  return sc;
+} // end Rps_PayloadSpace::counters_of_space
+
+std::map<Rps_ObjectRef,Rps_PayloadSpace::space_counters>
+Rps_PayloadSpace::all_space_counters(void)
+{
+  std::map<Rps_ObjectRef,space_counters> res;
+  std::lock_guard<std::recursive_mutex> gu(space_countmtx);
+  for (auto it : space_countmap)
+    res.insert({Rps_ObjectRef(it.first), it.second});
+  return res;
+} // end Rps_PayloadSpace::all_space_counters
+
+Json::Value
+Rps_PayloadSpace::json_space_counters(Rps_ObjectRef obspace)
+{
+  space_counters sc = counters_of_space(obspace);
+  Json::Value jv(Json::objectValue);
+  jv["nbobjects"] = (Json::Int64)sc.spc_nbobjects;
+  jv["attrwords"] = (Json::Int64)sc.spc_attrwords;
+  jv["compwords"] = (Json::Int64)sc.spc_compwords;
+  jv["paylbytes"] = (Json::Int64)sc.spc_paylbytes;
+  return jv;
+} // end Rps_PayloadSpace::json_space_counters
+
+bool
+Rps_PayloadSpace::dump_record_of_space(Rps_ObjectRef obspace, space_dump_record&sdr)
+{
+  if (!obspace)
+    return false;
+  std::lock_guard<std::recursive_mutex> gu(space_dumpmtx);
+  auto it = space_dumpmap.find(obspace.optr());
+  if (it == space_dumpmap.end())
+    return false;
+  sdr = it->second;
+  return true;
+} // end Rps_PayloadSpace::dump_record_of_space
+
+void
+Rps_PayloadSpace::put_dump_record(Rps_ObjectRef obspace, const space_dump_record&sdr)
+{
+  RPS_ASSERT(obspace);
+  std::lock_guard<std::recursive_mutex> gu(space_dumpmtx);
+  space_dumpmap[obspace.optr()] = sdr;
+} // end Rps_PayloadSpace::put_dump_record
+
+
 /***************** symbol payload **********/
 
 std::recursive_mutex Rps_PayloadSymbol::symb_tablemtx;
@@ -2071,7 +2375,7 @@ Rps_ObjectRef::make_named_class(Rps_CallFrame*callerframe, Rps_ObjectRef supercl
   RPS_INFORMOUT("Rps_ObjectRef::make_named_class name=" << name << ", paylsymbol=" << paylsymbol
                 << ", obclass=" << _f.obclass);
   /// the class is class `class`
-  _f.obclass->ob_class.store(RPS_ROOT_OB(_41OFI3r0S1t03qdB2E));
+  _f.obclass->store_class(RPS_ROOT_OB(_41OFI3r0S1t03qdB2E));
   auto paylclainf = _f.obclass->put_new_plain_payload<Rps_PayloadClassInfo>();
   paylclainf->put_superclass(_f.obsuperclass);
   paylclainf->put_symbname(_f.obsymbol);
@@ -2106,7 +2410,7 @@ Rps_ObjectRef::make_new_symbol(Rps_CallFrame*callerframe, std::string name, bool
       throw std::runtime_error(std::string("make_new_symbol with existing name"));
     }
   _f.obsymbol = Rps_ObjectZone::make();
-  _f.obsymbol->ob_class.store(RPS_ROOT_OB(_36I1BY2NetN03WjrOv)); // the `symbol` class
+  _f.obsymbol->store_class(RPS_ROOT_OB(_36I1BY2NetN03WjrOv)); // the `symbol` class
   Rps_PayloadSymbol::register_name(name, _f.obsymbol, isweak);
   RPS_NOPRINTOUT("Rps_ObjectRef::make_new_symbol name=" << name
                  << " gives obsymbol=" << _f.obsymbol);
@@ -2141,7 +2445,7 @@ Rps_ObjectRef::make_object(Rps_CallFrame*callerframe, Rps_ObjectRef classobarg,
         }
     };
   _f.resultob = Rps_ObjectZone::make();
-  _f.resultob->ob_class.store(_f.classob);
+  _f.resultob->store_class(_f.classob);
   RPS_DEBUG_LOG(LOWREP, "make_object classob=" << _f.classob << " -> resultob=" << _f.resultob);
   _f.resultob->put_space(_f.spaceob);
   /// FIXME: perhaps we should send some `initialize_object` message?
@@ -2167,7 +2471,7 @@ Rps_ObjectRef::make_mutable_set_object(Rps_CallFrame*callerframe, Rps_ObjectRef
                                   << "for make_mutable_set_object");
     };
   _f.resultob = Rps_ObjectZone::make();
-  _f.resultob->ob_class.store(RPS_ROOT_OB(_0J1C39JoZiv03qA2HA)); //mutable_set∈class
+  _f.resultob->store_class(RPS_ROOT_OB(_0J1C39JoZiv03qA2HA)); //mutable_set∈class
   _f.resultob->put_new_plain_payload<Rps_PayloadSetOb>();
   _f.resultob->put_space(_f.spaceob);
   return _f.resultob;
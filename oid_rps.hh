@@ -133,7 +133,7 @@ public:
   {
     return _id_lo;
   };
-  Rps_Id(uint64_t h, uint32_t l=0) : _id_hi(h), _id_lo(l)
+  Rps_Id(uint64_t h, uint64_t l=0) : _id_hi(h), _id_lo(l)
   {
     RPS_ASSERT((h==0 && l==0) || hash() != 0);
   };
@@ -169,7 +169,7 @@ public:
     std::swap(_id_lo, oth._id_lo);
     return *this;
   }
-  Rps_Id () : Rps_Id((uint64_t)0, (uint32_t)0) {};
+  Rps_Id () : Rps_Id((uint64_t)0, (uint64_t)0) {};
   Rps_Id (const char*buf, const char**pend=nullptr, bool *pok=nullptr);
   Rps_Id (const std::string&str) : Rps_Id(str.c_str()) {};
   void to_cbuf24(char cbuf[/*24*/]) const;
@@ -48,6 +48,8 @@
 #include <map>
 #include <deque>
 #include <variant>
+#include <string_view>
+#include <charconv>
 #include <unordered_map>
 #include <unordered_set>
 #include <new>
@@ -212,6 +214,16 @@ extern "C" bool rps_disable_aslr;
 extern "C" bool rps_run_web;
 extern "C" bool rps_run_repl;
 
+// when set, the dump also writes the RPS_SNAPSHOT_BIN binary snapshot
+extern "C" bool rps_dump_snapshot;
+
+// when set, the dump keeps the space files known to be unchanged
+extern "C" bool rps_dump_incremental;
+
+// when set, mutated objects are appended to the RPS_JOURNAL_FILE
+// write-ahead journal of the load directory
+extern "C" bool rps_journal_enabled;
+
 /// backtrace support
 extern "C" struct backtrace_state* rps_backtrace_common_state;
 
@@ -413,12 +425,18 @@ enum rps_progoption_en
   RPSPROGOPT_NO_QUICK_TESTS,
   RPSPROGOPT_REPL,
   RPSPROGOPT_TEST_REPL_LEXER,
+  RPSPROGOPT_TEST_UTF8,
+  RPSPROGOPT_TEST_JSON_TAPE,
   RPSPROGOPT_RUN_AFTER_LOAD,
   RPSPROGOPT_PLUGIN_AFTER_LOAD,
   RPSPROGOPT_DEBUG_AFTER_LOAD,
   RPSPROGOPT_CPLUSPLUSEDITOR_AFTER_LOAD,
   RPSPROGOPT_CPLUSPLUSFLAGS_AFTER_LOAD,
   RPSPROGOPT_DEBUG_PATH,
+  RPSPROGOPT_CLASS_EXTENTS,
+  RPSPROGOPT_BINARY_SNAPSHOT,
+  RPSPROGOPT_INCREMENTAL_DUMP,
+  RPSPROGOPT_JOURNAL,
   RPSPROGOPT_VERSION,
 };
 
@@ -650,6 +668,8 @@ extern "C" const char* rps_hostname(void);
 extern "C" void*rps_proghdl; // dlopen handle of whole program
 
 extern "C" Json::Value rps_string_to_json(const std::string&str);
+// parse JSON from a string view, e.g. a slice of a memory mapped file
+extern Json::Value rps_string_view_to_json(std::string_view strv);
 extern "C" std::string rps_json_to_string(const Json::Value&jv);
 
 #define RPS_FLEXIBLE_DIM 0	/* for flexible array members */
@@ -932,6 +952,7 @@ enum class Rps_Type : std::int16_t
   CallFrame = std::numeric_limits<std::int16_t>::min(),
   ////////////////
   /// payloads are negative, below -1
+  PaylAttrIndex = -16, // secondary indexes of objects by some attribute value
   PaylWebHandler = -15, // for reification of Web handlers,
 			// i.e. Rps_PayloadWebHandler-s
   PaylWebex = -14, // for reification as temporary objects of HTTP
@@ -1053,7 +1074,9 @@ public:
   inline bool is_set() const;
   inline bool is_closure() const;
   inline bool is_string() const;
+  inline bool is_immediate_string() const;
   inline bool is_double() const;
+  inline bool is_immediate_double() const;
   inline bool is_tuple() const;
   inline bool is_null() const;
   inline bool is_empty() const;
@@ -1074,6 +1097,8 @@ public:
   inline const Rps_TupleOb* as_tuple() const;
   inline  Rps_ObjectZone* as_object() const;
   inline const Rps_InstanceZone* as_instance() const;
+  /// only a boxed string, since an immediate one has no Rps_String;
+  /// box it explicitly with Rps_String::make where the result is rooted
   inline const Rps_String* as_string() const;
   inline const Rps_ClosureZone* as_closure() const;
   inline const Rps_Double* as_boxed_double() const;
@@ -1081,10 +1106,31 @@ public:
   inline const Rps_LexTokenZone* as_lextoken() const;
   inline double as_double() const;
   inline const std::string as_cppstring() const;
-  inline const char* as_cstring() const;
+  /// the C string may be inside the value word, so it is only given
+  /// for values which outlive its use, never for temporaries
+  inline const char* as_cstring() const &;
+  const char* as_cstring() const && = delete;
   Rps_ObjectRef compute_class(Rps_CallFrame*) const;
   // convert or give default
   static inline Rps_Value make_tagged_int(intptr_t);
+  /// Doubles whose two lowest IEEE bits are zero (this includes all
+  /// integers up to 2**51, and most short binary fractions) are kept
+  /// unboxed in the value word, tagged by its two lowest bits being
+  /// 0b10; tagged ints have 1 as lowest bit and pointers are aligned.
+  /// The other doubles are boxed in a Rps_Double zone.
+  static constexpr intptr_t immediate_double_tag = 2;
+  static constexpr intptr_t immediate_double_mask = 3;
+  static inline bool double_fits_immediate(double d);
+  /// Strings of at most six bytes, without NUL, are also kept in the
+  /// value word, tagged by 0b100 in its lowest three bits, with their
+  /// length in the next three bits of that lowest byte, and their
+  /// bytes just after it then a zero byte, so a pointer to the bytes
+  /// inside the value word is a C string living as long as that word.
+  static constexpr intptr_t immediate_string_tag = 4;
+  static constexpr intptr_t immediate_string_mask = 7;
+  static constexpr unsigned immediate_string_maxlen = 6;
+  static inline bool string_fits_immediate(const char*str, int len);
+  static inline Rps_Value make_string(const char*str, int len= -1);
   inline intptr_t to_int(intptr_t def=0) const;
   inline const Rps_ZoneValue* to_ptr(const Rps_ZoneValue*zp = nullptr) const;
   inline const Rps_SetOb* to_set(const Rps_SetOb*defset= nullptr) const;
@@ -1097,6 +1143,7 @@ public:
   inline const Rps_ObjectZone* to_object(const Rps_ObjectZone*defob
                                          =nullptr) const;
   inline const Rps_InstanceZone* to_instance(const Rps_InstanceZone*definst =nullptr) const;
+  // gives defstr for immediate strings, see as_string
   inline const Rps_String* to_string( const Rps_String*defstr
                                       = nullptr) const;
   inline const Rps_LexTokenZone* to_lextoken(void) const;
@@ -1168,6 +1215,11 @@ static_assert(sizeof(Rps_Value) == sizeof(void*),
 static_assert(alignof(Rps_Value) == alignof(void*),
               "Rps_Value should have the alignment of a word");
 
+// Return the length, in words, of the longest common prefix of the
+// NBW words at L and at R. Sequences and trees compare their element
+// words with it, so identical sons are skipped without any call.
+inline unsigned rps_common_word_prefix(const void*l, const void*r, unsigned nbw);
+
 
 
 ////////////////////////////////////////////////////////////////
@@ -1652,6 +1704,11 @@ public:
   {
     return gc_nbroots;
   };
+  /// the number of garbage collections started so far
+  static uint64_t count(void)
+  {
+    return gc_count_.load();
+  };
   uint64_t nb_scans() const
   {
     return gc_nbscan;
@@ -1696,6 +1753,7 @@ class Rps_QuasiZone : public Rps_TypedZone
 {
   friend class Rps_GarbageCollector;
   friend class Rps_LexTokenZone;
+  friend class Rps_PayloadSpace;
   // we keep each quasi-zone in the qz_zonvec
   static std::recursive_mutex qz_mtx;
   static std::vector<Rps_QuasiZone*> qz_zonvec;
@@ -1707,6 +1765,12 @@ protected:
   inline void* operator new (std::size_t siz, std::nullptr_t);
   inline void* operator new (std::size_t siz, unsigned wordgap);
   static constexpr uint16_t qz_gcmark_bit = 1;
+  /// count memory owned by a zone but allocated outside of it, such as
+  /// the side index of big sets, so it drives the garbage collector
+  static void count_side_allocation(size_t nbytes)
+  {
+    qz_alloc_cumulw.fetch_add((nbytes + sizeof(void*) - 1) / sizeof(void*));
+  };
 public:
   /// gives the number of machine words (8 bytes) allocated since
   /// start of process...
@@ -1841,12 +1905,13 @@ protected:
   virtual Rps_HashInt compute_hash(void) const =0;
   inline Rps_LazyHashedZoneValue(Rps_Type typ);
   virtual ~Rps_LazyHashedZoneValue() {};
-  // we need to serialize some rare modifications (e.g. of metadata in
-  // trees). They are rare, so we use a mutex indexed by the last ten
-  // bits of hash code...  We are supposing that metadata is
-  // read-mostly and only occasionally written...
-  static constexpr unsigned lazy_nbmutexes = 1024;
-  static std::mutex lazy_mtxarr[lazy_nbmutexes];
+  // values hashing their components while being built store their
+  // hash at once, it is never computed again
+  void put_precomputed_hash(Rps_HashInt h) const
+  {
+    RPS_ASSERT(h != 0);
+    _lazyhash.store(h);
+  };
 public:
   Rps_HashInt lazy_hash() const
   {
@@ -1866,11 +1931,37 @@ public:
 };				// end of Rps_LazyHashedZoneValue
 //////////////////////////////////////////////////////////// immutable strings
 
-// compute a long hash in ht[0] and ht[1]. Return the number of UTF-8
-// character or else 0 if cstr with len bytes is not proper UTF-8
+// The version of the string hash below; it is written in the
+// manifest, so any persistent data depending on string hashes can
+// notice a change of hash function.
+#define RPS_STRING_HASH_VERSION 2
+
+// compute a long hash in ht[0] and ht[1], byte per byte without
+// decoding UTF-8. Return the number of bytes hashed.
 extern "C"
 int rps_compute_cstr_two_64bits_hash(int64_t ht[2], const char*cstr, int len= -1);
 
+// the previous hash, version 1. Return the number of UTF-8
+// character or else 0 if cstr with len bytes is not proper UTF-8
+extern "C"
+int rps_compute_cstr_two_64bits_hash_v1(int64_t ht[2], const char*cstr, int len= -1);
+
+// check that the len bytes at str are proper UTF-8, like u8_check of
+// libunistring: return nullptr if valid, or else the first invalid
+// byte. When pcount is not null, it gets the number of UTF-8
+// characters checked. ASCII runs are scanned by SSE2 or AVX2 blocks.
+extern "C"
+const char* rps_utf8_check_count(const char*str, size_t len, uint32_t*pcount);
+
+// compare rps_utf8_check_count with libunistring, for --test-utf8;
+// return the number of mismatches
+extern "C" int rps_utf8_check_count_test(void);
+
+// check that the loader reads back the doubles written by the dumper,
+// infinite ones included, for --test-json-tape; return the number of
+// mismatches
+extern "C" int rps_json_tape_real_test(void);
+
 static inline Rps_HashInt rps_hash_cstr(const char*cstr, int len= -1);
 
 class Rps_String : public Rps_LazyHashedZoneValue
@@ -1879,6 +1970,8 @@ class Rps_String : public Rps_LazyHashedZoneValue
   friend class Rps_LexTokenValue;
   friend Rps_String*
   Rps_QuasiZone::rps_allocate_with_wordgap<Rps_String,const char*,int>(unsigned,const char*,int);
+  friend Rps_String*
+  Rps_QuasiZone::rps_allocate_with_wordgap<Rps_String,const char*,int,uint32_t>(unsigned,const char*,int,uint32_t);
   const uint32_t _bytsiz;
   const uint32_t _utf8len;
   union
@@ -1888,13 +1981,15 @@ class Rps_String : public Rps_LazyHashedZoneValue
   };
 protected:
   inline Rps_String (const char*cstr, int len= -1);
+  // when the UTF-8 length has already been computed while checking:
+  inline Rps_String (const char*cstr, int len, uint32_t utf8len);
   static inline const char*normalize_cstr(const char*cstr);
   static inline int normalize_len(const char*cstr, int len);
   static inline uint32_t safe_utf8len(const char*cstr, int len);
 protected:
   virtual Rps_HashInt compute_hash(void) const
   {
-    return rps_hash_cstr(_sbuf);
+    return rps_hash_cstr(_sbuf, _bytsiz);
   };
   virtual void gc_mark(Rps_GarbageCollector&, unsigned) const { };
 public:
@@ -1908,6 +2003,8 @@ public:
   virtual Json::Value dump_json(Rps_Dumper*) const;
   static const Rps_String* make(const char*cstr, int len= -1);
   static inline const Rps_String* make(const std::string&s);
+  /// also used for small strings immediate in Rps_Value
+  static Json::Value dump_json_cstr(const char*cstr);
   const char*cstr() const
   {
     return _sbuf;
@@ -1949,11 +2046,7 @@ protected:
 protected:
   virtual Rps_HashInt compute_hash(void) const
   {
-    auto rh = std::hash<double> {}((double)_dval);
-    Rps_HashInt h = static_cast<Rps_HashInt> (rh);
-    if (RPS_UNLIKELY(h == 0))
-      h = 987383;
-    return h;
+    return double_hash(_dval);
   };
   virtual Rps_ObjectRef compute_class(Rps_CallFrame*stkf) const;
   virtual void gc_mark(Rps_GarbageCollector&, unsigned) const { };
@@ -1963,6 +2056,15 @@ protected:
     return Json::Value(_dval);
   };
 public:
+  /// also used for unboxed doubles in Rps_Value, so both hash alike
+  static Rps_HashInt double_hash(double d)
+  {
+    auto rh = std::hash<double> {}(d);
+    Rps_HashInt h = static_cast<Rps_HashInt> (rh);
+    if (RPS_UNLIKELY(h == 0))
+      h = 987383;
+    return h;
+  };
   virtual void val_output(std::ostream& outs, unsigned depth) const;
   double dval() const
   {
@@ -2153,6 +2255,8 @@ public:
   friend class Rps_Loader;
   friend class Rps_Dumper;
   friend class Rps_Payload;
+  friend class Rps_PayloadAttrIndex;
+  friend class Rps_PayloadSpace;
   friend class Rps_ObjectRef;
   friend class Rps_Value;
   friend Rps_ObjectZone*
@@ -2178,12 +2282,28 @@ private:
   static std::recursive_mutex ob_idmtx_;
   static void register_objzone(Rps_ObjectZone*);
   static Rps_Id fresh_random_oid(Rps_ObjectZone*ob =nullptr);
+  // the optional class extents, associating to each class the set of
+  // its direct instances. They are weak: the garbage collector don't
+  // mark them, and an object is removed from its extent when deleted.
+  static std::atomic<bool> ob_classextent_enabled_;
+  static std::unordered_map<Rps_ObjectZone*,std::unordered_set<Rps_ObjectZone*>> ob_classextent_map_;
+  static std::recursive_mutex ob_classextent_mtx_;
+  // every store into ob_class should go thru store_class, to keep
+  // the class extents up to date
+  void store_class(Rps_ObjectZone*obzclass);
+  void move_in_class_extent(Rps_ObjectZone*oldclass, Rps_ObjectZone*newclass);
+  // after any change of the attribute obattr, with ob_mtx locked,
+  // keep the Rps_PayloadAttrIndex-es of obattr up to date
+  void update_attribute_indexes(const Rps_ObjectRef obattr);
+  // every store into ob_space should go thru store_space, to keep
+  // the Rps_PayloadSpace counters up to date
+  void store_space(Rps_ObjectZone*obzspace);
 protected:
   void loader_set_class (Rps_Loader*ld, Rps_ObjectZone*obzclass)
   {
     RPS_ASSERT(ld != nullptr);
     RPS_ASSERT(obzclass != nullptr);
-    ob_class.store(obzclass);
+    store_class(obzclass);
   };
   void loader_set_mtime (Rps_Loader*ld, double mtim)
   {
@@ -2195,7 +2315,7 @@ protected:
   {
     RPS_ASSERT(ld != nullptr);
     RPS_ASSERT(obzspace != nullptr);
-    ob_space.store(obzspace);
+    store_space(obzspace);
   };
   void loader_put_attr (Rps_Loader*ld, const Rps_ObjectRef keyatob, const Rps_Value atval)
   {
@@ -2240,9 +2360,7 @@ public:
   };
   void put_applying_function(rps_applyingfun_t*afun);
   void gui_window_reset_class(RpsGui_Window*win);
-  void touch_now(void) {
-    ob_mtime.store(rps_wallclock_real_time());
-  };
+  inline void touch_now(void);
   std::string string_oid(void) const;
   inline Rps_Payload*get_payload(void) const;
   const std::string payload_type_name(void) const;
@@ -2319,6 +2437,7 @@ public:
     Rps_Payload*oldpayl = ob_payload.exchange(newpayl);
     if (oldpayl)
       delete oldpayl;
+    touch_now();
     return newpayl;
   };				// end put_new_plain_payload
   template<class PaylClass, typename Arg1Class>
@@ -2330,6 +2449,7 @@ public:
     Rps_Payload*oldpayl = ob_payload.exchange(newpayl);
     if (oldpayl)
       delete oldpayl;
+    touch_now();
     return newpayl;
   };				// end put_new_arg1_payload
   template<class PaylClass, typename Arg1Class, typename Arg2Class>
@@ -2341,6 +2461,7 @@ public:
     Rps_Payload*oldpayl = ob_payload.exchange(newpayl);
     if (oldpayl)
       delete oldpayl;
+    touch_now();
     return newpayl;
   };				// end put_new_arg2_payload
   template<class PaylClass, typename Arg1Class, typename Arg2Class, typename Arg3Class>
@@ -2352,6 +2473,7 @@ public:
     Rps_Payload*oldpayl = ob_payload.exchange(newpayl);
     if (oldpayl)
       delete oldpayl;
+    touch_now();
     return newpayl;
   };				// end put_new_arg3_payload
   template<class PaylClass, typename Arg1Class, typename Arg2Class, typename Arg3Class, typename Arg4Class>
@@ -2363,6 +2485,7 @@ public:
     Rps_Payload*oldpayl = ob_payload.exchange(newpayl);
     if (oldpayl)
       delete oldpayl;
+    touch_now();
     return newpayl;
   };				// end put_new_arg4_payload
   template<class PaylClass>
@@ -2374,6 +2497,7 @@ public:
     Rps_Payload*oldpayl = ob_payload.exchange(newpayl);
     if (oldpayl)
       delete oldpayl;
+    touch_now();
     return newpayl;
   };				// end put_new_plain_payload_with_wordgap
   template<class PaylClass, typename Arg1Class>
@@ -2385,6 +2509,7 @@ public:
     Rps_Payload*oldpayl = ob_payload.exchange(newpayl);
     if (oldpayl)
       delete oldpayl;
+    touch_now();
     return newpayl;
   };				// end put_new_arg1_payload_with_wordgap
   template<class PaylClass, typename Arg1Class, typename Arg2Class>
@@ -2396,6 +2521,7 @@ public:
     Rps_Payload*oldpayl = ob_payload.exchange(newpayl);
     if (oldpayl)
       delete oldpayl;
+    touch_now();
     return newpayl;
   };				// end put_new_arg2_payload_with_wordgap
   virtual uint32_t wordsize() const
@@ -2439,6 +2565,21 @@ public:
   // call a given C++ closure on every possible object ref, till that
   // closure returns true. Return the number of matches, or else 0
   static int autocomplete_oid(const char*prefix, const std::function<bool(const Rps_ObjectZone*)>&stopfun);
+  //////////////// class extents, i.e. direct instances of a class
+  // start maintaining the class extents, scanning every object once;
+  // also done by the --class-extents program option, or at first query
+  static void enable_class_extents(void);
+  static bool has_class_extents(void)
+  {
+    return ob_classextent_enabled_.load();
+  };
+  // the number of direct instances of obclass
+  static unsigned class_extent_count(Rps_ObjectRef obclass);
+  // call a given C++ closure on every direct instance of obclass, till
+  // that closure returns true. Return the number of visited instances
+  static unsigned iterate_class_extent(Rps_ObjectRef obclass, const std::function<bool(Rps_ObjectZone*)>&stopfun);
+  // the set of direct instances of obclass
+  static Rps_SetValue class_extent_set(Rps_ObjectRef obclass);
 };				// end class Rps_ObjectZone
 
 //////////////////////////////////////////////////////////// object payloads
@@ -2465,6 +2606,8 @@ protected:
   {
     payl_owner = nullptr;
   };
+  /// to be called by mutators of the persistent payload state
+  inline void touch_owner(void);
 public:
   Rps_Payload(Rps_Type ty, Rps_ObjectZone*obz, Rps_Loader*ld)
     : Rps_Payload(ty,obz)
@@ -2480,6 +2623,12 @@ public:
   virtual void gc_mark(Rps_GarbageCollector&gc) const =0;
   virtual void dump_scan(Rps_Dumper*du) const =0;
   virtual void dump_json_content(Rps_Dumper*, Json::Value&) const =0;
+  /// true if every mutator of the dumped state calls touch_owner, so
+  /// an incremental dump can trust the mtime of the owner
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return false;
+  };
   Rps_ObjectZone* owner() const
   {
     return payl_owner;
@@ -2495,19 +2644,41 @@ public:
 /////////////////////////// sequences (tuples or sets) of Rps_ObjectRef
 class Rps_SetOb;
 class Rps_TupleOb;
+/// the lazily built membership index of big sets, see
+/// Rps_SetOb::side_index; it is an empty base of tuples, which take
+/// no room for it
+template<Rps_Type seqty> struct Rps_SeqSideIndex
+{
+};
+template<> struct Rps_SeqSideIndex<Rps_Type::Set>
+{
+  mutable std::atomic<uint32_t*> _seqsideindex;
+  Rps_SeqSideIndex() : _seqsideindex(nullptr) {};
+  ~Rps_SeqSideIndex()
+  {
+    delete[] _seqsideindex.load();
+  };
+};
 template<typename RpsSeq, Rps_Type seqty, unsigned k1, unsigned k2, unsigned k3>
-class Rps_SeqObjRef : public Rps_LazyHashedZoneValue
+class Rps_SeqObjRef : public Rps_LazyHashedZoneValue, protected Rps_SeqSideIndex<seqty>
 {
   friend class Rps_SetOb;
   friend class Rps_TupleOb;
+  friend class Rps_TupleBuilder;
   friend RpsSeq*
   Rps_QuasiZone::rps_allocate_with_wordgap<RpsSeq,unsigned>(unsigned,unsigned);
-  const unsigned _seqlen;
+  // not const, since sets are sorted and deduplicated in place by
+  // Rps_SetOb, and tuples filled by Rps_TupleBuilder, then shrunk,
+  // before being given
+  unsigned _seqlen;
   Rps_ObjectRef _seqob[RPS_FLEXIBLE_DIM+1];
   Rps_SeqObjRef(unsigned len) : Rps_LazyHashedZoneValue(seqty), _seqlen(len)
   {
     memset ((void*)_seqob, 0, sizeof(Rps_ObjectRef)*len);
   };
+  virtual ~Rps_SeqObjRef()
+  {
+  };
   Rps_ObjectRef*raw_data()
   {
     return _seqob;
@@ -2519,6 +2690,33 @@ class Rps_SeqObjRef : public Rps_LazyHashedZoneValue
 public:
   static unsigned constexpr maxsize
     = std::numeric_limits<unsigned>::max() / 2;
+  /// the hash of a sequence mixes its elements one by one and its
+  /// length last, so it is computed in the loop filling a new sequence
+  class hasher
+  {
+    Rps_HashInt hsh_h0, hsh_h1;
+    unsigned hsh_count;
+  public:
+    hasher() : hsh_h0(3317+(k3&0xff)), hsh_h1(31), hsh_count(0) {};
+    void add(Rps_ObjectRef ob)
+    {
+      if (RPS_UNLIKELY(ob.is_empty()))
+        throw std::runtime_error("corrupted sequence of objects");
+      if (hsh_count % 2 == 0)
+        hsh_h0 = (hsh_h0 * k1) ^ (ob.obhash() * k2 + hsh_count);
+      else
+        hsh_h1 = (hsh_h1 * k2) ^ (ob.obhash() * k3 - (hsh_h0&0xfff));
+      hsh_count++;
+    };
+    Rps_HashInt result(void) const
+    {
+      Rps_HashInt h = 5*hsh_h0 + 11*hsh_h1 + 31*hsh_count;
+      if (RPS_UNLIKELY(h == 0))
+        h = ((hsh_h0 & 0xfffff) ^ (hsh_h1 & 0xfffff)) + (k1/128 + (hsh_count & 0xff) + 3);
+      RPS_ASSERT(h != 0);
+      return h;
+    };
+  };
   unsigned cnt() const
   {
     return _seqlen;
@@ -2595,22 +2793,10 @@ public:
 protected:
   virtual Rps_HashInt compute_hash(void) const
   {
-    Rps_HashInt h0= 3317+(k3&0xff), h1= 31*_seqlen;
-    for (unsigned ix=0; ix<_seqlen; ix += 2)
-      {
-        if (RPS_UNLIKELY(_seqob[ix].is_empty()))
-          throw std::runtime_error("corrupted sequence of objects");
-        h0 = (h0 * k1) ^ (_seqob[ix]->obhash() * k2 + ix);
-        if (ix+1 >= _seqlen) break;
-        auto nextob = _seqob[ix+1];
-        if (RPS_UNLIKELY(nextob.is_empty())) break;
-        h1 = (h1 * k2) ^ (nextob->obhash() * k3 - (h0&0xfff));
-      };
-    Rps_HashInt h = 5*h0 + 11*h1;
-    if (RPS_UNLIKELY(h == 0))
-      h = ((h0 & 0xfffff) ^ (h1 & 0xfffff)) + (k1/128 + (_seqlen & 0xff) + 3);
-    RPS_ASSERT(h != 0);
-    return h;
+    hasher hs;
+    for (unsigned ix=0; ix<_seqlen; ix++)
+      hs.add(_seqob[ix]);
+    return hs.result();
   };
   virtual bool equal(const Rps_ZoneValue&zv) const
   {
@@ -2623,10 +2809,8 @@ protected:
         auto curcnt = cnt();
         if (RPS_LIKELY(oth->cnt() != curcnt))
           return false;
-        for (unsigned ix = 0; ix < curcnt; ix++)
-          if (_seqob[ix] != oth->_seqob[ix])
-            return false;
-        return true;
+        // elements are object references, equal iff their words are
+        return !memcmp(_seqob, oth->_seqob, curcnt*sizeof(_seqob[0]));
       }
     return false;
   }
@@ -2635,8 +2819,16 @@ protected:
     if (zv.stored_type() == seqty)
       {
         auto oth = reinterpret_cast<const RpsSeq*>(&zv);
-        return std::lexicographical_compare(begin(), end(),
-                                            oth->begin(), oth->end());
+        if (RPS_UNLIKELY(oth == this))
+          return false;
+        unsigned curcnt = cnt(), othcnt = oth->cnt();
+        unsigned mincnt = (curcnt < othcnt)?curcnt:othcnt;
+        // skip the common prefix; only the first different element
+        // needs its oid compared
+        unsigned ix = rps_common_word_prefix(_seqob, oth->_seqob, mincnt);
+        if (ix < mincnt)
+          return _seqob[ix] < oth->_seqob[ix];
+        return curcnt < othcnt;
       }
     return false;
   };
@@ -2658,6 +2850,44 @@ public:
 protected:
   friend Rps_SetOb*
   Rps_QuasiZone::rps_allocate_with_wordgap<Rps_SetOb,unsigned,Rps_SetTag>(unsigned,unsigned,Rps_SetTag);
+  /// sets are built without any temporary std::set: the elements are
+  /// copied into a fresh set allocated for at most that many, then
+  /// sorted there by insertion (tiny sets), std::sort, or a radix
+  /// sort on the oids (big sets), deduplicated, and the set is shrunk.
+  static constexpr unsigned small_sort_threshold = 16;
+  static constexpr unsigned radix_sort_threshold = 2048;
+  /// collect merges at most that many already sorted sets in
+  /// linear time; with more, it sorts everything
+  static constexpr unsigned collect_merge_maxsets = 8;
+  static Rps_SetOb* allocate_for(size_t nbelem);
+  static void radix_sort_elements(Rps_ObjectRef*arr, unsigned nbelem);
+  static unsigned sort_dedup_elements(Rps_ObjectRef*arr, unsigned nbelem);
+  void shrink_to(unsigned card);
+  static const Rps_SetOb*make_from_range(const Rps_ObjectRef*beg, const Rps_ObjectRef*end);
+  static const Rps_SetOb*collect_from_range(const Rps_Value*beg, const Rps_Value*end);
+  /// set operations gallop through the bigger set when the other one
+  /// is at least that many times smaller, and merge linearly otherwise
+  static constexpr unsigned gallop_size_ratio = 16;
+  static inline const Rps_ObjectRef*gallop_lower_bound(const Rps_ObjectRef*beg,
+      const Rps_ObjectRef*end, const Rps_ObjectRef ob);
+  /// Sets with at least that many elements get, at their first
+  /// membership query, an immutable open addressing hash table of
+  /// 32 bits element indexes (plus one, zero for empty slots), keyed
+  /// by object address; its first word is the mask of slots. A probe
+  /// then only reads the table and _seqob, never the element objects.
+  static constexpr unsigned sideindex_threshold = 64;
+  static inline uint64_t sideindex_hash(const Rps_ObjectZone*obz)
+  {
+    return ((uint64_t)(uintptr_t)obz >> 4) * UINT64_C(0x9e3779b97f4a7c15);
+  };
+  const uint32_t*side_index(void) const;
+  int side_index_find(const uint32_t*sidix, const Rps_ObjectZone*obz) const;
+  /// the words of the side index, if it has been built
+  uint32_t side_index_wordsize(void) const
+  {
+    const uint32_t*sidix = _seqsideindex.load(std::memory_order_acquire);
+    return sidix ? (uint32_t)((sidix[0] + 2) * sizeof(uint32_t) + sizeof(void*) - 1) / sizeof(void*) : 0;
+  };
 public:
   // make a set from given object references
   static const Rps_SetOb*make(const std::set<Rps_ObjectRef>& setob);
@@ -2675,6 +2905,17 @@ public:
   inline bool contains(const Rps_ObjectRef obelem) const { return element_index(obelem) >= 0; };
   unsigned cardinal() const { return cnt(); };
   static const Rps_SetOb& the_empty_set(void) { return _setob_emptyset_; };
+  /// set algebra on sorted sets, a null set being empty; the result
+  /// may be one of the given sets when it is equal to it
+  static const Rps_SetOb*set_union(const Rps_SetOb*set1, const Rps_SetOb*set2);
+  static const Rps_SetOb*set_intersection(const Rps_SetOb*set1, const Rps_SetOb*set2);
+  static const Rps_SetOb*set_difference(const Rps_SetOb*set1, const Rps_SetOb*set2);
+  bool is_subset_of(const Rps_SetOb*superset) const;
+  bool intersects(const Rps_SetOb*otherset) const;
+  virtual uint32_t wordsize() const
+  {
+    return parentseq_t::wordsize() + side_index_wordsize();
+  };
 #warning Rps_SetOb very incomplete
 };// end of Rps_SetOb
 
@@ -2707,6 +2948,58 @@ public:
 };// end of Rps_TupleOb
 
 
+/// A tuple builder appends objects (nil ones are skipped, like in
+/// Rps_TupleOb::make) directly into a tuple zone allocated for the
+/// given capacity, which is doubled when full. Sealing shrinks and
+/// gives the tuple, which is immutable from then on. The unsealed
+/// zone is not yet a value, and the zones left by growing are
+/// garbage, so a builder is no GC root: the GC only runs at agenda
+/// safe points, and a builder kept across one must be marked with
+/// gc_mark, usually by set_additional_gc_marker of its call frame.
+/// Growing and sealing assert that every GC since the builder was
+/// made has marked it.
+class Rps_TupleBuilder
+{
+  Rps_TupleOb* tupb_tuple;
+  unsigned tupb_count;
+  // the GC count when made or last marked, see check_gc_marked
+  mutable uint64_t tupb_gccount;
+  void check_gc_marked(void) const
+  {
+    RPS_ASSERT(tupb_gccount == Rps_GarbageCollector::count());
+  };
+  // the hash of the objects appended so far
+  Rps_TupleOb::hasher tupb_hasher;
+  void reallocate(unsigned newcapacity);
+  void grow(unsigned mincapacity);
+public:
+  static constexpr unsigned default_capacity = 8;
+  Rps_TupleBuilder(unsigned capacity=0);
+  Rps_TupleBuilder(const Rps_TupleBuilder&) = delete;
+  Rps_TupleBuilder& operator = (const Rps_TupleBuilder&) = delete;
+  ~Rps_TupleBuilder() {};
+  unsigned count(void) const { return tupb_count; };
+  unsigned capacity(void) const { return tupb_tuple?tupb_tuple->_seqlen:0; };
+  void push_back(Rps_ObjectRef ob)
+  {
+    if (!ob)
+      return;
+    if (RPS_UNLIKELY(tupb_count >= capacity()))
+      grow(tupb_count+1);
+    tupb_hasher.add(ob);
+    tupb_tuple->_seqob[tupb_count++] = ob;
+  };
+  void append(const Rps_TupleOb*tup);
+  void append(const Rps_SetOb*set);
+  /// append an object, or the elements of a tuple or set, like
+  /// Rps_TupleOb::collect does
+  void append(Rps_Value val);
+  void gc_mark(Rps_GarbageCollector&gc) const;
+  /// give the immutable tuple; the builder becomes empty
+  const Rps_TupleOb* seal(void);
+};    // end class Rps_TupleBuilder
+
+
 ////////////////////////////////////////////////////////////////
 
 /////////////////////////// tree zones, with connective and sons
@@ -2718,11 +3011,16 @@ class Rps_TreeZone : public Rps_LazyHashedZoneValue
 {
   friend class Rps_ClosureZone;
   friend class Rps_InstanceZone;
+  template<typename,typename> friend class Rps_TreeBuilder;
   friend RpsTree*
   Rps_QuasiZone::rps_allocate_with_wordgap<RpsTree,unsigned>(unsigned,unsigned);
-  const unsigned _treelen;
+  // not const, since a Rps_TreeBuilder shrinks it when sealing
+  unsigned _treelen;
   mutable std::atomic<bool> _treetransient;
   mutable std::atomic<bool> _treemetatransient;
+  // odd while the metadata is being changed, see
+  // begin_metadata_change; readers retry until it is even and stable
+  mutable std::atomic<uint32_t> _treemetaversion;
   mutable std::atomic<int32_t> _treemetarank;
   mutable std::atomic<Rps_ObjectZone*> _treemetaob;
   Rps_ObjectRef _treeconnob;
@@ -2730,7 +3028,7 @@ class Rps_TreeZone : public Rps_LazyHashedZoneValue
   Rps_TreeZone(unsigned len, Rps_ObjectRef obr=nullptr)
     : Rps_LazyHashedZoneValue(treety), _treelen(len), 
       _treetransient(false), _treemetatransient(false),
-      _treemetarank(0), _treemetaob(nullptr),
+      _treemetaversion(0), _treemetarank(0), _treemetaob(nullptr),
       _treeconnob(obr)
   {
     memset ((void*)_treesons, 0, sizeof(Rps_Value)*len);
@@ -2743,9 +3041,45 @@ class Rps_TreeZone : public Rps_LazyHashedZoneValue
   {
     return _treesons;
   };
+  inline uint32_t begin_metadata_change(void);
+  inline void end_metadata_change(uint32_t version);
 public:
   static unsigned constexpr maxsize
     = std::numeric_limits<unsigned>::max() / 2;
+  /// like for sequences, the hash of a tree mixes its connective
+  /// first, then its sons one by one, and its length last
+  class hasher
+  {
+    Rps_HashInt hsh_h0, hsh_h1, hsh_connh;
+    unsigned hsh_count;
+  public:
+    hasher(Rps_ObjectRef connob)
+      : hsh_h0(0), hsh_h1(211), hsh_connh(connob?connob.obhash():0), hsh_count(0)
+    {
+      hsh_h0 = 3317+(k1&0xff)+hsh_connh*k3;
+    };
+    void add(Rps_Value son)
+    {
+      if (RPS_LIKELY(!son.is_empty()))
+        {
+          if (hsh_count % 2 == 0)
+            hsh_h0 = (hsh_h0 * k1) ^ (son.valhash() * k2 + hsh_count);
+          else
+            hsh_h1 = (hsh_h1 * k3) ^ (son.valhash() * k4 - (hsh_h0&0xfff));
+        }
+      hsh_count++;
+    };
+    Rps_HashInt result(void) const
+    {
+      Rps_HashInt h = 53*hsh_h0 + 17*hsh_h1 + 211*hsh_count;
+      if (RPS_UNLIKELY(h == 0))
+        h = ((hsh_h0 & 0xfffff)
+             ^ (hsh_h1 & 0xfffff)) + (k3/128
+                                      + (hsh_connh%65353) + (hsh_count & 0xff) + 13);
+      RPS_ASSERT(h != 0);
+      return h;
+    };
+  };
   unsigned cnt() const
   {
     return _treelen;
@@ -2787,25 +3121,10 @@ public:
 protected:
   virtual Rps_HashInt compute_hash(void) const
   {
-    Rps_HashInt h0= 3317+(k1&0xff)+_treeconnob->obhash()*k3, h1= 211*_treelen;
-    for (unsigned ix=0; ix<_treelen; ix += 2)
-      {
-        auto curson = _treesons[ix];
-        if (RPS_LIKELY(!curson.is_empty()))
-          h0 = (h0 * k1) ^ (curson.valhash() * k2 + ix);
-        if (ix+1 >= _treelen)
-          break;
-        auto nextson = _treesons[ix+1];
-        if (RPS_LIKELY(!nextson.is_empty()))
-          h1 = (h1 * k3) ^ (nextson.valhash() * k4 - (h0&0xfff));
-      };
-    Rps_HashInt h = 53*h0 + 17*h1;
-    if (RPS_UNLIKELY(h == 0))
-      h = ((h0 & 0xfffff)
-           ^ (h1 & 0xfffff)) + (k3/128
-                                + (_treeconnob->obhash()%65353) + (_treelen & 0xff) + 13);
-    RPS_ASSERT(h != 0);
-    return h;
+    hasher hs(_treeconnob);
+    for (unsigned ix=0; ix<_treelen; ix++)
+      hs.add(_treesons[ix]);
+    return hs.result();
   };
   virtual bool equal(const Rps_ZoneValue&zv) const
   {
@@ -2820,10 +3139,19 @@ protected:
           return false;
         if (RPS_LIKELY(_treeconnob != oth->_treeconnob))
           return false;
-        for (unsigned ix = 0; ix < curcnt; ix++)
-          if (_treesons[ix] != oth->_treesons[ix])
-            return false;
-        return true;
+        // identical son words are skipped by blocks; only the sons
+        // whose words differ, e.g. distinct but equal boxed values,
+        // are compared as values
+        unsigned ix = 0;
+        for (;;)
+          {
+            ix += rps_common_word_prefix(_treesons+ix, oth->_treesons+ix, curcnt-ix);
+            if (ix >= curcnt)
+              return true;
+            if (_treesons[ix] != oth->_treesons[ix])
+              return false;
+            ix++;
+          }
       }
     return false;
   }
@@ -2832,13 +3160,25 @@ protected:
     if (zv.stored_type() == treety)
       {
         auto oth = reinterpret_cast<const RpsTree*>(&zv);
+        if (RPS_UNLIKELY(oth == this))
+          return false;
         if (_treeconnob < oth->_treeconnob)
           return true;
         if (_treeconnob > oth->_treeconnob)
           return false;
         RPS_ASSERT(_treeconnob == oth->_treeconnob);
-        return std::lexicographical_compare(begin(), end(),
-                                            oth->begin(), oth->end());
+        unsigned curcnt = cnt(), othcnt = oth->cnt();
+        unsigned mincnt = (curcnt < othcnt)?curcnt:othcnt;
+        unsigned ix = 0;
+        for (;;)
+          {
+            ix += rps_common_word_prefix(_treesons+ix, oth->_treesons+ix, mincnt-ix);
+            if (ix >= mincnt)
+              return curcnt < othcnt;
+            if (_treesons[ix] != oth->_treesons[ix])
+              return _treesons[ix] < oth->_treesons[ix];
+            ix++;
+          }
       }
     return false;
   };
@@ -2993,6 +3333,53 @@ public:
 };    // end class Rps_InstanceZone
 
 
+/// A tree builder appends sons, nil ones included, directly into a
+/// closure or instance zone with the given connective, allocated for
+/// the given capacity and doubled when full. Like a Rps_TupleBuilder,
+/// it is no GC root and must be marked by gc_mark when kept across an
+/// agenda safe point.
+template<typename RpsTree, typename RpsTreeTag>
+class Rps_TreeBuilder
+{
+  Rps_ObjectRef treb_connob;
+  RpsTree* treb_tree;
+  unsigned treb_count;
+  // the GC count when made or last marked, see check_gc_marked
+  mutable uint64_t treb_gccount;
+  void check_gc_marked(void) const
+  {
+    RPS_ASSERT(treb_gccount == Rps_GarbageCollector::count());
+  };
+  // the hash of the sons appended so far
+  typename RpsTree::hasher treb_hasher;
+  inline void reallocate(unsigned newcapacity);
+  inline void grow(unsigned mincapacity);
+public:
+  static constexpr unsigned default_capacity = 4;
+  inline Rps_TreeBuilder(Rps_ObjectRef connob, unsigned capacity=0);
+  Rps_TreeBuilder(const Rps_TreeBuilder&) = delete;
+  Rps_TreeBuilder& operator = (const Rps_TreeBuilder&) = delete;
+  ~Rps_TreeBuilder() {};
+  unsigned count(void) const { return treb_count; };
+  unsigned capacity(void) const { return treb_tree?treb_tree->_treelen:0; };
+  Rps_ObjectRef connob(void) const { return treb_connob; };
+  void push_back(Rps_Value val)
+  {
+    if (RPS_UNLIKELY(treb_count >= capacity()))
+      grow(treb_count+1);
+    treb_hasher.add(val);
+    treb_tree->_treesons[treb_count++] = val;
+  };
+  inline void gc_mark(Rps_GarbageCollector&gc) const;
+  /// give the immutable tree, or nullptr without connective; the
+  /// builder becomes empty
+  inline RpsTree* seal(void);
+};    // end class Rps_TreeBuilder
+
+typedef Rps_TreeBuilder<Rps_ClosureZone,Rps_ClosureTag> Rps_ClosureBuilder;
+typedef Rps_TreeBuilder<Rps_InstanceZone,Rps_InstanceTag> Rps_InstanceBuilder;
+
+
 class Rps_InstanceValue : public Rps_Value
 {
 public:
@@ -3017,24 +3404,101 @@ public:
 
 //////////////////////////////////////////////// Json values
 
+struct Rps_JsonTag {};
+
+/// A JSON value is kept compact and immutable in a single wordgap
+/// allocation: a tape of 64 bits words, in preorder, followed by a
+/// pool of string bytes where equal strings (notably keys) are
+/// interned once. Every node starts with a header word, whose lowest
+/// byte is its kind (in the order of Json::ValueType) and whose other
+/// bits are its payload:
+///   null: no payload; bool: payload 0 or 1;
+///   int, uint, real: one more word, the bits of the number;
+///   string: payload is the byte length, one more word, the pool offset;
+///   array: payload is the count, one more word, the tape index just
+///     after the node, then the element nodes;
+///   object: payload is the count, one more word, the tape index just
+///     after the node, then per member a word packing the key pool
+///     offset (high half) and length (low half) and a word giving the
+///     tape index of its value, sorted like jsoncpp sorts keys, then
+///     the value nodes.
+/// Equal JSON values give equal tapes, and members are found by
+/// binary search. A Json::Value is only rebuilt at the first call of
+/// json(), then kept for the later ones.
 class Rps_JsonZone : public Rps_LazyHashedZoneValue
 {
+public:
+  enum jsonkind_en : uint8_t
+  {
+    jsk_null = Json::nullValue,
+    jsk_int = Json::intValue,
+    jsk_uint = Json::uintValue,
+    jsk_real = Json::realValue,
+    jsk_string = Json::stringValue,
+    jsk_bool = Json::booleanValue,
+    jsk_array = Json::arrayValue,
+    jsk_object = Json::objectValue,
+  };
+  struct tape_builder;
+private:
+  friend struct tape_builder;
   friend Rps_JsonZone*
-  Rps_QuasiZone::rps_allocate<Rps_JsonZone,const Json::Value&>(const Json::Value&);
-  const Json::Value _jsonval;
+  Rps_QuasiZone::rps_allocate_with_wordgap<Rps_JsonZone,uint32_t,uint32_t,Rps_JsonTag>(unsigned,uint32_t,uint32_t,Rps_JsonTag);
+  const uint32_t _jstapelen;	// number of words in the tape
+  const uint32_t _jspoolsize;	// number of bytes in the pool
+  // the rebuilt jsoncpp value, see json()
+  mutable std::atomic<Json::Value*> _jscache;
+  uint64_t _jstape[RPS_FLEXIBLE_DIM+1];
+  Rps_JsonZone(uint32_t tapelen, uint32_t poolsize, Rps_JsonTag);
+  virtual ~Rps_JsonZone();
+  const char*pool(void) const
+  {
+    return reinterpret_cast<const char*>(_jstape + _jstapelen);
+  };
+  uint64_t payload(uint32_t node) const
+  {
+    return _jstape[node] >> 8;
+  };
+  uint32_t node_end(uint32_t node) const;
+  Json::Value json_node(uint32_t node) const;
+  void hash_node(uint32_t node, std::uint64_t& h1, std::uint64_t& h2, unsigned depth) const;
+  void output_node(std::ostream& outs, uint32_t node) const;
+  static bool equal_nodes(const Rps_JsonZone*lz, uint32_t lnode, const Rps_JsonZone*rz, uint32_t rnode);
+  static int compare_nodes(const Rps_JsonZone*lz, uint32_t lnode, const Rps_JsonZone*rz, uint32_t rnode);
 protected:
-  inline Rps_JsonZone(const Json::Value&jv);
   virtual Rps_HashInt compute_hash(void) const;
   virtual Rps_ObjectRef compute_class(Rps_CallFrame*stkf) const;
   virtual void gc_mark(Rps_GarbageCollector&, unsigned) const { };
   virtual void dump_scan(Rps_Dumper*, unsigned) const {};
   virtual Json::Value dump_json(Rps_Dumper*) const;
 public:
-  const Json::Value& json() const { return _jsonval; };
-  const Json::Value const_json() const { return _jsonval; };
+  /// the root node is 0
+  jsonkind_en kind(uint32_t node=0) const
+  {
+    return (jsonkind_en)(_jstape[node] & 0xff);
+  };
+  /// number of elements or members of an array or object node
+  uint32_t size(uint32_t node=0) const;
+  int64_t int_at(uint32_t node=0) const;
+  double real_at(uint32_t node=0) const;
+  bool bool_at(uint32_t node=0) const;
+  std::string_view string_at(uint32_t node=0) const;
+  /// the node of the rank-th element of an array node, or -1
+  int element_node(uint32_t rank, uint32_t node=0) const;
+  /// the node of the member of an object node, or -1
+  int member_node(std::string_view key, uint32_t node=0) const;
+  /// the jsoncpp value, rebuilt once then kept
+  const Json::Value& json(void) const;
+  const Json::Value& const_json() const { return json(); };
+  /// rebuild the jsoncpp value of some node
+  Json::Value json_at(uint32_t node) const { return json_node(node); };
+  /// write compact JSON text, without jsoncpp; reals are written like
+  /// jsoncpp does, so 3.0 stays distinct from 3
+  void output_json(std::ostream& outs, uint32_t node=0) const { output_node(outs, node); };
   virtual uint32_t wordsize() const
   {
-    return (sizeof(*this)+sizeof(void*)-1)/sizeof(void*);
+    return (sizeof(*this) + _jstapelen*sizeof(uint64_t) + _jspoolsize
+            + sizeof(void*) - 1) / sizeof(void*);
   };
   virtual void val_output(std::ostream& outs, unsigned depth) const;
   virtual bool equal(const Rps_ZoneValue&zv) const;
@@ -3289,6 +3753,10 @@ public:
   {
     return "classinfo";
   };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   virtual uint32_t wordsize(void) const
   {
     return sizeof(*this)/sizeof(void*);
@@ -3309,10 +3777,12 @@ public:
   void put_superclass(Rps_ObjectRef obr)
   {
     pclass_super = obr;
+    touch_owner();
   };
   inline void clear_symbname(void)
   {
     pclass_symbname = nullptr;
+    touch_owner();
   };
   std::string class_name_str(void) const;
   void put_symbname(Rps_ObjectRef obr);
@@ -3335,11 +3805,13 @@ public:
   {
     if (obsel && clov && clov.is_closure())
       pclass_methdict.insert({obsel,clov});
+    touch_owner();
   };
   void remove_own_method(Rps_ObjectRef obsel)
   {
     if (obsel)
       pclass_methdict.erase(obsel);
+    touch_owner();
   };
 };				// end Rps_PayloadClassInfo
 
@@ -3376,6 +3848,10 @@ public:
   {
     return "setob";
   };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   inline Rps_PayloadSetOb(Rps_ObjectZone*obz, Rps_Loader*ld);
   bool contains(const Rps_ObjectZone* obelem) const
   {
@@ -3393,19 +3869,23 @@ public:
   {
     if (obelem)
       psetob.insert(Rps_ObjectRef(obelem));
+    touch_owner();
   };
   void add (const Rps_ObjectRef obrelem)
   {
     if (!obrelem.is_empty())
       psetob.insert(obrelem);
+    touch_owner();
   };
   void remove(const Rps_ObjectZone* obelem)
   {
     if (obelem) psetob.erase(Rps_ObjectRef(obelem));
+    touch_owner();
   };
   void remove (const Rps_ObjectRef obrelem)
   {
     if (obrelem) psetob.erase(obrelem);
+    touch_owner();
   };
   Rps_SetValue to_set() const
   {
@@ -3452,6 +3932,10 @@ public:
   {
     return "vectob";
   };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   virtual uint32_t wordsize(void) const
   {
     return (sizeof(*this)+sizeof(void*)-1)/sizeof(void*);
@@ -3481,11 +3965,13 @@ public:
   {
     if (obcomp)
       pvectob.push_back(Rps_ObjectRef(obcomp));
+    touch_owner();
   };
   void push_back (const Rps_ObjectRef obrcomp)
   {
     if (obrcomp)
       pvectob.push_back(obrcomp);
+    touch_owner();
   };
   Rps_TupleValue to_tuple() const
   {
@@ -3524,6 +4010,10 @@ public:
   {
     return "vectval";
   };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   virtual uint32_t wordsize(void) const
   {
     return (sizeof(*this)+sizeof(void*)-1)/sizeof(void*);
@@ -3553,11 +4043,13 @@ public:
   {
     if (val)
       pvectval.push_back(val);
+    touch_owner();
   };
   void push_back (const Rps_ObjectRef obrcomp)
   {
     if (obrcomp)
       pvectval.push_back(Rps_ObjectValue(obrcomp));
+    touch_owner();
   };
 #warning missing method to make a node from some Rps_PayloadVectVal
 };				// end Rps_PayloadVectVal
@@ -3592,15 +4084,21 @@ public:
   {
     return "string_buffer";
   };
-  std::ostringstream* output_string_stream(void) { return &strbuf_out; };
+  /// the writable streams are only asked for to write into them, so
+  /// the owner is touched when they are given
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
+  std::ostringstream* output_string_stream(void) { touch_owner(); return &strbuf_out; };
   const std::ostream& output_stream(void) const { return strbuf_out; };
-   std::ostream& writable_output_stream(void)  { return strbuf_out; };
+   std::ostream& writable_output_stream(void)  { touch_owner(); return strbuf_out; };
   int indentation(void) const { return strbuf_indent; };
-  void set_indentation(int ind=0) {  strbuf_indent = ind; };
-  void more_indentation(int delta) { strbuf_indent += delta; };
-  void less_indentation(int delta) { strbuf_indent -= delta; };
+  void set_indentation(int ind=0) {  strbuf_indent = ind; touch_owner(); };
+  void more_indentation(int delta) { strbuf_indent += delta; touch_owner(); };
+  void less_indentation(int delta) { strbuf_indent -= delta; touch_owner(); };
   bool is_transient(void) const { return strbuf_transient; };
-  void set_transient(bool fl=true) { strbuf_transient=fl; };
+  void set_transient(bool fl=true) { strbuf_transient=fl; touch_owner(); };
   virtual uint32_t wordsize(void) const
   {
     return (sizeof(*this)+sizeof(void*)-1)/sizeof(void*);
@@ -3653,6 +4151,10 @@ public:
   {
     return "string_dictionary";
   };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   static Rps_ObjectRef the_string_dictionary_class(void);
   Rps_Value find(const std::string&str) const;
   void add(const std::string&str, Rps_Value val);
@@ -3669,6 +4171,108 @@ private:
 }; // end class Rps_PayloadStringDict
 
 
+
+////////////////////////////////////////////////////////////////
+////// mutable secondary index payload - associate the values of
+////// a given attribute to the set of objects having them, for
+////// objects of class `attribute_index` _3vG1NkL6esh4351Thb
+extern "C" rpsldpysig_t rpsldpy_attribute_index;
+class Rps_PayloadAttrIndex : public Rps_Payload
+{
+  friend class Rps_ObjectRef;
+  friend class Rps_ObjectZone;
+  friend class Rps_GarbageCollector;
+  friend rpsldpysig_t rpsldpy_attribute_index;
+  friend Rps_PayloadAttrIndex*
+  Rps_QuasiZone::rps_allocate1<Rps_PayloadAttrIndex,Rps_ObjectZone*>(Rps_ObjectZone*);
+  Rps_PayloadAttrIndex(Rps_ObjectZone*owner);
+  Rps_PayloadAttrIndex(Rps_ObjectRef obr) :
+    Rps_PayloadAttrIndex(obr?obr.optr():nullptr) {};
+  virtual ~Rps_PayloadAttrIndex();
+  virtual uint32_t wordsize(void) const
+  {
+    return (sizeof(*this)+sizeof(void*)-1)/sizeof(void*);
+  };
+  /// a strict weak ordering on values, since Rps_Value::operator <
+  /// is not one when mixing integers and pointers
+  struct value_less
+  {
+    bool operator() (const Rps_Value lv, const Rps_Value rv) const
+    {
+      if (lv.is_empty())
+        return !rv.is_empty();
+      if (rv.is_empty())
+        return false;
+      if (lv.is_int())
+        return !rv.is_int() || lv.as_int() < rv.as_int();
+      if (rv.is_int())
+        return false;
+      if (!lv.is_ptr() || !rv.is_ptr()) // unboxed doubles or strings
+        return lv < rv;
+      return *lv.as_ptr() < *rv.as_ptr();
+    };
+  };
+  /// all the attribute indexes, by indexed attribute; their count is
+  /// atomic so that put_attr & co are not slowed down without indexes
+  static std::recursive_mutex attrix_regmtx;
+  static std::unordered_map<Rps_ObjectZone*,std::set<Rps_PayloadAttrIndex*>> attrix_registry;
+  static std::atomic<unsigned> attrix_count;
+  /// called by Rps_ObjectZone, with the owner's ob_mtx locked, after
+  /// the value of attribute obattr in obz became val (or nil if removed)
+  static void note_attribute_change(Rps_ObjectZone*obz, Rps_ObjectZone*obattr, Rps_Value val);
+  void reindex_owner(Rps_ObjectZone*obz, Rps_Value val);
+  void register_attribute(Rps_ObjectRef obattr);
+  /// called by the garbage collector between marking and sweeping
+  static void forget_unmarked_indexes(Rps_GarbageCollector&gc);
+protected:
+  virtual void gc_mark(Rps_GarbageCollector&gc) const;
+  virtual void dump_scan(Rps_Dumper*du) const;
+  virtual void dump_json_content(Rps_Dumper*, Json::Value&) const;
+public:
+  static bool has_attribute_indexes(void)
+  {
+    return attrix_count.load() > 0;
+  };
+  // Create an attribute index object for attribute obattr, filled
+  // with the current objects having that attribute, and throws an
+  // exception if obclass or obattr is wrong:
+  static Rps_ObjectRef make_attribute_index_object(Rps_CallFrame*callframe, Rps_ObjectRef obattr, Rps_ObjectRef obclass=nullptr, Rps_ObjectRef obspace=nullptr);
+  virtual const std::string payload_type_name(void) const
+  {
+    return "attribute_index";
+  };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
+  static Rps_ObjectRef the_attribute_index_class(void);
+  Rps_ObjectRef indexed_attribute(void) const
+  {
+    return attrix_attr;
+  };
+  unsigned nb_keys(void) const;
+  unsigned nb_owners(void) const;
+  /// the set of objects whose indexed attribute is equal to val
+  Rps_SetValue find_equal(const Rps_Value val) const;
+  unsigned count_equal(const Rps_Value val) const;
+  /// the set of objects whose indexed attribute is between lo and hi,
+  /// inclusively; an empty lo or hi means no such bound
+  Rps_SetValue find_range(const Rps_Value lo, const Rps_Value hi) const;
+  /// iterate in increasing value order over the keys between lo and
+  /// hi, till stopfun returns true
+  void iterate_range(const Rps_Value lo, const Rps_Value hi,
+                     const std::function<bool(const Rps_Value,const std::set<Rps_ObjectRef>&)>& stopfun) const;
+private:
+  Rps_ObjectRef attrix_attr;
+  mutable std::recursive_mutex attrix_mtx;
+  std::unordered_map<Rps_Value,std::set<Rps_ObjectRef>> attrix_hashmap;
+  std::set<Rps_Value,value_less> attrix_sortedkeys;
+  /// the reverse map gives the current key of every indexed owner, so
+  /// that removing it never needs the owner's attributes
+  std::unordered_map<Rps_ObjectZone*,Rps_Value> attrix_ownermap;
+}; // end class Rps_PayloadAttrIndex
+
+
 ////////////////////////////////////////////////////////////////
 ////// mutable space payload, objects of class `space`
 ////// _2i66FFjmS7n03HNNBx
@@ -3684,9 +4288,7 @@ protected:
   inline Rps_PayloadSpace(Rps_ObjectZone*owner);
   Rps_PayloadSpace(Rps_ObjectRef obr) :
     Rps_PayloadSpace(obr?obr.optr():nullptr) {};
-  virtual ~Rps_PayloadSpace()
-  {
-  };
+  virtual ~Rps_PayloadSpace();
   virtual uint32_t wordsize(void) const
   {
     return (sizeof(*this)+sizeof(void*)-1)/sizeof(void*);
@@ -3699,11 +4301,59 @@ protected:
     return false;
   };
 public:
+  /// Live accounting of the objects inside each space. The object
+  /// count is exact, kept by Rps_ObjectZone::store_space and the
+  /// object destructor. The words and bytes are also moved there, but
+  /// since attributes, components and payloads change without telling
+  /// their space, they are only exact after a garbage collection,
+  /// whose sweep recomputes all the counters.
+  struct space_counters
+  {
+    int64_t spc_nbobjects;	// number of objects
+    int64_t spc_attrwords;	// words in attributes, two per attribute
+    int64_t spc_compwords;	// words in components
+    int64_t spc_paylbytes;	// bytes in payloads
+  };
+  static space_counters counters_of_space(Rps_ObjectRef obspace);
+  static std::map<Rps_ObjectRef,space_counters> all_space_counters(void);
+  static Json::Value json_space_counters(Rps_ObjectRef obspace);
+  /// What was known of a space when it was last loaded from or dumped
+  /// into some directory, used by the incremental dump to skip the
+  /// space files which would be rewritten unchanged: the sorted oids
+  /// of its objects and the wallclock time of that load or dump. Every
+  /// mutation of an object touches its mtime, so the space is
+  /// unchanged if its membership is the same and none of its objects,
+  /// or of the objects they refer to, have a later mtime.
+  struct space_dump_record
+  {
+    std::string sdr_dir;	// the real path of the directory
+    double sdr_time;		// wallclock time of the load or dump
+    std::vector<Rps_Id> sdr_members; // sorted oids of member objects
+  };
+  static bool dump_record_of_space(Rps_ObjectRef obspace, space_dump_record&sdr);
+  static void put_dump_record(Rps_ObjectRef obspace, const space_dump_record&sdr);
   virtual const std::string payload_type_name(void) const
   {
     return "space";
   };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   inline Rps_PayloadSpace(Rps_ObjectZone*obz, Rps_Loader*ld);
+private:
+  friend class Rps_GarbageCollector;
+  static std::recursive_mutex space_countmtx;
+  static std::unordered_map<Rps_ObjectZone*,space_counters> space_countmap;
+  /// add (if sign>0) or remove (if sign<0) the footprint of obz
+  static void add_footprint(space_counters&sc, Rps_ObjectZone*obz, int sign);
+  /// move obz from oldspace to newspace, either could be null
+  static void account_object(Rps_ObjectZone*obz, Rps_ObjectZone*oldspace, Rps_ObjectZone*newspace);
+  /// called at end of the garbage collection sweep, with the
+  /// counters recomputed from the surviving objects
+  static void replace_counters_after_gc(std::unordered_map<Rps_ObjectZone*,space_counters>&newmap);
+  static std::recursive_mutex space_dumpmtx;
+  static std::unordered_map<Rps_ObjectZone*,space_dump_record> space_dumpmap;
 };				// end Rps_PayloadSpace
 
 
@@ -3746,6 +4396,10 @@ public:
   {
     return "symbol";
   };
+  virtual bool touches_owner_on_mutation(void) const
+  {
+    return true;
+  };
   static void gc_mark_strong_symbols(Rps_GarbageCollector*gc);
   void load_register_name(const char*name, Rps_Loader*ld,bool weak=false);
   void load_register_name(const std::string& str, Rps_Loader*ld, bool weak=false)
@@ -3763,6 +4417,7 @@ public:
   void set_weak(bool f)
   {
     symb_is_weak.store(f);
+    touch_owner();
   };
   Rps_Value symbol_value(void) const
   {
@@ -3771,6 +4426,7 @@ public:
   void symbol_put_value(Rps_Value v)
   {
     symb_data.store(v.data_for_symbol(this));
+    touch_owner();
   };
   const std::string& symbol_name(void) const
   {
@@ -3818,6 +4474,14 @@ public:
 
 #define RPS_MANIFEST_JSON "rps_manifest.json"
 
+// the optional binary snapshot, written with the manifest by
+// --binary-snapshot and used when loading while still valid
+#define RPS_SNAPSHOT_BIN "rps_snapshot.bin"
+
+// the optional write-ahead journal of objects mutated since the last
+// dump, appended with --journal and replayed by the next load
+#define RPS_JOURNAL_FILE "rps_journal.txt"
+
 // the user manifest is optional, in the rps_homedir()
 // so using $REFPERSYS_HOME or $HOME
 #define RPS_USER_MANIFEST_JSON ".refpersys.json" 
@@ -3917,11 +4581,22 @@ extern "C" bool rps_is_dumpable_objref(Rps_Dumper*, const Rps_ObjectRef obr);
 // is an object dumpable as attribute in another object?
 extern "C" bool rps_is_dumpable_objattr(Rps_Dumper*, const Rps_ObjectRef obr);
 
+// was an object reached by the scan of the dump? for weak references
+extern "C" bool rps_is_scanned_objref(Rps_Dumper*, const Rps_ObjectRef obr);
+
 // is a value dumpable?
 extern "C" bool rps_is_dumpable_value(Rps_Dumper*, const Rps_Value val);
 
 
 extern "C" void rps_load_from (const std::string& dirpath); // in store_rps.cc
+
+// the write-ahead journal, in store_rps.cc
+extern "C" std::atomic<bool> rps_journal_active;
+extern "C" void rps_journal_note_mutation(Rps_ObjectZone*obz);
+extern "C" void rps_journal_start(const std::string& dirpath);
+extern "C" void rps_journal_stop(void);
+extern "C" void rps_journal_after_dump(const std::string& dirpath, double dumpstarttime);
+extern "C" void rps_journal_gc_mark(Rps_GarbageCollector*gc);
  
 extern "C" void rps_load_add_todo(Rps_Loader*,const std::function<void(Rps_Loader*)>& todofun);
 
@@ -4018,6 +4693,7 @@ public:
     WthrAg_EndGC, // the worker thread has ended garbage collection,
 		  // and will be running again on the next loop
     WthrAg_Run,	 // the worker thread is running and allocating
+    WthrAg_Paused, // the worker thread is paused between two tasklets
     WthrAg__Last
   };
   static const char* agenda_priority_names[AgPrio__Last];
@@ -4029,6 +4705,22 @@ public:
   static Rps_ObjectRef fetch_tasklet_to_run(void);
   static void run_agenda_worker(int ix);
   static void do_garbage_collect(int ix, Rps_CallFrame*callframe);
+  /// pause the worker threads, but the calling one, between two
+  /// tasklets, and wait till they are all paused; e.g. for the brief
+  /// consistent phase of a dump
+  static void pause_workers(void);
+  static void resume_workers(void);
+  /// while deferred, worker threads don't start any garbage
+  /// collection, so objects are not freed; deferring waits for the
+  /// end of a garbage collection already started
+  static void defer_garbage_collection(void);
+  static void allow_garbage_collection(void);
+  /// the index of the calling worker thread, or 0
+  static int current_worker_index(void);
+  static bool is_running(void)
+  {
+    return agenda_is_running_.load();
+  };
 protected:
   static void dump_scan_agenda(Rps_Dumper*du);
   static void dump_json_agenda(Rps_Dumper*du, Json::Value&jv);
@@ -4039,6 +4731,9 @@ private:
   static std::deque<Rps_ObjectRef> agenda_fifo_[AgPrio__Last];
   static std::atomic<bool> agenda_is_running_; // true when agenda is running
   static std::atomic<bool> agenda_needs_garbcoll_; // true when GC is needed
+  static std::atomic<bool> agenda_pause_requested_; // true to pause workers
+  static std::atomic<int> agenda_gcdefer_count_; // positive to defer GC
+  static bool some_worker_collects_garbage(void);
   /// the cumulated amount of allocated words at previous GC is:
   static std::atomic<uint64_t> agenda_cumulw_gc_;
   // once a megaword has been allocated, we want to garbage collect, hence:
@@ -4073,6 +4768,8 @@ protected:
   virtual bool is_erasable(void) const;
 public:
   virtual const std::string payload_type_name(void) const { return "agenda"; };
+  /// Rps_Agenda touches the_agenda when adding or fetching a tasklet
+  virtual bool touches_owner_on_mutation(void) const { return true; };
 };  // end of Rps_PayloadAgenda
 
 
@@ -4104,6 +4801,8 @@ protected:
   virtual bool is_erasable(void) const;
 public:
   virtual const std::string payload_type_name(void) const { return "tasklet"; };
+  /// a tasklet is only filled by its loader
+  virtual bool touches_owner_on_mutation(void) const { return true; };
   Rps_ClosureValue todo_closure(void) const { return tasklet_todoclos; };
 };  // end of Rps_PayloadTasklet
 
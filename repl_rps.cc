@@ -1694,7 +1694,7 @@ Rps_LexTokenZone::tokenize(Rps_CallFrame*callframe, std::istream*inp,
           Rps_QuasiZone::rps_allocate5<Rps_LexTokenZone,Rps_ObjectRef,Rps_Value,const Rps_String*,int,int>
           (_f.lexkindob,
            _f.lextokv,
-           Rps_StringValue(input_name).as_string(),
+           Rps_String::make(input_name),
            startline,
            startcol);
         _f.resv = Rps_LexTokenValue(lextok);
@@ -31,6 +31,10 @@
 
 #include "refpersys.hh"
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif /*__x86_64__*/
+
 extern "C" const char rps_scalar_gitid[];
 const char rps_scalar_gitid[]= RPS_GITID;
 
@@ -38,7 +42,9 @@ extern "C" const char rps_scalar_date[];
 const char rps_scalar_date[]= __DATE__;
 
 
-int rps_compute_cstr_two_64bits_hash(int64_t ht[2], const char*cstr, int len)
+/// the first string hash, decoding UTF-8 characters, used till
+/// string hash version 1; kept for comparison and migration.
+int rps_compute_cstr_two_64bits_hash_v1(int64_t ht[2], const char*cstr, int len)
 {
   if (!ht || !cstr)
     return 0;
@@ -90,18 +96,305 @@ int rps_compute_cstr_two_64bits_hash(int64_t ht[2], const char*cstr, int len)
   ht[0] = h0;
   ht[1] = h1;
   return utf8cnt;
+} // end of rps_compute_cstr_two_64bits_hash_v1
+
+
+/// multiply to 128 bits then fold, a good and cheap 64 bits mixer
+static inline uint64_t
+rps_hash_fold_mul(uint64_t a, uint64_t b)
+{
+  __uint128_t p = (__uint128_t)a * b;
+  return (uint64_t)p ^ (uint64_t)(p >> 64);
+} // end rps_hash_fold_mul
+
+static inline uint64_t
+rps_hash_read64(const unsigned char*pc)
+{
+  uint64_t w = 0;
+  memcpy(&w, pc, sizeof(w));
+  return le64toh(w);
+} // end rps_hash_read64
+
+/// the current string hash, version RPS_STRING_HASH_VERSION: it
+/// processes 16 bytes per step in two lanes, without decoding UTF-8,
+/// since Rps_String::make has already checked it.
+int rps_compute_cstr_two_64bits_hash(int64_t ht[2], const char*cstr, int len)
+{
+  if (!ht || !cstr)
+    return 0;
+  if (len < 0)
+    len = strlen(cstr);
+  ht[0] = 0;
+  ht[1] = 0;
+  if (len == 0)
+    return 0;
+  constexpr uint64_t k0 = UINT64_C(0xa0761d6478bd642f);
+  constexpr uint64_t k1 = UINT64_C(0xe7037ed1a0b428db);
+  constexpr uint64_t k2 = UINT64_C(0x8ebc6af09c88c6e3);
+  constexpr uint64_t k3 = UINT64_C(0x589965cc75374cc3);
+  const unsigned char*pc = reinterpret_cast<const unsigned char*>(cstr);
+  size_t rem = (size_t)len;
+  uint64_t h0 = k0 ^ rem;
+  uint64_t h1 = k1 + rem;
+  while (rem > 16)
+    {
+      uint64_t a = rps_hash_read64(pc);
+      uint64_t b = rps_hash_read64(pc+8);
+      h0 = rps_hash_fold_mul(a ^ k2, b ^ h0);
+      h1 = rps_hash_fold_mul(b ^ k3, a ^ h1);
+      pc += 16;
+      rem -= 16;
+    }
+  /// the last 1 to 16 bytes
+  uint64_t a = 0, b = 0;
+  if (rem >= 8)
+    {
+      a = rps_hash_read64(pc);
+      if (rem > 8)
+        b = rps_hash_read64(pc + rem - 8) >> (8 * (16 - rem));
+    }
+  else
+    {
+      for (size_t ix = 0; ix < rem; ix++)
+        a |= (uint64_t)pc[ix] << (8 * ix);
+    }
+  h0 = rps_hash_fold_mul(a ^ k2, b ^ h0);
+  h1 = rps_hash_fold_mul(b ^ k3, a ^ h1);
+  ht[0] = (int64_t) rps_hash_fold_mul(h0 ^ k0, h1 ^ (uint64_t)len);
+  ht[1] = (int64_t) rps_hash_fold_mul(h1 ^ k1, h0 ^ k2);
+  return len;
 } // end of rps_compute_cstr_two_64bits_hash
 
 
+////////////////////////////////////////////////////////////////
+//// UTF-8 checking and counting. Strings and space files are mostly
+//// ASCII, so the ASCII runs are skipped by blocks of 32 bytes with
+//// AVX2 (when the processor has it) or of 16 bytes with SSE2, and
+//// the other bytes are decoded one sequence at a time with the same
+//// rules as u8_check: no overlong forms, no surrogates, nothing
+//// above U+10FFFF.
+
+#if defined(__x86_64__)
+static bool rps_utf8_have_avx2 = __builtin_cpu_supports("avx2");
+
+__attribute__((target("avx2")))
+static size_t
+rps_utf8_ascii_prefix_avx2(const unsigned char*pc, size_t len)
+{
+  size_t ix = 0;
+  for (; ix + 32 <= len; ix += 32)
+    {
+      __m256i blk = _mm256_loadu_si256((const __m256i*)(pc+ix));
+      unsigned msk = (unsigned) _mm256_movemask_epi8(blk);
+      if (msk)
+        return ix + __builtin_ctz(msk);
+    }
+  return ix;
+} // end rps_utf8_ascii_prefix_avx2
+#endif /*__x86_64__*/
+
+/// return the number of leading ASCII bytes at pc
+static inline size_t
+rps_utf8_ascii_prefix(const unsigned char*pc, size_t len)
+{
+  size_t ix = 0;
+#if defined(__x86_64__)
+  if (len >= 64 && rps_utf8_have_avx2)
+    {
+      ix = rps_utf8_ascii_prefix_avx2(pc, len);
+      if (ix + 32 <= len)
+        return ix;
+    }
+  for (; ix + 16 <= len; ix += 16)
+    {
+      __m128i blk = _mm_loadu_si128((const __m128i*)(pc+ix));
+      unsigned msk = (unsigned) _mm_movemask_epi8(blk);
+      if (msk)
+        return ix + __builtin_ctz(msk);
+    }
+#else
+  for (; ix + 8 <= len; ix += 8)
+    {
+      uint64_t w = 0;
+      memcpy(&w, pc+ix, 8);
+      if (w & UINT64_C(0x8080808080808080))
+        break;
+    }
+#endif /*__x86_64__*/
+  while (ix < len && pc[ix] < 0x80)
+    ix++;
+  return ix;
+} // end rps_utf8_ascii_prefix
+
+/// return the length of the non-ASCII UTF-8 sequence at pc, or 0 if invalid
+static inline int
+rps_utf8_sequence_length(const unsigned char*pc, const unsigned char*end)
+{
+  unsigned c = pc[0];
+  if (c < 0xC2)
+    return 0;
+  if (c < 0xE0)
+    {
+      if (end - pc < 2 || (pc[1] & 0xC0) != 0x80)
+        return 0;
+      return 2;
+    }
+  if (c < 0xF0)
+    {
+      if (end - pc < 3 || (pc[1] & 0xC0) != 0x80 || (pc[2] & 0xC0) != 0x80)
+        return 0;
+      if (c == 0xE0 && pc[1] < 0xA0) // overlong
+        return 0;
+      if (c == 0xED && pc[1] >= 0xA0) // surrogate
+        return 0;
+      return 3;
+    }
+  if (c < 0xF5)
+    {
+      if (end - pc < 4 || (pc[1] & 0xC0) != 0x80
+          || (pc[2] & 0xC0) != 0x80 || (pc[3] & 0xC0) != 0x80)
+        return 0;
+      if (c == 0xF0 && pc[1] < 0x90) // overlong
+        return 0;
+      if (c == 0xF4 && pc[1] >= 0x90) // above U+10FFFF
+        return 0;
+      return 4;
+    }
+  return 0;
+} // end rps_utf8_sequence_length
+
+const char*
+rps_utf8_check_count(const char*str, size_t len, uint32_t*pcount)
+{
+  if (RPS_UNLIKELY(!str))
+    len = 0;
+  const unsigned char*pc = reinterpret_cast<const unsigned char*>(str);
+  const unsigned char*end = pc + len;
+  size_t cnt = 0;
+  while (pc < end)
+    {
+      size_t nbascii = rps_utf8_ascii_prefix(pc, end - pc);
+      pc += nbascii;
+      cnt += nbascii;
+      while (pc < end && *pc >= 0x80)
+        {
+          int l = rps_utf8_sequence_length(pc, end);
+          if (RPS_UNLIKELY(l == 0))
+            {
+              if (pcount)
+                *pcount = (uint32_t)cnt;
+              return reinterpret_cast<const char*>(pc);
+            }
+          pc += l;
+          cnt++;
+        }
+    }
+  if (pcount)
+    *pcount = (uint32_t)cnt;
+  return nullptr;
+} // end rps_utf8_check_count
+
+/// Compare rps_utf8_check_count with u8_check and u8_mbsnlen of
+/// libunistring on valid, invalid and boundary inputs, at every
+/// offset around the SSE2 and AVX2 block sizes. Used by the
+/// --test-utf8 program option and the test-utf8 make target; return
+/// the number of mismatches.
+int
+rps_utf8_check_count_test(void)
+{
+  int nbmismatch = 0;
+  long nbchecked = 0;
+  auto check = [&](const std::string&s, const char*what)
+  {
+    const char*str = s.data();
+    size_t len = s.size();
+    uint32_t cnt = 0;
+    const char*fastbad = rps_utf8_check_count(str, len, &cnt);
+    const char*refbad =
+      (const char*) u8_check((const uint8_t*)str, len);
+    nbchecked++;
+    if (fastbad != refbad)
+      {
+        nbmismatch++;
+        RPS_WARNOUT("rps_utf8_check_count_test " << what << " len=" << len
+                    << " fast bad@" << (fastbad?(long)(fastbad-str):-1L)
+                    << " libunistring bad@" << (refbad?(long)(refbad-str):-1L));
+        return;
+      }
+    if (!refbad && cnt != (uint32_t) u8_mbsnlen((const uint8_t*)str, len))
+      {
+        nbmismatch++;
+        RPS_WARNOUT("rps_utf8_check_count_test " << what << " len=" << len
+                    << " fast count=" << cnt << " libunistring count="
+                    << u8_mbsnlen((const uint8_t*)str, len));
+      }
+  };
+  // boundary and invalid sequences, each of them put at every offset
+  // of an ASCII run long enough to use the AVX2 and SSE2 blocks
+  static const char*const samples[] =
+  {
+    "", "a", "\x7F",
+    "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xEF\xBF\xBF",
+    "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",
+    "\xC3\xA9t\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+    // invalid: lone continuations, overlong forms, surrogates,
+    // above U+10FFFF, bytes never used in UTF-8, truncations
+    "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF",
+    "\xED\xA0\x80", "\xED\xBF\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+    "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80",
+    "\xFE", "\xFF", "\xC2", "\xE2\x82", "\xF0\x9F\x98", "\xC2\x41",
+    "\xE2\x28\xA1", "\xF0\x9F\x28\x80",
+  };
+  for (const char*sample : samples)
+    {
+      check(std::string(sample), "sample");
+      for (int pre = 0; pre <= 80; pre++)
+        for (int post : {0, 1, 15, 16, 17, 31, 32, 33, 64})
+          {
+            std::string s(pre, 'x');
+            s += sample;
+            s.append(post, 'y');
+            check(s, "padded sample");
+          }
+    }
+  // random strings, mostly ASCII, mostly valid but not always
+  std::mt19937 rng(31415926);
+  static const char*const pieces[] =
+  {
+    "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF",
+    "\xEE\x80\x80", "\xF4\x8F\xBF\xBF", "\x80", "\xC0\xAF", "\xED\xA0\x80",
+  };
+  for (int iter = 0; iter < 20000; iter++)
+    {
+      std::string s;
+      int len = rng() % 300;
+      bool valid = iter % 2 == 0;
+      while ((int)s.size() < len)
+        {
+          unsigned r = rng() % 100;
+          if (r < 85)
+            s += (char)(' ' + rng() % 95);
+          else
+            s += pieces[rng() % (valid ? 6 : 9)];
+        }
+      check(s, valid?"random valid":"random");
+    }
+  RPS_INFORMOUT("rps_utf8_check_count_test checked " << nbchecked
+                << " strings, " << nbmismatch << " mismatches");
+  return nbmismatch;
+} // end rps_utf8_check_count_test
+
+
 const Rps_String*
 Rps_String::make(const char*cstr, int len)
 {
   cstr = normalize_cstr(cstr);
   len = normalize_len(cstr, len);
-  if (u8_check(reinterpret_cast<const uint8_t*>(cstr), len))
+  uint32_t utf8len = 0;
+  if (rps_utf8_check_count(cstr, len, &utf8len))
     throw std::domain_error("invalid UTF-8 string");
   Rps_String* str
-    = rps_allocate_with_wordgap<Rps_String> (len/sizeof(void*)+1, cstr, len);
+    = rps_allocate_with_wordgap<Rps_String> (len/sizeof(void*)+1, cstr, len, utf8len);
   return str;
 } // end of Rps_String::make
 
@@ -110,15 +403,22 @@ Json::Value
 Rps_String::dump_json(Rps_Dumper*du) const
 {
   RPS_ASSERT(du != nullptr);
-  if (cstr()[0] == '_')
+  return dump_json_cstr(cstr());
+} // end Rps_String::dump_json
+
+// strings starting with an underscore could be mistaken for oids
+Json::Value
+Rps_String::dump_json_cstr(const char*cstr)
+{
+  if (cstr[0] == '_')
     {
       Json::Value vmap(Json::objectValue);
-      vmap["str"] = cstr();
+      vmap["str"] = cstr;
       return vmap;
     }
   else
-    return Json::Value(cstr());
-} // end Rps_String::dump_json
+    return Json::Value(cstr);
+} // end Rps_String::dump_json_cstr
 
 void
 Rps_String::val_output(std::ostream&out, unsigned) const
@@ -47,16 +47,21 @@ const char rps_store_date[]= __DATE__;
 #define RPS_MANIFEST_FORMAT "RefPerSysFormat2019A"
 
 Json::Value rps_string_to_json(const std::string&str)
+{
+  return rps_string_view_to_json(std::string_view(str));
+} // end rps_string_to_json
+
+Json::Value rps_string_view_to_json(std::string_view strv)
 {
   Json::CharReaderBuilder jsonreaderbuilder;
   std::unique_ptr<Json::CharReader> pjsonreader(jsonreaderbuilder.newCharReader());
   Json::Value jv;
   JSONCPP_STRING errstr;
   RPS_ASSERT(pjsonreader);
-  if (!pjsonreader->parse(str.c_str(), str.c_str() + str.size(), &jv, &errstr))
+  if (!pjsonreader->parse(strv.data(), strv.data() + strv.size(), &jv, &errstr))
     throw std::runtime_error(std::string("JSON parsing error:") + errstr);
   return jv;
-} // end rps_string_to_json
+} // end rps_string_view_to_json
 
 
 std::string
@@ -69,6 +74,797 @@ rps_json_to_string(const Json::Value&jv)
   return str;
 } // end rps_json_to_string
 
+//////////////////////////////////////////////// loader JSON tape
+/// The loader does not build a jsoncpp DOM for every object chunk:
+/// the chunk text, which stays in the memory mapped space file, is
+/// parsed in place into a flat tape of 64 bits words, and the
+/// loader builds values, attributes and components directly from
+/// it. Each loading thread reuses its own tape from one chunk to the
+/// next, so parsing an object does not allocate in the steady state.
+///
+/// Every node starts with a header word, whose low byte is the kind
+/// and whose higher bits are the length of a string or the number
+/// of elements of an array or members of an object:
+///    null, false, true: the header word only
+///    int, real: the header then the int64 or double bits
+///    string: the header then the offset of its bytes, in the
+///            chunk text or, if it had escapes, in the unescaped
+///            buffer when the ljt_unescapedbit is set
+///    array, object: the header then the index of the next node,
+///            then the elements or the key string and value nodes
+/// The JSON accepted is what jsoncpp accepts with its default
+/// settings for our space files, including // and /* */ comments.
+class Rps_LoaderJsonTape
+{
+public:
+  enum kind_en : std::uint8_t
+  {
+    ljk_null, ljk_false, ljk_true, ljk_int, ljk_real, ljk_string, ljk_array, ljk_object
+  };
+  /// absent members are reported as that node, since the root
+  /// node is never a member value
+  static constexpr unsigned ljt_nonode = 0;
+private:
+  static constexpr std::uint64_t ljt_unescapedbit = (std::uint64_t)1 << 63;
+  static constexpr unsigned ljt_maxdepth = 1024;
+  std::string_view ljt_text;
+  std::vector<std::uint64_t> ljt_tape;
+  std::string ljt_unescaped;
+  /// the words used by the accessors: those of ljt_tape after
+  /// parsing, or some external ones for a view
+  const std::uint64_t* ljt_words;
+  size_t ljt_nbwords;
+  const char* ljt_cur;
+  const char* ljt_end;
+  [[noreturn]] void fail(const char*msg) const;
+  void skip_blanks(void);
+  void parse_value(unsigned depth);
+  void parse_string(void);
+  void parse_number(void);
+  void parse_literal(const char*lit, kind_en kind);
+  void put_utf8(std::uint32_t codepoint);
+  std::uint32_t parse_hex4(void);
+public:
+  Rps_LoaderJsonTape() : ljt_text(), ljt_tape(), ljt_unescaped(),
+    ljt_words(nullptr), ljt_nbwords(0), ljt_cur(nullptr), ljt_end(nullptr)
+  {
+    ljt_tape.reserve(1024);
+    ljt_unescaped.reserve(256);
+  };
+  /// parse the text into the tape, whose root node is 0; the text
+  /// should stay alive while the tape is used; throws a
+  /// std::runtime_error on syntax errors
+  void parse(std::string_view text);
+  /// view already parsed words, e.g. in a mapped binary snapshot,
+  /// whose string offsets are all in the given strings
+  void view(const std::uint64_t*words, size_t nbwords, std::string_view strings)
+  {
+    RPS_ASSERT(words != nullptr && nbwords > 0);
+    ljt_text = strings;
+    ljt_words = words;
+    ljt_nbwords = nbwords;
+  };
+  size_t nb_words(void) const
+  {
+    return ljt_nbwords;
+  };
+  /// append the words to outvec, with every string moved by the
+  /// intern function, giving its offset in some other strings
+  void relocate_strings(std::vector<std::uint64_t>& outvec,
+                        const std::function<std::uint64_t(std::string_view)>& internfun) const;
+  kind_en kind(unsigned node) const
+  {
+    RPS_ASSERT(node < ljt_nbwords);
+    return (kind_en)(ljt_words[node] & 0xff);
+  };
+  /// the length of a string, or the number of elements or members
+  unsigned count(unsigned node) const
+  {
+    RPS_ASSERT(node < ljt_nbwords);
+    return (unsigned)(ljt_words[node] >> 8);
+  };
+  /// the node following that one and all its sons
+  unsigned next(unsigned node) const
+  {
+    switch (kind(node))
+      {
+      case ljk_null:
+      case ljk_false:
+      case ljk_true:
+        return node+1;
+      case ljk_int:
+      case ljk_real:
+      case ljk_string:
+        return node+2;
+      case ljk_array:
+      case ljk_object:
+        return (unsigned)ljt_words[node+1];
+      };
+    RPS_FATALOUT("Rps_LoaderJsonTape::next corrupted node#" << node);
+  };
+  /// the first element of an array, or the key of the first member
+  unsigned first(unsigned node) const
+  {
+    RPS_ASSERT(kind(node) == ljk_array || kind(node) == ljk_object);
+    return node+2;
+  };
+  bool is_number(unsigned node) const
+  {
+    return kind(node) == ljk_int || kind(node) == ljk_real;
+  };
+  std::int64_t int_at(unsigned node) const
+  {
+    RPS_ASSERT(kind(node) == ljk_int);
+    return (std::int64_t)ljt_words[node+1];
+  };
+  double real_at(unsigned node) const
+  {
+    if (kind(node) == ljk_int)
+      return (double)int_at(node);
+    RPS_ASSERT(kind(node) == ljk_real);
+    double d = 0.0;
+    memcpy(&d, &ljt_words[node+1], sizeof(d));
+    return d;
+  };
+  std::string_view string_at(unsigned node) const
+  {
+    RPS_ASSERT(kind(node) == ljk_string);
+    std::uint64_t off = ljt_words[node+1];
+    if (off & ljt_unescapedbit)
+      return std::string_view(ljt_unescaped.data() + (off & ~ljt_unescapedbit), count(node));
+    return ljt_text.substr(off, count(node));
+  };
+  /// the value node of the member of that key, or ljt_nonode
+  unsigned member(unsigned objnode, std::string_view key) const
+  {
+    RPS_ASSERT(kind(objnode) == ljk_object);
+    unsigned nbmemb = count(objnode);
+    unsigned curnode = first(objnode);
+    for (unsigned mix=0; mix<nbmemb; mix++)
+      {
+        unsigned valnode = curnode+2;
+        if (string_at(curnode) == key)
+          return valnode;
+        curnode = next(valnode);
+      }
+    return ljt_nonode;
+  };
+  /// build a jsoncpp value, for payload loaders and rare values; the
+  /// members of that skipped key, if any, are not converted
+  Json::Value to_json(unsigned node, std::string_view skippedkey1="", std::string_view skippedkey2="") const;
+};				// end class Rps_LoaderJsonTape
+
+
+void
+Rps_LoaderJsonTape::fail(const char*msg) const
+{
+  RPS_ASSERT(msg != nullptr);
+  size_t off = ljt_cur - ljt_text.data();
+  unsigned linecount = 1 + std::count(ljt_text.begin(), ljt_text.begin()+off, '\n');
+  char errbuf[128];
+  memset (errbuf, 0, sizeof(errbuf));
+  snprintf(errbuf, sizeof(errbuf), "JSON parsing error: %s at line %u offset %zd",
+           msg, linecount, off);
+  throw std::runtime_error(std::string(errbuf));
+} // end Rps_LoaderJsonTape::fail
+
+
+void
+Rps_LoaderJsonTape::skip_blanks(void)
+{
+  while (ljt_cur < ljt_end)
+    {
+      char c = *ljt_cur;
+      if (c == ' ' || c == '\n' || c == '\t' || c == '\r')
+        ljt_cur++;
+      else if (c == '/' && ljt_cur+1 < ljt_end && ljt_cur[1] == '/')
+        {
+          const char*eol = (const char*) memchr(ljt_cur, '\n', ljt_end - ljt_cur);
+          ljt_cur = eol ? eol+1 : ljt_end;
+        }
+      else if (c == '/' && ljt_cur+1 < ljt_end && ljt_cur[1] == '*')
+        {
+          const char*eoc = (const char*) memmem(ljt_cur+2, ljt_end - (ljt_cur+2), "*/", 2);
+          if (!eoc)
+            fail("unterminated comment");
+          ljt_cur = eoc+2;
+        }
+      else
+        break;
+    }
+} // end Rps_LoaderJsonTape::skip_blanks
+
+
+void
+Rps_LoaderJsonTape::parse(std::string_view text)
+{
+  ljt_text = text;
+  ljt_words = nullptr;
+  ljt_nbwords = 0;
+  ljt_tape.clear();
+  ljt_unescaped.clear();
+  ljt_cur = text.data();
+  ljt_end = text.data() + text.size();
+  skip_blanks();
+  parse_value(0);
+  skip_blanks();
+  if (ljt_cur < ljt_end)
+    fail("extra characters after value");
+  ljt_words = ljt_tape.data();
+  ljt_nbwords = ljt_tape.size();
+} // end Rps_LoaderJsonTape::parse
+
+
+void
+Rps_LoaderJsonTape::relocate_strings(std::vector<std::uint64_t>& outvec,
+                                     const std::function<std::uint64_t(std::string_view)>& internfun) const
+{
+  size_t startix = outvec.size();
+  outvec.insert(outvec.end(), ljt_words, ljt_words + ljt_nbwords);
+  // sons follow their array or object, so a linear walk sees every node
+  unsigned node = 0;
+  while (node < ljt_nbwords)
+    {
+      switch (kind(node))
+        {
+        case ljk_string:
+          outvec[startix+node+1] = internfun(string_at(node));
+          node += 2;
+          break;
+        case ljk_int:
+        case ljk_real:
+        case ljk_array:
+        case ljk_object:
+          node += 2;
+          break;
+        default:
+          node++;
+          break;
+        }
+    }
+} // end Rps_LoaderJsonTape::relocate_strings
+
+
+void
+Rps_LoaderJsonTape::parse_value(unsigned depth)
+{
+  if (depth > ljt_maxdepth)
+    fail("too deeply nested");
+  if (ljt_cur >= ljt_end)
+    fail("missing value");
+  switch (*ljt_cur)
+    {
+    case '{':
+    case '[':
+    {
+      bool isobj = (*ljt_cur == '{');
+      char closec = isobj ? '}' : ']';
+      unsigned node = ljt_tape.size();
+      ljt_tape.push_back(0);
+      ljt_tape.push_back(0);
+      std::uint64_t nbsons = 0;
+      ljt_cur++;
+      skip_blanks();
+      if (ljt_cur < ljt_end && *ljt_cur == closec)
+        ljt_cur++;
+      else
+        for (;;)
+          {
+            if (isobj)
+              {
+                if (ljt_cur >= ljt_end || *ljt_cur != '"')
+                  fail("expecting member name");
+                parse_string();
+                skip_blanks();
+                if (ljt_cur >= ljt_end || *ljt_cur != ':')
+                  fail("expecting colon");
+                ljt_cur++;
+                skip_blanks();
+              }
+            parse_value(depth+1);
+            nbsons++;
+            skip_blanks();
+            if (ljt_cur < ljt_end && *ljt_cur == ',')
+              {
+                ljt_cur++;
+                skip_blanks();
+                continue;
+              }
+            if (ljt_cur < ljt_end && *ljt_cur == closec)
+              {
+                ljt_cur++;
+                break;
+              }
+            fail(isobj ? "expecting comma or closing brace" : "expecting comma or closing bracket");
+          }
+      ljt_tape[node] = (nbsons << 8) | (isobj ? ljk_object : ljk_array);
+      ljt_tape[node+1] = ljt_tape.size();
+      return;
+    }
+    case '"':
+      parse_string();
+      return;
+    case 't':
+      parse_literal("true", ljk_true);
+      return;
+    case 'f':
+      parse_literal("false", ljk_false);
+      return;
+    case 'n':
+      parse_literal("null", ljk_null);
+      return;
+    default:
+      parse_number();
+      return;
+    }
+} // end Rps_LoaderJsonTape::parse_value
+
+
+void
+Rps_LoaderJsonTape::parse_literal(const char*lit, kind_en kind)
+{
+  size_t litlen = strlen(lit);
+  if ((size_t)(ljt_end - ljt_cur) < litlen || memcmp(ljt_cur, lit, litlen))
+    fail("invalid literal");
+  ljt_cur += litlen;
+  ljt_tape.push_back(kind);
+} // end Rps_LoaderJsonTape::parse_literal
+
+
+void
+Rps_LoaderJsonTape::parse_number(void)
+{
+  const char*start = ljt_cur;
+  const char*pc = ljt_cur;
+  bool isreal = false;
+  if (pc < ljt_end && *pc == '-')
+    pc++;
+  if (pc >= ljt_end || !isdigit(*pc))
+    fail("invalid value");
+  while (pc < ljt_end && isdigit(*pc))
+    pc++;
+  if (pc < ljt_end && *pc == '.')
+    {
+      isreal = true;
+      pc++;
+      if (pc >= ljt_end || !isdigit(*pc))
+        fail("invalid fraction");
+      while (pc < ljt_end && isdigit(*pc))
+        pc++;
+    }
+  if (pc < ljt_end && (*pc == 'e' || *pc == 'E'))
+    {
+      isreal = true;
+      pc++;
+      if (pc < ljt_end && (*pc == '+' || *pc == '-'))
+        pc++;
+      if (pc >= ljt_end || !isdigit(*pc))
+        fail("invalid exponent");
+      while (pc < ljt_end && isdigit(*pc))
+        pc++;
+    }
+  ljt_cur = pc;
+  if (!isreal)
+    {
+      std::int64_t i = 0;
+      auto [endp, ec] = std::from_chars(start, pc, i);
+      if (ec == std::errc() && endp == pc)
+        {
+          ljt_tape.push_back(ljk_int);
+          ljt_tape.push_back((std::uint64_t)i);
+          return;
+        }
+      // too big integers are reals, like for jsoncpp
+    }
+  double d = 0.0;
+  auto [endp, ec] = std::from_chars(start, pc, d);
+  if (endp != pc || (ec != std::errc() && ec != std::errc::result_out_of_range))
+    fail("invalid number");
+  /// from_chars leaves d unchanged when out of range, but the
+  /// infinities are written as 1e+9999 or -1e+9999, and jsoncpp reads
+  /// them as such
+  if (ec == std::errc::result_out_of_range)
+    {
+      const char*expp = start;
+      while (expp < pc && *expp != 'e' && *expp != 'E')
+        expp++;
+      bool underflow = (expp+1 < pc && expp[1] == '-');
+      d = underflow ? 0.0 : HUGE_VAL;
+      if (*start == '-')
+        d = -d;
+    }
+  std::uint64_t w = 0;
+  memcpy(&w, &d, sizeof(w));
+  ljt_tape.push_back(ljk_real);
+  ljt_tape.push_back(w);
+} // end Rps_LoaderJsonTape::parse_number
+
+
+std::uint32_t
+Rps_LoaderJsonTape::parse_hex4(void)
+{
+  if (ljt_end - ljt_cur < 4)
+    fail("truncated unicode escape");
+  std::uint32_t code = 0;
+  for (int i=0; i<4; i++)
+    {
+      char c = *ljt_cur++;
+      code <<= 4;
+      if (c >= '0' && c <= '9')
+        code |= c - '0';
+      else if (c >= 'a' && c <= 'f')
+        code |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        code |= c - 'A' + 10;
+      else
+        fail("bad unicode escape");
+    }
+  return code;
+} // end Rps_LoaderJsonTape::parse_hex4
+
+
+void
+Rps_LoaderJsonTape::put_utf8(std::uint32_t codepoint)
+{
+  if (codepoint < 0x80)
+    ljt_unescaped.push_back((char)codepoint);
+  else if (codepoint < 0x800)
+    {
+      ljt_unescaped.push_back((char)(0xC0 | (codepoint >> 6)));
+      ljt_unescaped.push_back((char)(0x80 | (codepoint & 0x3F)));
+    }
+  else if (codepoint < 0x10000)
+    {
+      ljt_unescaped.push_back((char)(0xE0 | (codepoint >> 12)));
+      ljt_unescaped.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+      ljt_unescaped.push_back((char)(0x80 | (codepoint & 0x3F)));
+    }
+  else
+    {
+      ljt_unescaped.push_back((char)(0xF0 | (codepoint >> 18)));
+      ljt_unescaped.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+      ljt_unescaped.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+      ljt_unescaped.push_back((char)(0x80 | (codepoint & 0x3F)));
+    }
+} // end Rps_LoaderJsonTape::put_utf8
+
+
+void
+Rps_LoaderJsonTape::parse_string(void)
+{
+  RPS_ASSERT(ljt_cur < ljt_end && *ljt_cur == '"');
+  const char*start = ++ljt_cur;
+  // the common case: no escape, so the string stays in the text
+  const char*pc = start;
+  while (pc < ljt_end && *pc != '"' && *pc != '\\')
+    pc++;
+  if (pc >= ljt_end)
+    fail("unterminated string");
+  if (*pc == '"')
+    {
+      ljt_cur = pc+1;
+      ljt_tape.push_back(((std::uint64_t)(pc - start) << 8) | ljk_string);
+      ljt_tape.push_back((std::uint64_t)(start - ljt_text.data()));
+      return;
+    }
+  size_t off = ljt_unescaped.size();
+  ljt_unescaped.append(start, pc - start);
+  ljt_cur = pc;
+  while (ljt_cur < ljt_end && *ljt_cur != '"')
+    {
+      char c = *ljt_cur++;
+      if (c != '\\')
+        {
+          ljt_unescaped.push_back(c);
+          continue;
+        }
+      if (ljt_cur >= ljt_end)
+        fail("unterminated string");
+      c = *ljt_cur++;
+      switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+          ljt_unescaped.push_back(c);
+          break;
+        case 'b':
+          ljt_unescaped.push_back('\b');
+          break;
+        case 'f':
+          ljt_unescaped.push_back('\f');
+          break;
+        case 'n':
+          ljt_unescaped.push_back('\n');
+          break;
+        case 'r':
+          ljt_unescaped.push_back('\r');
+          break;
+        case 't':
+          ljt_unescaped.push_back('\t');
+          break;
+        case 'u':
+        {
+          std::uint32_t code = parse_hex4();
+          if (code >= 0xD800 && code <= 0xDBFF)
+            {
+              if (ljt_end - ljt_cur < 2 || ljt_cur[0] != '\\' || ljt_cur[1] != 'u')
+                fail("missing low surrogate");
+              ljt_cur += 2;
+              std::uint32_t low = parse_hex4();
+              if (low < 0xDC00 || low > 0xDFFF)
+                fail("bad low surrogate");
+              code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+          put_utf8(code);
+        }
+        break;
+        default:
+          fail("bad escape in string");
+        }
+    }
+  if (ljt_cur >= ljt_end)
+    fail("unterminated string");
+  ljt_cur++;
+  ljt_tape.push_back(((std::uint64_t)(ljt_unescaped.size() - off) << 8) | ljk_string);
+  ljt_tape.push_back(ljt_unescapedbit | off);
+} // end Rps_LoaderJsonTape::parse_string
+
+
+Json::Value
+Rps_LoaderJsonTape::to_json(unsigned node, std::string_view skippedkey1, std::string_view skippedkey2) const
+{
+  switch (kind(node))
+    {
+    case ljk_null:
+      return Json::Value(Json::nullValue);
+    case ljk_false:
+      return Json::Value(false);
+    case ljk_true:
+      return Json::Value(true);
+    case ljk_int:
+      return Json::Value((Json::Int64)int_at(node));
+    case ljk_real:
+      return Json::Value(real_at(node));
+    case ljk_string:
+    {
+      std::string_view sv = string_at(node);
+      return Json::Value(sv.data(), sv.data() + sv.size());
+    }
+    case ljk_array:
+    {
+      Json::Value jarr(Json::arrayValue);
+      unsigned nbelem = count(node);
+      jarr.resize(nbelem);
+      unsigned curnode = first(node);
+      for (unsigned eix=0; eix<nbelem; eix++)
+        {
+          jarr[eix] = to_json(curnode);
+          curnode = next(curnode);
+        }
+      return jarr;
+    }
+    case ljk_object:
+    {
+      Json::Value jobj(Json::objectValue);
+      unsigned nbmemb = count(node);
+      unsigned curnode = first(node);
+      for (unsigned mix=0; mix<nbmemb; mix++)
+        {
+          std::string_view key = string_at(curnode);
+          unsigned valnode = curnode+2;
+          if (key.empty() || (key != skippedkey1 && key != skippedkey2))
+            jobj[std::string(key)] = to_json(valnode);
+          curnode = next(valnode);
+        }
+      return jobj;
+    }
+    };
+  RPS_FATALOUT("Rps_LoaderJsonTape::to_json corrupted node#" << node);
+} // end Rps_LoaderJsonTape::to_json
+
+
+
+
+
+//////////////////////////////////////////////// binary snapshot
+/// The optional binary snapshot, written by the dumper after the
+/// space files when rps_dump_snapshot is set, keeps what the loader
+/// would compute from them: an object table, sorted by space and by
+/// position in its space file, and the JSON tape of every object,
+/// whose strings are interned once in a pool. The loader maps it,
+/// makes every object in bulk and fills them from these tapes,
+/// without scanning or parsing the space files. The JSON files stay
+/// the source of truth: the manifest gives the checksum of the
+/// snapshot and the size, mtime and checksum of every space file, so
+/// a stale snapshot is never used. The file is made of the header, the
+/// space table, the object table, the tape words and the string
+/// pool, all of them aligned on 64 bits words.
+#define RPS_SNAPSHOT_MAGIC "RpsSnap\n"
+#define RPS_SNAPSHOT_VERSION 1
+struct Rps_SnapshotHeader
+{
+  char snh_magic[8];		// RPS_SNAPSHOT_MAGIC
+  std::uint32_t snh_version;	// RPS_SNAPSHOT_VERSION
+  std::uint32_t snh_nbspaces;
+  std::uint64_t snh_nbobjects;
+  std::uint64_t snh_nbwords;
+  std::uint64_t snh_strbytes;	// rounded up to a multiple of 8
+};
+struct Rps_SnapshotSpace
+{
+  std::uint64_t sns_idhi;
+  std::uint64_t sns_idlo;
+  std::uint64_t sns_filesize;
+  std::uint64_t sns_checksum;	// of the whole space file
+};
+struct Rps_SnapshotObject
+{
+  std::uint64_t sno_idhi;
+  std::uint64_t sno_idlo;
+  std::uint32_t sno_spaceix;	// index in the space table
+  std::uint32_t sno_lineno;
+  std::uint64_t sno_textoff;	// the object chunk in the space file
+  std::uint64_t sno_textlen;
+  std::uint64_t sno_tapeoff;	// index of its first tape word
+  std::uint64_t sno_tapelen;
+};
+static_assert(sizeof(Rps_SnapshotHeader) % sizeof(std::uint64_t) == 0);
+static_assert(sizeof(Rps_SnapshotSpace) % sizeof(std::uint64_t) == 0);
+static_assert(sizeof(Rps_SnapshotObject) % sizeof(std::uint64_t) == 0);
+
+/// a fast checksum of a whole file, one 64 bits word at a time
+static std::uint64_t
+rps_snapshot_checksum(const char*data, size_t size)
+{
+  std::uint64_t h = 0x2545F4914F6CDD1DULL ^ size;
+  size_t ix = 0;
+  for (; ix + 8 <= size; ix += 8)
+    {
+      std::uint64_t w = 0;
+      memcpy(&w, data+ix, 8);
+      h = (h ^ w) * 0x9E3779B97F4A7C15ULL;
+      h ^= h >> 29;
+    }
+  if (ix < size)
+    {
+      std::uint64_t w = 0;
+      memcpy(&w, data+ix, size-ix);
+      h = (h ^ w) * 0x9E3779B97F4A7C15ULL;
+      h ^= h >> 29;
+    }
+  return h ^ (h >> 32);
+} // end rps_snapshot_checksum
+
+static std::string
+rps_snapshot_checksum_string(std::uint64_t chksum)
+{
+  char buf[24];
+  memset (buf, 0, sizeof(buf));
+  snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)chksum);
+  return std::string(buf);
+} // end rps_snapshot_checksum_string
+
+/// map some file read-only, giving an empty view for empty files; it
+/// should be unmapped with munmap when not empty
+static std::string_view
+rps_map_readonly_file(const std::string&path)
+{
+  int fd = open(path.c_str(), O_RDONLY|O_CLOEXEC);
+  if (fd < 0)
+    throw std::runtime_error(std::string("cannot open ") + path + ":" + strerror(errno));
+  struct stat filestat;
+  memset (&filestat, 0, sizeof(filestat));
+  if (fstat(fd, &filestat))
+    {
+      int e = errno;
+      close(fd);
+      throw std::runtime_error(std::string("cannot stat ") + path + ":" + strerror(e));
+    }
+  size_t filesize = (size_t) filestat.st_size;
+  void*ad = nullptr;
+  if (filesize > 0)
+    {
+      ad = mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (ad == MAP_FAILED)
+        {
+          int e = errno;
+          close(fd);
+          throw std::runtime_error(std::string("cannot mmap ") + path + ":" + strerror(e));
+        }
+    }
+  close(fd);
+  return std::string_view(ad?(const char*)ad:"", filesize);
+} // end rps_map_readonly_file
+
+/// get the size and the mtime in nanoseconds of some file, stamping a
+/// space file of the binary snapshot; false if it cannot be stat-ed
+static bool
+rps_file_stamp(const std::string&path, std::uint64_t*psize, std::int64_t*pmtimens)
+{
+  struct stat filestat;
+  memset (&filestat, 0, sizeof(filestat));
+  if (stat(path.c_str(), &filestat))
+    return false;
+  *psize = (std::uint64_t) filestat.st_size;
+  *pmtimens = (std::int64_t) filestat.st_mtim.tv_sec * 1000000000LL
+              + (std::int64_t) filestat.st_mtim.tv_nsec;
+  return true;
+} // end rps_file_stamp
+
+/// The write-ahead journal is made of groups of object chunks, each
+/// going from its //+jr line, giving the object, its space and the
+/// time it was emitted, to its //-jr line. Every group ends with a
+/// //=jrgroup line, written just before the fdatasync of the whole
+/// group; so the chunks after the last such line are torn by a crash,
+/// and ignored.
+struct Rps_JournalChunk
+{
+  Rps_Id jc_objid;
+  Rps_Id jc_spacid;
+  double jc_time;
+  unsigned jc_lineno;
+  std::string_view jc_view;	// from its //+jr line to its //-jr line
+};
+
+/// call fun on every chunk of a committed group, in order, and give
+/// the number of committed groups
+static unsigned
+rps_journal_each_committed_chunk(std::string_view text,
+                                 const std::function<void(const Rps_JournalChunk&)>& fun)
+{
+  std::vector<Rps_JournalChunk> groupvec;
+  Rps_JournalChunk curchunk;
+  bool inchunk = false;
+  size_t chunkoff = 0;
+  unsigned nbgroups = 0;
+  unsigned lineno = 0;
+  size_t linoff = 0;
+  while (linoff < text.size())
+    {
+      lineno++;
+      size_t eol = text.find('\n', linoff);
+      size_t nextoff = (eol == std::string_view::npos) ? text.size() : eol+1;
+      std::string_view linview = text.substr(linoff, nextoff - linoff);
+      if (linview.substr(0, 5) == "//+jr")
+        {
+          // //+jr<objid> <spacid> <time>
+          inchunk = false;
+          if (linview.size() > 6 + 2*Rps_Id::nbchars)
+            {
+              curchunk.jc_objid = Rps_Id(std::string(linview.substr(5, Rps_Id::nbchars)));
+              curchunk.jc_spacid = Rps_Id(std::string(linview.substr(6 + Rps_Id::nbchars,
+                                          Rps_Id::nbchars)));
+              curchunk.jc_time = atof(std::string(linview.substr(7 + 2*Rps_Id::nbchars)).c_str());
+              curchunk.jc_lineno = lineno;
+              chunkoff = linoff;
+              inchunk = curchunk.jc_objid.valid() && curchunk.jc_spacid.valid();
+            }
+        }
+      else if (linview.substr(0, 5) == "//-jr")
+        {
+          if (inchunk && eol != std::string_view::npos
+              && linview.substr(5, Rps_Id::nbchars) == curchunk.jc_objid.to_string())
+            {
+              curchunk.jc_view = text.substr(chunkoff, nextoff - chunkoff);
+              groupvec.push_back(curchunk);
+            }
+          inchunk = false;
+        }
+      else if (linview.substr(0, 10) == "//=jrgroup" && eol != std::string_view::npos)
+        {
+          for (const Rps_JournalChunk& jc: groupvec)
+            fun(jc);
+          groupvec.clear();
+          nbgroups++;
+          inchunk = false;
+        }
+      linoff = nextoff;
+    }
+  return nbgroups;
+} // end rps_journal_each_committed_chunk
+
+
 //////////////////////////////////////////////// loader
 class Rps_Loader
 {
@@ -96,12 +892,65 @@ class Rps_Loader
   std::deque<struct todo_st> ld_todoque;
   unsigned ld_todocount;
   static constexpr unsigned ld_maxtodo = 1<<20;
+  /// an object chunk of some space file, found in the first pass,
+  /// then parsed and filled in the second pass by any loading
+  /// thread; its text stays in the memory mapped space file
+  struct chunk_st
+  {
+    Rps_Id chk_spacid;
+    Rps_Id chk_objid;
+    unsigned chk_lineno;
+    unsigned chk_count;
+    std::string_view chk_objview;
+    /// the already parsed tape in a validated binary snapshot, or null
+    const std::uint64_t* chk_tapewords;
+    size_t chk_nbtapewords;
+    /// the loaded mtime, restored once the todo functions have run
+    double chk_mtime;
+  };
+  std::vector<chunk_st> ld_chunkvec;
+  /// the memory mapped space files, unmapped by the destructor
+  std::map<Rps_Id,std::string_view> ld_mappedspaces;
+  /// the checksum of the binary snapshot given by the manifest, or empty
+  std::string ld_snapshotchecksum;
+  /// the stamp of every space file given by the manifest for the snapshot
+  struct snapstamp_st
+  {
+    std::uint64_t sst_filesize;
+    std::int64_t sst_mtimens;
+    std::uint64_t sst_checksum;
+  };
+  std::map<Rps_Id,snapstamp_st> ld_snapshotstamps;
+  /// the memory mapped binary snapshot once validated, and its string pool
+  std::string_view ld_snapshotview;
+  std::string_view ld_snapshotstrings;
+  /// the memory mapped write-ahead journal, and the spaces whose file
+  /// is made stale by its replay
+  std::string_view ld_journalview;
+  std::set<Rps_Id> ld_journaledspaces;
+  /// loading threads grab that many consecutive chunks at once
+  static constexpr unsigned ld_chunkbatch = 16;
   /// dictionnary of payload loaders - used as a cache to avoid most dlsym-s
   std::map<std::string,rpsldpysig_t*> ld_payloadercache;
-  bool is_object_starting_line(Rps_Id spacid, unsigned lineno, const std::string&linbuf, Rps_Id*pobid);
+  /// the objects whose second pass is running; their payload is
+  /// loaded without their lock, so it is not used before completion
+  std::set<Rps_ObjectZone*> ld_fillingobjset;
+  bool is_object_starting_line(Rps_Id spacid, unsigned lineno, std::string_view linview, Rps_Id*pobid);
+  std::string_view map_space_file(Rps_Id spacid, const std::string&spacepath);
+  bool load_snapshot(void);
+  void replay_journal(void);
   Rps_ObjectRef fetch_one_constant_at(const char*oid,int lin);
-  void parse_json_buffer_second_pass (Rps_Id spacid, unsigned lineno,
-                                      Rps_Id objid, const std::string& objbuf, unsigned count);
+  /// gives the loaded mtime of the object
+  double parse_json_buffer_second_pass (Rps_Id spacid, unsigned lineno,
+                                        Rps_Id objid, std::string_view objview, unsigned count,
+                                        const std::uint64_t*tapewords=nullptr, size_t nbtapewords=0);
+  /// build values directly from a node of the parsed tape, like the
+  /// Rps_ObjectRef and Rps_Value constructors from a Json::Value
+  Rps_ObjectRef tape_objref(const Rps_LoaderJsonTape&tape, unsigned node);
+  Rps_Value tape_value(const Rps_LoaderJsonTape&tape, unsigned node);
+  void second_pass_chunk(chunk_st& chunk);
+  void restore_loaded_mtimes_and_dump_records(void);
+  void run_second_pass_worker(std::vector<chunk_st>* pchunkvec, std::atomic<size_t>* pnextchunk, int ix);
 public:
   Rps_Loader(const std::string&topdir);
   ~Rps_Loader();
@@ -129,6 +978,12 @@ public:
   {
     return ld_mapobjects.size();
   };
+  /// true while the second pass of that object is running
+  bool is_being_filled(Rps_ObjectZone*obz)
+  {
+    std::lock_guard<std::recursive_mutex> gu(ld_mtx);
+    return ld_fillingobjset.find(obz) != ld_fillingobjset.end();
+  };
 };				// end class Rps_Loader
 
 Rps_Loader::Rps_Loader(const std::string&topdir) :
@@ -140,6 +995,12 @@ Rps_Loader::Rps_Loader(const std::string&topdir) :
   ld_mapobjects(),
   ld_todoque(),
   ld_todocount(0),
+  ld_chunkvec(),
+  ld_mappedspaces(),
+  ld_snapshotchecksum(),
+  ld_snapshotstamps(),
+  ld_snapshotview(),
+  ld_snapshotstrings(),
   ld_payloadercache()
 {
   RPS_DEBUG_LOG(LOAD, "Rps_Loader constr topdir=" << topdir
@@ -150,6 +1011,16 @@ Rps_Loader::Rps_Loader(const std::string&topdir) :
 
 Rps_Loader::~Rps_Loader()
 {
+  for (auto it: ld_mappedspaces)
+    if (it.second.size() > 0)
+      munmap((void*)it.second.data(), it.second.size());
+  ld_mappedspaces.clear();
+  if (ld_snapshotview.size() > 0)
+    munmap((void*)ld_snapshotview.data(), ld_snapshotview.size());
+  ld_snapshotview = std::string_view();
+  if (ld_journalview.size() > 0)
+    munmap((void*)ld_journalview.data(), ld_journalview.size());
+  ld_journalview = std::string_view();
   RPS_DEBUG_LOG(LOAD, "Rps_Loader destr topdir=" << ld_topdir
                 << " this@" << (void*)this
                 << std::endl
@@ -204,7 +1075,7 @@ Rps_Loader::space_file_path(Rps_Id spacid)
 
 
 bool
-Rps_Loader::is_object_starting_line(Rps_Id spacid, unsigned lineno, const std::string&linbuf, Rps_Id*pobid)
+Rps_Loader::is_object_starting_line(Rps_Id spacid, unsigned lineno, std::string_view linview, Rps_Id*pobid)
 {
   const char*reason = nullptr;
   if (pobid)
@@ -212,18 +1083,28 @@ Rps_Loader::is_object_starting_line(Rps_Id spacid, unsigned lineno, const std::s
   Rps_Id oid;
   const char*end=nullptr;
   bool ok=false;
-  if (linbuf[0] != '/' || linbuf[1] != '/'
-      || linbuf[2] != '+'
-      || linbuf[3] != 'o'
-      || linbuf[4] != 'b')
+  // the line is not null terminated inside the mapped file
+  char linbuf[64];
+  if (linview.size() < 5
+      || linview[0] != '/' || linview[1] != '/'
+      || linview[2] != '+'
+      || linview[3] != 'o'
+      || linview[4] != 'b')
     return false;
-  if (linbuf.size() < strlen ("//+ob") + Rps_Id::nbchars)
+  if (linview.size() < strlen ("//+ob") + Rps_Id::nbchars)
     {
       reason = "too short";
       goto bad;
     }
+  if (linview.size() >= sizeof(linbuf))
+    {
+      reason = "too long";
+      goto bad;
+    }
+  memcpy(linbuf, linview.data(), linview.size());
+  linbuf[linview.size()] = (char)0;
   {
-    Rps_Id tempoid(linbuf.c_str()+strlen("//+ob"), &end, &ok);
+    Rps_Id tempoid(linbuf+strlen("//+ob"), &end, &ok);
     if (!end || (*end && !isspace(*end)))
       {
         reason= "too long";
@@ -250,91 +1131,147 @@ bad:
   RPS_WARNOUT("bad object starting line in space " << spacid << " line#" << lineno
               << " - " << reason
               << ":" << std::endl
-              << linbuf);
+              << linview);
   return false;
 } // end Rps_Loader::is_object_starting_line
 
 
 
+/// map the whole space file in memory, and check once that it is
+/// all UTF-8
+std::string_view
+Rps_Loader::map_space_file(Rps_Id spacid, const std::string&spacepath)
+{
+  // a validated snapshot has already mapped the space file
+  {
+    auto it = ld_mappedspaces.find(spacid);
+    if (it != ld_mappedspaces.end())
+      return it->second;
+  }
+  std::string_view fileview = rps_map_readonly_file(spacepath);
+  if (fileview.size() > 0)
+    (void) madvise((void*)fileview.data(), fileview.size(), MADV_SEQUENTIAL);
+  ld_mappedspaces.insert({spacid, fileview});
+  if (const char*badp = rps_utf8_check_count(fileview.data(), fileview.size(), nullptr))
+    {
+      unsigned badlin = 1 + (unsigned) std::count(fileview.data(), badp, '\n');
+      const char*badeol = (const char*)memchr(badp, '\n', fileview.data() + fileview.size() - badp);
+      const char*badbol = badp;
+      while (badbol > fileview.data() && badbol[-1] != '\n')
+        badbol--;
+      RPS_WARNOUT("non UTF8 line#" << badlin << " in " << spacepath << ":" << std::endl
+                  << std::string_view(badbol, (badeol?badeol:fileview.data()+fileview.size()) - badbol));
+      char errbuf[40];
+      snprintf(errbuf, sizeof(errbuf), "non UTF8 line#%u", badlin);
+      throw std::runtime_error(std::string(errbuf) + " in " + spacepath);
+    }
+  return fileview;
+} // end Rps_Loader::map_space_file
+
+
+/// The first pass scans the mapped space file once: object starting
+/// lines are found with memmem, which is vectorized by the C library,
+/// and each object gets its chunk, a slice of the mapped file up to
+/// the next object, for the second pass.
 void
 Rps_Loader::first_pass_space(Rps_Id spacid)
 {
   auto spacepath = load_real_path(space_file_path(spacid));
-  std::ifstream ins(spacepath);
-  std::string prologstr;
   int obcnt = 0;
   int expectedcnt = 0;
-  unsigned lincnt = 0;
   RPS_DEBUG_LOG(LOAD, "first_pass_space start spacepath=" << spacepath);
-  for (std::string linbuf; std::getline(ins, linbuf); )
+  std::string_view fileview = map_space_file(spacid, spacepath);
+  const char*filestart = fileview.data();
+  const char*fileend = filestart + fileview.size();
+  // the object starting line at curp, or fileend
+  const char*curp = filestart;
+  if (fileview.substr(0, 5) != "//+ob")
     {
-      lincnt++;
-      if (u8_check(reinterpret_cast<const uint8_t*> (linbuf.c_str()),
-                   linbuf.size()))
+      const char*nl = (const char*)memmem(filestart, fileview.size(), "\n//+ob", 6);
+      curp = nl ? (nl+1) : fileend;
+    }
+  // the line number of curp, counted incrementally
+  unsigned lincnt = 1 + (unsigned) std::count(filestart, curp, '\n');
+  long prevchunkix = -1;
+  while (curp < fileend)
+    {
+      const char*eol = (const char*)memchr(curp, '\n', fileend - curp);
+      if (!eol)
+        eol = fileend;
+      const char*nextp = (eol < fileend)
+                         ? (const char*)memmem(eol, fileend - eol, "\n//+ob", 6)
+                         : nullptr;
+      nextp = nextp ? (nextp+1) : fileend;
+      Rps_Id curobjid;
+      if (!is_object_starting_line(spacid, lincnt, std::string_view(curp, eol - curp), &curobjid))
         {
-          RPS_WARN("non UTF8 line#%d in %s:\n%s",
-                   lincnt, spacepath.c_str(), linbuf.c_str());
-          char errbuf[40];
-          snprintf(errbuf, sizeof(errbuf), "non UTF8 line#%d", lincnt);
-          throw std::runtime_error(std::string(errbuf) + " in " + spacepath);
+          // a bad starting line belongs to the previous object
+          lincnt += (unsigned) std::count(curp, nextp, '\n');
+          if (prevchunkix >= 0)
+            {
+              chunk_st& prevchunk = ld_chunkvec[prevchunkix];
+              prevchunk.chk_objview = std::string_view(prevchunk.chk_objview.data(),
+                                      nextp - prevchunk.chk_objview.data());
+            }
+          curp = nextp;
+          continue;
         }
+      RPS_DEBUG_LOG(LOAD, "firstpass got ob spacid:" << spacid
+                    << " lincnt#" << lincnt
+                    << " curobjid:" << curobjid
+                    << " count:" << (obcnt+1));
       if (RPS_UNLIKELY(obcnt == 0))
         {
-          prologstr += linbuf;
-          prologstr += '\n';
-        }
-      Rps_Id curobjid;
-      if (is_object_starting_line(spacid, lincnt, linbuf, &curobjid))
-        {
-          RPS_DEBUG_LOG(LOAD, "firstpass got ob spacid:" << spacid
-                        << " linbuf: " << linbuf
-                        << " lincnt#" << lincnt
-                        << " curobjid:" << curobjid
-                        << " count:" << (obcnt+1));
-          if (RPS_UNLIKELY(obcnt == 0))
+          // the prologue is everything before, with the first object line
+          std::string_view prologview(filestart, eol - filestart);
+          Json::Value prologjson;
+          try
             {
-              Json::Value prologjson;
-              try
-                {
-                  prologjson = rps_string_to_json(prologstr);
-                  if (prologjson.type() != Json::objectValue)
-                    RPS_FATAL("Rps_Loader::first_pass_space %s line#%d bad Json type #%d",
-                              spacepath.c_str(), (int)lincnt, (int)prologjson.type());
-                }
-              catch (std::exception& exc)
-                {
-                  RPS_FATALOUT("Rps_Loader::first_pass_space " << " spacepath:" << spacepath
-                               << " line#" << lincnt
-                               << " failed to parse: " << exc.what());
-                };
-              Json::Value formatjson = prologjson["format"];
-              if (formatjson.type() !=Json::stringValue)
-                RPS_FATALOUT("space file " << spacepath
-                             << " with bad format type#" << (int)formatjson.type());
-              if (formatjson.asString() != RPS_MANIFEST_FORMAT)
-                RPS_FATALOUT("space file " << spacepath
-                             << "should have format: "
-                             << RPS_MANIFEST_FORMAT
-                             << " but got "
-                             << formatjson);
-              if (prologjson["spaceid"].asString() != spacid.to_string())
-                RPS_FATAL("spacefile %s should have spaceid: '%s' but got '%s'",
-                          spacepath.c_str (), spacid.to_string().c_str(),
-                          prologjson["spaceid"].asString().c_str());
-              Json::Value nbobjectsjson =  prologjson["nbobjects"];
-              expectedcnt =nbobjectsjson.asInt();
+              prologjson = rps_string_view_to_json(prologview);
+              if (prologjson.type() != Json::objectValue)
+                RPS_FATAL("Rps_Loader::first_pass_space %s line#%d bad Json type #%d",
+                          spacepath.c_str(), (int)lincnt, (int)prologjson.type());
             }
-          Rps_ObjectRef obref(Rps_ObjectZone::make_loaded(curobjid, this));
-          if (ld_mapobjects.find(curobjid) != ld_mapobjects.end())
+          catch (std::exception& exc)
             {
-              RPS_WARN("duplicate object of oid %s in  line#%d in %s",
-                       curobjid.to_string().c_str(), lincnt, spacepath.c_str());
-              throw std::runtime_error(std::string("duplicate objid "
-                                                   + curobjid.to_string() + " in " + spacepath));
-            }
-          ld_mapobjects.insert({curobjid,obref});
-          obcnt++;
+              RPS_FATALOUT("Rps_Loader::first_pass_space " << " spacepath:" << spacepath
+                           << " line#" << lincnt
+                           << " failed to parse: " << exc.what());
+            };
+          Json::Value formatjson = prologjson["format"];
+          if (formatjson.type() !=Json::stringValue)
+            RPS_FATALOUT("space file " << spacepath
+                         << " with bad format type#" << (int)formatjson.type());
+          if (formatjson.asString() != RPS_MANIFEST_FORMAT)
+            RPS_FATALOUT("space file " << spacepath
+                         << "should have format: "
+                         << RPS_MANIFEST_FORMAT
+                         << " but got "
+                         << formatjson);
+          if (prologjson["spaceid"].asString() != spacid.to_string())
+            RPS_FATAL("spacefile %s should have spaceid: '%s' but got '%s'",
+                      spacepath.c_str (), spacid.to_string().c_str(),
+                      prologjson["spaceid"].asString().c_str());
+          Json::Value nbobjectsjson =  prologjson["nbobjects"];
+          expectedcnt =nbobjectsjson.asInt();
+          ld_chunkvec.reserve(ld_chunkvec.size() + expectedcnt);
+        }
+      Rps_ObjectRef obref(Rps_ObjectZone::make_loaded(curobjid, this));
+      if (ld_mapobjects.find(curobjid) != ld_mapobjects.end())
+        {
+          RPS_WARN("duplicate object of oid %s in  line#%d in %s",
+                   curobjid.to_string().c_str(), lincnt, spacepath.c_str());
+          throw std::runtime_error(std::string("duplicate objid "
+                                               + curobjid.to_string() + " in " + spacepath));
         }
+      ld_mapobjects.insert({curobjid,obref});
+      obcnt++;
+      prevchunkix = (long) ld_chunkvec.size();
+      ld_chunkvec.push_back(chunk_st{spacid, curobjid, lincnt, (unsigned)obcnt,
+                                     std::string_view(curp, nextp - curp),
+                                     nullptr, 0, 0.0});
+      lincnt += (unsigned) std::count(curp, nextp, '\n');
+      curp = nextp;
     }
   if (obcnt != expectedcnt)
     {
@@ -348,6 +1285,206 @@ Rps_Loader::first_pass_space(Rps_Id spacid)
                 << " objects while loading first pass of " << spacepath);
 } // end Rps_Loader::first_pass_space
 
+
+/// Use the binary snapshot given by the manifest instead of the first
+/// pass, if it is not stale: its checksum should be the one in the
+/// manifest, and its space table should agree with the stamps of the
+/// manifest, and every space file should still have the checksum of
+/// the snapshot. A space file whose size and mtime are still those
+/// stamps is just mapped, without the UTF-8 check of map_space_file,
+/// and checksummed by up to rps_nbjobs threads; any other space file
+/// is checked and checksummed in turn. Only then is every object made
+/// from the object table, and its chunk refers to its already parsed
+/// tape. Otherwise, nothing is made and false is returned, so the
+/// space files are scanned as usual.
+bool
+Rps_Loader::load_snapshot(void)
+{
+  std::string snappath = ld_topdir + "/" + RPS_SNAPSHOT_BIN;
+  double startrealt = rps_elapsed_real_time();
+  std::string_view snapview;
+  try
+    {
+      snapview = rps_map_readonly_file(snappath);
+    }
+  catch (const std::exception& exc)
+    {
+      RPS_WARNOUT("Rps_Loader::load_snapshot not using " << snappath << ": " << exc.what());
+      return false;
+    }
+  /// the space files whose checksum is deferred, mapped without the
+  /// UTF-8 check of map_space_file, so forgotten if rejected
+  struct deferred_st
+  {
+    Rps_Id dfs_spacid;
+    std::string_view dfs_view;
+    std::uint64_t dfs_checksum;
+  };
+  std::vector<deferred_st> deferredvec;
+  auto reject = [&](const std::string& reason)
+  {
+    RPS_WARNOUT("Rps_Loader::load_snapshot not using stale or bad " << snappath
+                << ": " << reason);
+    if (snapview.size() > 0)
+      munmap((void*)snapview.data(), snapview.size());
+    for (auto& dfs: deferredvec)
+      {
+        if (dfs.dfs_view.size() > 0)
+          munmap((void*)dfs.dfs_view.data(), dfs.dfs_view.size());
+        ld_mappedspaces.erase(dfs.dfs_spacid);
+      }
+    return false;
+  };
+  const char*snapdata = snapview.data();
+  size_t snapsize = snapview.size();
+  if (rps_snapshot_checksum_string(rps_snapshot_checksum(snapdata, snapsize))
+      != ld_snapshotchecksum)
+    return reject("checksum differs from the manifest");
+  if (snapsize < sizeof(Rps_SnapshotHeader))
+    return reject("too short");
+  const Rps_SnapshotHeader*snaphdr = (const Rps_SnapshotHeader*)snapdata;
+  if (memcmp(snaphdr->snh_magic, RPS_SNAPSHOT_MAGIC, sizeof(snaphdr->snh_magic))
+      || snaphdr->snh_version != RPS_SNAPSHOT_VERSION)
+    return reject("bad magic or version");
+  size_t nbspaces = snaphdr->snh_nbspaces;
+  size_t nbobjects = snaphdr->snh_nbobjects;
+  size_t nbwords = snaphdr->snh_nbwords;
+  if (sizeof(Rps_SnapshotHeader) + nbspaces*sizeof(Rps_SnapshotSpace)
+      + nbobjects*sizeof(Rps_SnapshotObject) + nbwords*sizeof(std::uint64_t)
+      + snaphdr->snh_strbytes != snapsize)
+    return reject("unexpected size");
+  const Rps_SnapshotSpace*spacetab = (const Rps_SnapshotSpace*)(snaphdr+1);
+  const Rps_SnapshotObject*objtab = (const Rps_SnapshotObject*)(spacetab+nbspaces);
+  const std::uint64_t*tapewords = (const std::uint64_t*)(objtab+nbobjects);
+  if (nbspaces != ld_spaceset.size())
+    return reject("other spaces than the manifest");
+  std::vector<Rps_Id> spacidvec;
+  std::vector<std::string_view> spaceviewvec;
+  spacidvec.reserve(nbspaces);
+  spaceviewvec.reserve(nbspaces);
+  for (size_t spix=0; spix<nbspaces; spix++)
+    {
+      const Rps_SnapshotSpace&cursnapspace = spacetab[spix];
+      Rps_Id spacid(cursnapspace.sns_idhi, cursnapspace.sns_idlo);
+      if (ld_spaceset.find(spacid) == ld_spaceset.end())
+        return reject(std::string("unexpected space ") + spacid.to_string());
+      auto itstamp = ld_snapshotstamps.find(spacid);
+      if (itstamp != ld_snapshotstamps.end()
+          && (itstamp->second.sst_filesize != cursnapspace.sns_filesize
+              || itstamp->second.sst_checksum != cursnapspace.sns_checksum))
+        return reject(std::string("manifest disagrees for space ") + spacid.to_string());
+      std::string_view spaceview;
+      try
+        {
+          std::string spacepath = load_real_path(space_file_path(spacid));
+          std::uint64_t filesize = 0;
+          std::int64_t mtimens = 0;
+          if (itstamp != ld_snapshotstamps.end()
+              && rps_file_stamp(spacepath, &filesize, &mtimens)
+              && filesize == itstamp->second.sst_filesize
+              && mtimens == itstamp->second.sst_mtimens)
+            {
+              spaceview = rps_map_readonly_file(spacepath);
+              ld_mappedspaces.insert({spacid, spaceview});
+              deferredvec.push_back(deferred_st{spacid, spaceview, cursnapspace.sns_checksum});
+            }
+          else
+            spaceview = map_space_file(spacid, spacepath);
+        }
+      catch (const std::exception& exc)
+        {
+          return reject(exc.what());
+        }
+      if (spaceview.size() != cursnapspace.sns_filesize)
+        return reject(std::string("changed space file ") + space_file_path(spacid));
+      if ((deferredvec.empty() || deferredvec.back().dfs_spacid != spacid)
+          && rps_snapshot_checksum(spaceview.data(), spaceview.size())
+          != cursnapspace.sns_checksum)
+        return reject(std::string("changed space file ") + space_file_path(spacid));
+      spacidvec.push_back(spacid);
+      spaceviewvec.push_back(spaceview);
+    }
+  for (size_t obix=0; obix<nbobjects; obix++)
+    {
+      const Rps_SnapshotObject&cursnapob = objtab[obix];
+      if (cursnapob.sno_spaceix >= nbspaces
+          || cursnapob.sno_textoff + cursnapob.sno_textlen
+          > spaceviewvec[cursnapob.sno_spaceix].size()
+          || cursnapob.sno_tapelen == 0
+          || cursnapob.sno_tapeoff + cursnapob.sno_tapelen > nbwords)
+        return reject("corrupted object table");
+    }
+  /// checksum the space files with unchanged stamps before making any
+  /// object, so a stale snapshot is never used
+  if (!deferredvec.empty())
+    {
+      std::vector<char> changedvec(deferredvec.size(), 0);
+      std::atomic<size_t> nextdeferred(0);
+      auto checkfun = [&]()
+      {
+        for (size_t dfix = nextdeferred++; dfix < deferredvec.size(); dfix = nextdeferred++)
+          {
+            const deferred_st&dfs = deferredvec[dfix];
+            changedvec[dfix] =
+              rps_snapshot_checksum(dfs.dfs_view.data(), dfs.dfs_view.size())
+              != dfs.dfs_checksum;
+          }
+      };
+      unsigned nbthreads = (rps_nbjobs > 1) ? (unsigned) rps_nbjobs : 1;
+      if (nbthreads > deferredvec.size())
+        nbthreads = deferredvec.size();
+      std::vector<std::thread> thrvec;
+      thrvec.reserve(nbthreads);
+      for (unsigned thix = 1; thix < nbthreads; thix++)
+        thrvec.emplace_back(checkfun);
+      checkfun();
+      for (std::thread& thr: thrvec)
+        thr.join();
+      for (size_t dfix = 0; dfix < deferredvec.size(); dfix++)
+        if (changedvec[dfix])
+          return reject(std::string("space file ")
+                        + space_file_path(deferredvec[dfix].dfs_spacid)
+                        + " changed with the same size and mtime");
+    }
+  ld_snapshotview = snapview;
+  ld_snapshotstrings = std::string_view((const char*)(tapewords+nbwords),
+                                        snaphdr->snh_strbytes);
+  /// make every object in bulk, like the first pass does
+  ld_chunkvec.reserve(ld_chunkvec.size() + nbobjects);
+  unsigned obcnt = 0;
+  std::uint32_t prevspaceix = 0;
+  for (size_t obix=0; obix<nbobjects; obix++)
+    {
+      const Rps_SnapshotObject&cursnapob = objtab[obix];
+      Rps_Id curobjid(cursnapob.sno_idhi, cursnapob.sno_idlo);
+      Rps_Id spacid = spacidvec[cursnapob.sno_spaceix];
+      if (ld_mapobjects.find(curobjid) != ld_mapobjects.end())
+        {
+          RPS_WARN("duplicate object of oid %s in line#%d of space %s",
+                   curobjid.to_string().c_str(), (int)cursnapob.sno_lineno,
+                   spacid.to_string().c_str());
+          throw std::runtime_error(std::string("duplicate objid "
+                                               + curobjid.to_string() + " in snapshot"));
+        }
+      Rps_ObjectRef obref(Rps_ObjectZone::make_loaded(curobjid, this));
+      ld_mapobjects.insert({curobjid,obref});
+      obcnt = (obix == 0 || cursnapob.sno_spaceix != prevspaceix) ? 1 : obcnt+1;
+      prevspaceix = cursnapob.sno_spaceix;
+      ld_chunkvec.push_back(chunk_st{spacid, curobjid, cursnapob.sno_lineno, obcnt,
+                                     spaceviewvec[cursnapob.sno_spaceix].substr(cursnapob.sno_textoff,
+                                         cursnapob.sno_textlen),
+                                     tapewords + cursnapob.sno_tapeoff,
+                                     (size_t)cursnapob.sno_tapelen, 0.0});
+    }
+  char realtbuf[32];
+  memset(realtbuf, 0, sizeof(realtbuf));
+  snprintf(realtbuf, sizeof(realtbuf), "%.3f", rps_elapsed_real_time() - startrealt);
+  RPS_INFORMOUT("using binary snapshot " << snappath << " with " << nbobjects
+                << " objects in " << nbspaces << " spaces, checked and made in "
+                << realtbuf << " elapsed seconds");
+  return true;
+} // end Rps_Loader::load_snapshot
+
 void
 Rps_Loader::add_todo(const std::function<void(Rps_Loader*)>& todofun)
 {
@@ -446,24 +1583,30 @@ Rps_Loader::fetch_one_constant_at(const char*oidstr, int lin)
 
 
 ////////////////
-void
+double
 Rps_Loader::parse_json_buffer_second_pass (Rps_Id spacid, unsigned lineno,
-    Rps_Id objid, const std::string& objbuf, unsigned count)
+    Rps_Id objid, std::string_view objview, unsigned count,
+    const std::uint64_t*tapewords, size_t nbtapewords)
 {
   RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass start spacid=" << spacid << " #" << count
                 << " lineno=" <<lineno
                 << " objid=" <<objid
-                << " objbuf:\n" << objbuf);
-  Json::Value objjson;
+                << " objview:\n" << objview);
+  // each loading thread keeps its tape, reused for every chunk it parses
+  static thread_local Rps_LoaderJsonTape objtape;
+  constexpr unsigned objnode = 0;
   try
     {
-      objjson = rps_string_to_json(objbuf);
-      if (objjson.type() != Json::objectValue)
+      if (tapewords)
+        objtape.view(tapewords, nbtapewords, ld_snapshotstrings);
+      else
+        objtape.parse(objview);
+      if (objtape.kind(objnode) != Rps_LoaderJsonTape::ljk_object)
         RPS_FATALOUT("parse_json_buffer_second_pass spacid=" << spacid
                      << " lineno:" << lineno
                      << " objid:" << objid
-                     << " bad objbuf:" << std::endl
-                     << objbuf);
+                     << " bad objview:" << std::endl
+                     << objview);
     }
   catch (std::exception& exc)
     {
@@ -472,117 +1615,145 @@ Rps_Loader::parse_json_buffer_second_pass (Rps_Id spacid, unsigned lineno,
                    << " objid:" << objid
                    << " parse failure "
                    << exc.what()
-                   << " with objbuf:" << std::endl
-                   << objbuf);
+                   << " with objview:" << std::endl
+                   << objview);
     }
-  Json::Value oidjson = objjson["oid"];
-  if (oidjson.asString() != objid.to_string())
+  unsigned oidnode = objtape.member(objnode, "oid");
+  if (oidnode == Rps_LoaderJsonTape::ljt_nonode
+      || objtape.kind(oidnode) != Rps_LoaderJsonTape::ljk_string
+      || objtape.string_at(oidnode) != objid.to_string())
     RPS_FATALOUT("parse_json_buffer_second_pass spacid=" << spacid
                  << " lineno:" << lineno
                  << " objid:" << objid
                  << " unexpected");
-  auto obz = Rps_ObjectZone::find(objid);
-  if (!obz)
-    RPS_FATALOUT("parse_json_buffer_second_pass spacid=" << spacid
-                 << " lineno:" << lineno
-                 << " unknown objid:" << objid);
-  auto obzspace = Rps_ObjectZone::find(spacid);
-  obz->loader_set_class (this, Rps_ObjectRef(objjson["class"], this));
-  RPS_ASSERT (obzspace);
-  obz->loader_set_space (this, obzspace);
-  obz->loader_set_mtime (this, objjson["mtime"].asDouble());
-  if (objjson.isMember("comps"))
-    {
-      auto compjson = objjson["comps"];
-      int siz= 0;
-      if (compjson.isArray())
-        {
-          siz = compjson.size();
-          RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass obz=" << obz << " comps#" << siz);
-          obz->loader_reserve_comps(this, (unsigned)siz);
-          for (int ix=0; ix<(int)siz; ix++)
-            {
-              auto valcomp = Rps_Value(compjson[ix], this);
-              obz->loader_add_comp(this, valcomp);
-            }
-        }
-      else
-        RPS_WARNOUT("parse_json_buffer_second_pass spacid=" << spacid
-                    << " lineno:" << lineno
-                    << " objid:" << objid
-                    << " bad compjson:" << compjson);
-    }
-  if (objjson.isMember("attrs"))
-    {
-      auto attrjson = objjson["attrs"];
-      int siz= 0;
-      if (attrjson.isArray())
-        {
-          siz = attrjson.size();
-          RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass obz=" << obz << " attrs#" << siz);
-          for (int ix=0; ix<(int)siz; ix++)
-            {
-              auto entjson = attrjson[ix];
-              int entsiz= 0;
-              if (entjson.isObject()
-                  && (entsiz=entjson.size()) >= 2
-                  && entjson.isMember("at")
-                  && entjson.isMember("va")
-                 )
-                {
-                  auto atobr =  Rps_ObjectRef(entjson["at"], this);
-                  auto atval = Rps_Value(entjson["va"], this);
-                  obz->loader_put_attr(this, atobr, atval);
-                }
-            }
-        }
-      else RPS_WARNOUT("parse_json_buffer_second_pass spacid=" << spacid
-                         << " lineno:" << lineno
-                         << " objid:" << objid
-                         << " bad attrjson:" << attrjson);
-    }
-  if (objjson.isMember("magicattr"))
-    {
-      RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass magicattr objid=" << objid);
-      std::lock_guard<std::recursive_mutex> gu(ld_mtx);
-      char getfunambuf[sizeof(RPS_GETTERFUN_PREFIX)+8+Rps_Id::nbchars];
-      memset(getfunambuf, 0, sizeof(getfunambuf));
-      char obidbuf[32];
-      memset (obidbuf, 0, sizeof(obidbuf));
-      objid.to_cbuf24(obidbuf);
-      strcpy(getfunambuf, RPS_GETTERFUN_PREFIX);
-      strcat(getfunambuf+strlen(RPS_GETTERFUN_PREFIX), obidbuf);
-      RPS_ASSERT(strlen(getfunambuf)<sizeof(getfunambuf)-4);
-      void*funad = dlsym(rps_proghdl, getfunambuf);
-      if (!funad)
-        RPS_FATALOUT("cannot dlsym " << getfunambuf << " for magic attribute getter of objid:" <<  objid
-                     << " lineno:" << lineno << ", spacid:" << spacid
-                     << ":: " << dlerror());
-      obz->loader_put_magicattrgetter(this, reinterpret_cast<rps_magicgetterfun_t*>(funad));
-    }
-  if (objjson.isMember("applying"))
-    {
-      RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass applying objid=" << objid);
-      std::lock_guard<std::recursive_mutex> gu(ld_mtx);
-      char appfunambuf[sizeof(RPS_APPLYINGFUN_PREFIX)+8+Rps_Id::nbchars];
-      memset(appfunambuf, 0, sizeof(appfunambuf));
-      char obidbuf[32];
-      memset (obidbuf, 0, sizeof(obidbuf));
-      objid.to_cbuf24(obidbuf);
-      strcpy(appfunambuf, RPS_APPLYINGFUN_PREFIX);
-      strcat(appfunambuf+strlen(RPS_APPLYINGFUN_PREFIX), obidbuf);
-      RPS_ASSERT(strlen(appfunambuf)<sizeof(appfunambuf)-4);
-      void*funad = dlsym(rps_proghdl, appfunambuf);
-      if (!funad)
-        RPS_FATALOUT("cannot dlsym " << appfunambuf << " for applying function of objid:" <<  objid
-                     << " lineno:" << lineno << ", spacid:" << spacid
-                     << ":: " << dlerror());
-      obz->loader_put_applyingfunction(this, reinterpret_cast<rps_applyingfun_t*>(funad));
-    }
-  if (objjson.isMember("payload"))
+  auto obz = Rps_ObjectZone::find(objid);
+  if (!obz)
+    RPS_FATALOUT("parse_json_buffer_second_pass spacid=" << spacid
+                 << " lineno:" << lineno
+                 << " unknown objid:" << objid);
+  /// other loading threads are filling other objects concurrently.
+  /// The object lock is only held while filling this object from the
+  /// tape, and released before the payload loader, which may lock
+  /// other objects; meanwhile the object is in ld_fillingobjset, so
+  /// instance loaders needing it as their class wait for a todo
+  /// function.
+  {
+    std::lock_guard<std::recursive_mutex> gu(ld_mtx);
+    ld_fillingobjset.insert(obz);
+  }
+  double mtim = 0.0;
+  {
+    std::lock_guard<std::recursive_mutex> guobz(*(obz->objmtxptr()));
+    auto obzspace = Rps_ObjectZone::find(spacid);
+    obz->loader_set_class (this, tape_objref(objtape, objtape.member(objnode, "class")));
+    RPS_ASSERT (obzspace);
+    obz->loader_set_space (this, obzspace);
+    unsigned mtimenode = objtape.member(objnode, "mtime");
+    if (mtimenode != Rps_LoaderJsonTape::ljt_nonode && objtape.is_number(mtimenode))
+      mtim = objtape.real_at(mtimenode);
+    obz->loader_set_mtime (this, mtim);
+    unsigned compnode = objtape.member(objnode, "comps");
+    if (compnode != Rps_LoaderJsonTape::ljt_nonode)
+      {
+        if (objtape.kind(compnode) == Rps_LoaderJsonTape::ljk_array)
+          {
+            unsigned siz = objtape.count(compnode);
+            RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass obz=" << obz << " comps#" << siz);
+            obz->loader_reserve_comps(this, siz);
+            unsigned curnode = objtape.first(compnode);
+            for (unsigned ix=0; ix<siz; ix++)
+              {
+                auto valcomp = tape_value(objtape, curnode);
+                obz->loader_add_comp(this, valcomp);
+                curnode = objtape.next(curnode);
+              }
+          }
+        else
+          RPS_WARNOUT("parse_json_buffer_second_pass spacid=" << spacid
+                      << " lineno:" << lineno
+                      << " objid:" << objid
+                      << " bad compjson:" << objtape.to_json(compnode));
+      }
+    unsigned attrnode = objtape.member(objnode, "attrs");
+    if (attrnode != Rps_LoaderJsonTape::ljt_nonode)
+      {
+        if (objtape.kind(attrnode) == Rps_LoaderJsonTape::ljk_array)
+          {
+            unsigned siz = objtape.count(attrnode);
+            RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass obz=" << obz << " attrs#" << siz);
+            unsigned entnode = objtape.first(attrnode);
+            for (unsigned ix=0; ix<siz; ix++)
+              {
+                if (objtape.kind(entnode) == Rps_LoaderJsonTape::ljk_object)
+                  {
+                    unsigned atnode = objtape.member(entnode, "at");
+                    unsigned vanode = objtape.member(entnode, "va");
+                    if (atnode != Rps_LoaderJsonTape::ljt_nonode
+                        && vanode != Rps_LoaderJsonTape::ljt_nonode)
+                      {
+                        auto atobr = tape_objref(objtape, atnode);
+                        auto atval = tape_value(objtape, vanode);
+                        obz->loader_put_attr(this, atobr, atval);
+                      }
+                  }
+                entnode = objtape.next(entnode);
+              }
+          }
+        else RPS_WARNOUT("parse_json_buffer_second_pass spacid=" << spacid
+                           << " lineno:" << lineno
+                           << " objid:" << objid
+                           << " bad attrjson:" << objtape.to_json(attrnode));
+      }
+    if (objtape.member(objnode, "magicattr") != Rps_LoaderJsonTape::ljt_nonode)
+      {
+        RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass magicattr objid=" << objid);
+        std::lock_guard<std::recursive_mutex> gu(ld_mtx);
+        char getfunambuf[sizeof(RPS_GETTERFUN_PREFIX)+8+Rps_Id::nbchars];
+        memset(getfunambuf, 0, sizeof(getfunambuf));
+        char obidbuf[32];
+        memset (obidbuf, 0, sizeof(obidbuf));
+        objid.to_cbuf24(obidbuf);
+        strcpy(getfunambuf, RPS_GETTERFUN_PREFIX);
+        strcat(getfunambuf+strlen(RPS_GETTERFUN_PREFIX), obidbuf);
+        RPS_ASSERT(strlen(getfunambuf)<sizeof(getfunambuf)-4);
+        void*funad = dlsym(rps_proghdl, getfunambuf);
+        if (!funad)
+          RPS_FATALOUT("cannot dlsym " << getfunambuf << " for magic attribute getter of objid:" <<  objid
+                       << " lineno:" << lineno << ", spacid:" << spacid
+                       << ":: " << dlerror());
+        obz->loader_put_magicattrgetter(this, reinterpret_cast<rps_magicgetterfun_t*>(funad));
+      }
+    if (objtape.member(objnode, "applying") != Rps_LoaderJsonTape::ljt_nonode)
+      {
+        RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass applying objid=" << objid);
+        std::lock_guard<std::recursive_mutex> gu(ld_mtx);
+        char appfunambuf[sizeof(RPS_APPLYINGFUN_PREFIX)+8+Rps_Id::nbchars];
+        memset(appfunambuf, 0, sizeof(appfunambuf));
+        char obidbuf[32];
+        memset (obidbuf, 0, sizeof(obidbuf));
+        objid.to_cbuf24(obidbuf);
+        strcpy(appfunambuf, RPS_APPLYINGFUN_PREFIX);
+        strcat(appfunambuf+strlen(RPS_APPLYINGFUN_PREFIX), obidbuf);
+        RPS_ASSERT(strlen(appfunambuf)<sizeof(appfunambuf)-4);
+        void*funad = dlsym(rps_proghdl, appfunambuf);
+        if (!funad)
+          RPS_FATALOUT("cannot dlsym " << appfunambuf << " for applying function of objid:" <<  objid
+                       << " lineno:" << lineno << ", spacid:" << spacid
+                       << ":: " << dlerror());
+        obz->loader_put_applyingfunction(this, reinterpret_cast<rps_applyingfun_t*>(funad));
+      }
+  }
+  unsigned paylnode = objtape.member(objnode, "payload");
+  if (paylnode != Rps_LoaderJsonTape::ljt_nonode)
     {
       rpsldpysig_t*pldfun = nullptr;
-      auto paylstr = objjson["payload"].asString();
+      if (objtape.kind(paylnode) != Rps_LoaderJsonTape::ljk_string
+          || objtape.count(paylnode) == 0)
+        RPS_FATALOUT("Rps_Loader::parse_json_buffer_second_pass spacid:" << spacid
+                     << " lineno:" << lineno
+                     << " objid:" << objid
+                     << " bad payload:" << objtape.to_json(paylnode));
+      std::string paylstr (objtape.string_at(paylnode));
       {
         std::lock_guard<std::recursive_mutex> gu(ld_mtx);
         auto ldit = ld_payloadercache.find(paylstr);
@@ -620,6 +1791,9 @@ Rps_Loader::parse_json_buffer_second_pass (Rps_Id spacid, unsigned lineno,
       };
       if (pldfun)
         {
+          // payload loaders get a jsoncpp object, but without the
+          // components and attributes already loaded from the tape
+          Json::Value objjson = objtape.to_json(objnode, "comps", "attrs");
           (*pldfun)(obz,this,objjson,spacid,lineno);
         }
       else
@@ -632,88 +1806,341 @@ Rps_Loader::parse_json_buffer_second_pass (Rps_Id spacid, unsigned lineno,
                        << std::endl);
         }
     }
+  {
+    std::lock_guard<std::recursive_mutex> gu(ld_mtx);
+    ld_fillingobjset.erase(obz);
+  }
   RPS_DEBUG_LOG(LOAD, "parse_json_buffer_second_pass end objid=" << objid << " #" << count
                 << std::endl);
+  return mtim;
 } // end of Rps_Loader::parse_json_buffer_second_pass
 
+
+Rps_ObjectRef
+Rps_Loader::tape_objref(const Rps_LoaderJsonTape&tape, unsigned node)
+{
+  Rps_Id oid;
+  if (node != Rps_LoaderJsonTape::ljt_nonode
+      && tape.kind(node) == Rps_LoaderJsonTape::ljk_string
+      && tape.count(node) > 0)
+    {
+      std::string_view oidsv = tape.string_at(node);
+      if ((oid = Rps_Id(std::string(oidsv))).valid())
+        {
+          Rps_ObjectRef obr= find_object_by_oid(oid);
+          if (!obr)
+            {
+              RPS_WARNOUT("unknown oid " << oid);
+              throw  std::runtime_error(std::string{"unknown oid "} + oid.to_string());
+            }
+          return obr;
+        }
+    }
+  // the rare and strange cases are reported by the jsoncpp variant
+  return Rps_ObjectRef(node != Rps_LoaderJsonTape::ljt_nonode
+                       ? tape.to_json(node) : Json::Value(Json::nullValue), this);
+} // end Rps_Loader::tape_objref
+
+
+Rps_Value
+Rps_Loader::tape_value(const Rps_LoaderJsonTape&tape, unsigned node)
+{
+  RPS_ASSERT(node != Rps_LoaderJsonTape::ljt_nonode);
+  switch (tape.kind(node))
+    {
+    case Rps_LoaderJsonTape::ljk_null:
+      return Rps_Value(nullptr);
+    case Rps_LoaderJsonTape::ljk_int:
+      return Rps_Value((intptr_t)tape.int_at(node), Rps_Value::Rps_IntTag{});
+    case Rps_LoaderJsonTape::ljk_real:
+    {
+      double d = tape.real_at(node);
+      RPS_ASSERT(!std::isnan(d));
+      return Rps_Value(d, Rps_Value::Rps_DoubleTag{});
+    }
+    case Rps_LoaderJsonTape::ljk_string:
+    {
+      std::string_view sv = tape.string_at(node);
+      if (sv.size() == Rps_Id::nbchars && sv[0] == '_'
+          && std::all_of(sv.begin()+1, sv.end(),
+                         [](char c)
+      {
+        return strchr(Rps_Id::b62digits, c) != nullptr;
+        }))
+      return Rps_ObjectValue(tape_objref(tape, node));
+      return Rps_StringValue(sv.data(), (int)sv.size());
+    }
+    case Rps_LoaderJsonTape::ljk_object:
+    {
+      unsigned strnode = Rps_LoaderJsonTape::ljt_nonode;
+      if (tape.count(node) == 1
+          && ((strnode = tape.member(node, "str")) != Rps_LoaderJsonTape::ljt_nonode
+              || (strnode = tape.member(node, "string")) != Rps_LoaderJsonTape::ljt_nonode)
+          && tape.kind(strnode) == Rps_LoaderJsonTape::ljk_string)
+        {
+          std::string_view sv = tape.string_at(strnode);
+          return Rps_StringValue(sv.data(), (int)sv.size());
+        }
+      unsigned vtypnode = tape.member(node, "vtype");
+      if (vtypnode == Rps_LoaderJsonTape::ljt_nonode
+          || tape.kind(vtypnode) != Rps_LoaderJsonTape::ljk_string)
+        break;
+      std::string_view vtyp = tape.string_at(vtypnode);
+      if (vtyp == "set")
+        {
+          unsigned elemnode = tape.member(node, "elem");
+          if (elemnode == Rps_LoaderJsonTape::ljt_nonode
+              || tape.kind(elemnode) != Rps_LoaderJsonTape::ljk_array)
+            break;
+          unsigned siz = tape.count(elemnode);
+          std::vector<Rps_ObjectRef> vecobr;
+          vecobr.reserve(siz);
+          unsigned curnode = tape.first(elemnode);
+          for (unsigned ix=0; ix<siz; ix++)
+            {
+              auto obrelem = tape_objref(tape, curnode);
+              if (obrelem)
+                vecobr.push_back(obrelem);
+              curnode = tape.next(curnode);
+            }
+          return Rps_SetValue(vecobr);
+        }
+      else if (vtyp == "tuple")
+        {
+          unsigned compnode = tape.member(node, "comp");
+          if (compnode == Rps_LoaderJsonTape::ljt_nonode
+              || tape.kind(compnode) != Rps_LoaderJsonTape::ljk_array)
+            break;
+          unsigned siz = tape.count(compnode);
+          Rps_TupleBuilder tupb(siz);
+          unsigned curnode = tape.first(compnode);
+          for (unsigned ix=0; ix<siz; ix++)
+            {
+              tupb.push_back(tape_objref(tape, curnode));
+              curnode = tape.next(curnode);
+            }
+          return Rps_Value(tupb.seal(), Rps_Value::Rps_ValPtrTag{});
+        }
+      else if (vtyp == "closure")
+        {
+          unsigned fnnode = tape.member(node, "fn");
+          unsigned envnode = tape.member(node, "env");
+          if (fnnode == Rps_LoaderJsonTape::ljt_nonode
+              || envnode == Rps_LoaderJsonTape::ljt_nonode)
+            break;
+          auto funobr = tape_objref(tape, fnnode);
+          if (tape.kind(envnode) != Rps_LoaderJsonTape::ljk_array)
+            {
+              RPS_WARNOUT("Rps_Loader::tape_value bad closure funobr=" << funobr);
+              break;
+            }
+          unsigned siz = tape.count(envnode);
+          Rps_ClosureBuilder clob(funobr, siz);
+          unsigned curnode = tape.first(envnode);
+          for (unsigned ix=0; ix<siz; ix++)
+            {
+              clob.push_back(tape_value(tape, curnode));
+              curnode = tape.next(curnode);
+            }
+          Rps_ClosureValue thisclos(Rps_Value(clob.seal(), Rps_Value::Rps_ValPtrTag{}));
+          unsigned metaobnode = tape.member(node, "metaobj");
+          if (metaobnode != Rps_LoaderJsonTape::ljt_nonode)
+            {
+              unsigned metarknode = tape.member(node, "metarank");
+              int32_t metark = (metarknode != Rps_LoaderJsonTape::ljt_nonode
+                                && tape.kind(metarknode) == Rps_LoaderJsonTape::ljk_int)
+                               ? (int32_t)tape.int_at(metarknode) : 0;
+              auto metaobr = tape_objref(tape, metaobnode);
+              thisclos->put_persistent_metadata(metaobr, metark);
+            }
+          return thisclos;
+        }
+      // instances may have to be completed later in a todo function,
+      // and JSON values are kept as such, so both need a jsoncpp value
+      else if (vtyp == "instance" || vtyp == "json")
+        return Rps_Value(tape.to_json(node), this);
+      else
+        RPS_WARNOUT("strange Rps_Loader::tape_value vtype=" << vtyp);
+    }
+    break;
+    default:
+      break;
+    }
+  RPS_WARNOUT("unimplemented Rps_Loader::tape_value" << std::endl
+              << "jv=" << tape.to_json(node));
+  return Rps_Value(nullptr);
+} // end Rps_Loader::tape_value
+
 ////////////////////////////////////////////////////////////////
 
 
+void
+Rps_Loader::second_pass_chunk(chunk_st& chunk)
+{
+  try
+    {
+      chunk.chk_mtime =
+        parse_json_buffer_second_pass(chunk.chk_spacid, chunk.chk_lineno,
+                                      chunk.chk_objid, chunk.chk_objview, chunk.chk_count,
+                                      chunk.chk_tapewords, chunk.chk_nbtapewords);
+    }
+  catch (const std::exception& exc)
+    {
+      RPS_FATALOUT("failed second pass in space " << chunk.chk_spacid
+                   << " objid:" << chunk.chk_objid
+                   << " line#" << chunk.chk_lineno
+                   << std::endl
+                   << "... got exception of type "
+                   << typeid(exc).name()
+                   << ":"
+                   << exc.what());
+    };
+} // end of Rps_Loader::second_pass_chunk
+
+
+/// the body of loading threads, and of the main thread (with ix 0)
+/// during the second pass
+void
+Rps_Loader::run_second_pass_worker(std::vector<chunk_st>* pchunkvec, std::atomic<size_t>* pnextchunk, int ix)
+{
+  RPS_ASSERT(pchunkvec != nullptr);
+  RPS_ASSERT(pnextchunk != nullptr);
+  if (ix > 0)
+    {
+      char pthname[16];
+      memset (pthname, 0, sizeof(pthname));
+      snprintf(pthname, sizeof(pthname), "rps-ldw#%hd", (short) ix);
+      pthread_setname_np(pthread_self(), pthname);
+    }
+  const size_t nbchunks = pchunkvec->size();
+  for (;;)
+    {
+      size_t startix = pnextchunk->fetch_add(ld_chunkbatch);
+      if (startix >= nbchunks)
+        break;
+      size_t endix = std::min(startix + ld_chunkbatch, nbchunks);
+      for (size_t cix = startix; cix < endix; cix++)
+        second_pass_chunk((*pchunkvec)[cix]);
+    }
+} // end of Rps_Loader::run_second_pass_worker
+
+
 void
 Rps_Loader::second_pass_space(Rps_Id spacid)
 {
   RPS_DEBUG_LOG(LOAD, "Rps_Loader::second_pass_space start spacid:" << spacid
                 << std::endl << RPS_FULL_BACKTRACE_HERE(0, "RpsLoader::second_pass_space"));
-  auto spacepath = load_real_path(space_file_path(spacid));
-  std::ifstream ins(spacepath);
-  unsigned lincnt = 0;
-  unsigned obcnt = 0;
-  Rps_Id prevoid;
-  unsigned prevlin=0;
-  std::string objbuf;
-  for (std::string linbuf; std::getline(ins, linbuf); )
+  for (chunk_st& curchunk: ld_chunkvec)
+    if (curchunk.chk_spacid == spacid)
+      second_pass_chunk(curchunk);
+  RPS_DEBUG_LOG(LOAD, "Rps_Loader::second_pass_space end spacid:" << spacid);
+} // end of Rps_Loader::second_pass_space
+
+
+/// Filling objects, by their payload loaders and by the todo
+/// functions, touches their mtime, so the loaded ones are put back
+/// afterwards. Then every loaded space gets its dump record, used by
+/// an incremental dump into the same directory.
+void
+Rps_Loader::restore_loaded_mtimes_and_dump_records(void)
+{
+  std::map<Rps_Id,Rps_PayloadSpace::space_dump_record> recmap;
+  for (const chunk_st& curchunk: ld_chunkvec)
     {
-      lincnt++;
-      if (linbuf.size() > 0 && linbuf[0] == '#')
+      Rps_ObjectRef obr = find_object_by_oid(curchunk.chk_objid);
+      RPS_ASSERT(obr);
+      if (curchunk.chk_mtime > 0.0)
+        obr->loader_set_mtime(this, curchunk.chk_mtime);
+      recmap[curchunk.chk_spacid].sdr_members.push_back(curchunk.chk_objid);
+    }
+  std::string realtopdir;
+  {
+    char* rp = realpath(ld_topdir.c_str(), nullptr);
+    if (!rp)
+      {
+        RPS_WARN("loader cannot get real path of %s: %m", ld_topdir.c_str());
+        return;
+      }
+    realtopdir = rp;
+    free (rp);
+  }
+  double nowt = rps_wallclock_real_time();
+  for (auto& it: recmap)
+    {
+      Rps_ObjectRef obrspace = find_object_by_oid(it.first);
+      if (!obrspace || ld_journaledspaces.find(it.first) != ld_journaledspaces.end())
         continue;
-      Rps_Id curobjid;
-      if (is_object_starting_line(spacid,lincnt,linbuf,&curobjid))
+      std::sort(it.second.sdr_members.begin(), it.second.sdr_members.end());
+      it.second.sdr_dir = realtopdir;
+      it.second.sdr_time = nowt;
+      Rps_PayloadSpace::put_dump_record(obrspace, it.second);
+    }
+} // end of Rps_Loader::restore_loaded_mtimes_and_dump_records
+
+
+/// Replay the committed chunks of the RPS_JOURNAL_FILE, if any, after
+/// the first pass: the last chunk of every journaled object replaces
+/// the chunk of its space file, or makes that object, so the second
+/// pass fills it from its journaled state.
+void
+Rps_Loader::replay_journal(void)
+{
+  std::string journalpath = ld_topdir + "/" + RPS_JOURNAL_FILE;
+  if (access(journalpath.c_str(), R_OK))
+    return;
+  double startrealt = rps_elapsed_real_time();
+  ld_journalview = rps_map_readonly_file(journalpath);
+  std::map<Rps_Id,Rps_JournalChunk> lastchunkmap;
+  unsigned nbgroups =
+    rps_journal_each_committed_chunk(ld_journalview, [&](const Rps_JournalChunk&jc)
+  {
+    lastchunkmap[jc.jc_objid] = jc;
+  });
+  if (lastchunkmap.empty())
+    return;
+  std::unordered_map<Rps_Id,size_t,Rps_Id::Hasher> chunkixmap;
+  chunkixmap.reserve(ld_chunkvec.size());
+  for (size_t chix=0; chix<ld_chunkvec.size(); chix++)
+    chunkixmap.insert({ld_chunkvec[chix].chk_objid, chix});
+  unsigned nbreplaced = 0, nbmade = 0;
+  for (auto& it: lastchunkmap)
+    {
+      const Rps_JournalChunk& jc = it.second;
+      if (ld_mapobjects.find(jc.jc_spacid) == ld_mapobjects.end()
+          && lastchunkmap.find(jc.jc_spacid) == lastchunkmap.end())
         {
-          obcnt++;
-          RPS_DEBUG_LOG(LOAD, "secondpass lincnt="<< lincnt
-                        << " curobjid=" << curobjid
-                        << " obcnt=" << obcnt);
-          if (objbuf.size() > 0 && prevoid && prevlin>0)
-            {
-              try
-                {
-                  parse_json_buffer_second_pass(spacid, prevlin, prevoid, objbuf, obcnt);
-                }
-              catch (const std::exception& exc)
-                {
-                  RPS_FATALOUT("failed second pass in space " << spacid
-                               << " prevoid:" << prevoid
-                               << " line#" << prevlin
-                               << std::endl
-                               << "... got exception of type "
-                               << typeid(exc).name()
-                               << ":"
-                               << exc.what());
-                };
-              prevoid = Rps_Id(nullptr);
-            }
-          objbuf.clear();
-          objbuf = linbuf + '\n';
-          prevoid = curobjid;
-          prevlin = lincnt;
+          RPS_WARNOUT("Rps_Loader::replay_journal ignoring object " << jc.jc_objid
+                      << " of unknown space " << jc.jc_spacid
+                      << " line#" << jc.jc_lineno << " in " << journalpath);
+          continue;
         }
-      else if (objbuf.size() > 0)
+      chunk_st newchunk{jc.jc_spacid, jc.jc_objid, jc.jc_lineno, 0, jc.jc_view,
+                        nullptr, 0, 0.0};
+      auto itix = chunkixmap.find(jc.jc_objid);
+      if (itix != chunkixmap.end())
         {
-          objbuf += linbuf;
-          objbuf += '\n';
+          ld_journaledspaces.insert(ld_chunkvec[itix->second].chk_spacid);
+          ld_chunkvec[itix->second] = newchunk;
+          nbreplaced++;
         }
-    } // end for getline
-  if (objbuf.size() > 0 && prevoid && prevlin>0)
-    {
-      try
+      else if (ld_mapobjects.find(jc.jc_objid) == ld_mapobjects.end())
         {
-          parse_json_buffer_second_pass(spacid, prevlin, prevoid, objbuf, obcnt);
+          Rps_ObjectRef obref(Rps_ObjectZone::make_loaded(jc.jc_objid, this));
+          ld_mapobjects.insert({jc.jc_objid, obref});
+          ld_chunkvec.push_back(newchunk);
+          nbmade++;
         }
-      catch (const std::exception& exc)
-        {
-          RPS_FATALOUT("failed second pass in " << spacid
-                       << " prevoid:" << prevoid
-                       << " line#" << prevlin
-                       << std::endl
-                       << "... got exception of type "
-                       << typeid(exc).name()
-                       << ":"
-                       << exc.what());
-        };
-      prevoid = Rps_Id(nullptr);
-    };
-  RPS_DEBUG_LOG(LOAD, "Rps_Loader::second_pass_space end spacid:" << spacid);
-} // end of Rps_Loader::second_pass_space
+      else
+        continue;
+      ld_journaledspaces.insert(jc.jc_spacid);
+    }
+  char realtbuf[32];
+  memset(realtbuf, 0, sizeof(realtbuf));
+  snprintf(realtbuf, sizeof(realtbuf), "%.3f", rps_elapsed_real_time() - startrealt);
+  RPS_INFORMOUT("replaying journal " << journalpath << " of " << nbgroups << " groups: "
+                << nbreplaced << " objects replaced and " << nbmade << " made in "
+                << realtbuf << " elapsed seconds");
+} // end Rps_Loader::replay_journal
 
 
 void
@@ -722,32 +2149,68 @@ Rps_Loader::load_all_state_files(void)
   RPS_DEBUG_LOG(LOAD, "Rps_Loader::load_all_state_files start this@" << (void*)this
                 << std::endl << RPS_FULL_BACKTRACE_HERE(0, "RpsLoader::load_all_state_files"));
   int spacecnt1 = 0, spacecnt2 = 0;
-  int todocount = 0;
-  for (Rps_Id spacid: ld_spaceset)
-    {
-      first_pass_space(spacid);
-      spacecnt1++;
-    }
+  /// a valid binary snapshot replaces the first pass, and gives the
+  /// already parsed tape of every object to the second one
+  if (ld_snapshotchecksum.empty() || !load_snapshot())
+    for (Rps_Id spacid: ld_spaceset)
+      {
+        first_pass_space(spacid);
+        spacecnt1++;
+      }
   RPS_NOPRINTOUT("loaded " << spacecnt1 << " space files in first pass");
+  replay_journal();
   initialize_constant_objects();
-  /// conceptually, the second pass might be done in parallel
-  /// (multi-threaded, with different threads working on different
-  /// spaces), but this require more clever locking and
-  /// synchronization, so might be done after reaching our milestone#2
-  for (Rps_Id spacid: ld_spaceset)
-    {
-      run_some_todo_functions();
-      second_pass_space(spacid);
-      spacecnt2++;
-    }
+  /// The second pass is multi-threaded: the object chunks of every
+  /// space, found by the first pass, are parsed and filled by
+  /// rps_nbjobs threads taking batches of chunks, each object being
+  /// filled from its tape with its mutex locked, then given its
+  /// payload without it. No thread ever waits for the mutex of
+  /// another object, see Rps_InstanceZone::load_from_json. The todo
+  /// functions added meanwhile
+  /// are run only after all the threads are joined, so they see every
+  /// object filled.
+  std::vector<chunk_st>& chunkvec = ld_chunkvec;
+  spacecnt2 = (int) ld_mappedspaces.size();
+  double startrealt = rps_elapsed_real_time();
+  double startcput = rps_process_cpu_time();
+  unsigned nbthreads = (rps_nbjobs > 1) ? (unsigned) rps_nbjobs : 1;
+  // no thread without a batch of chunks to fill
+  if (nbthreads > chunkvec.size() / ld_chunkbatch + 1)
+    nbthreads = chunkvec.size() / ld_chunkbatch + 1;
+  {
+    std::atomic<size_t> nextchunk(0);
+    std::vector<std::thread> thrvec;
+    thrvec.reserve(nbthreads);
+    for (unsigned thix = 1; thix < nbthreads; thix++)
+      thrvec.emplace_back(&Rps_Loader::run_second_pass_worker, this,
+                          &chunkvec, &nextchunk, (int)thix);
+    run_second_pass_worker(&chunkvec, &nextchunk, 0);
+    for (std::thread& thr: thrvec)
+      thr.join();
+  }
+  double realt = rps_elapsed_real_time() - startrealt;
+  double cput = rps_process_cpu_time() - startcput;
+  /// the barrier: every object is filled, run the todo functions
   while (run_some_todo_functions()>0)
     {
       // we sleep a tiny bit, so elapsed time is growing...
       usleep(20);
     };
+  restore_loaded_mtimes_and_dump_records();
   RPS_DEBUG_LOG(LOAD, "Rps_Loader::load_all_state_files end this@" << (void*)this);
-  RPS_INFORMOUT("loaded " << spacecnt1 << " space files in second pass with "
-                << ld_mapobjects.size() << " objects and " << todocount << " todos" << std::endl);
+  char realtbuf[32];
+  char cputbuf[32];
+  memset(realtbuf, 0, sizeof(realtbuf));
+  memset(cputbuf, 0, sizeof(cputbuf));
+  snprintf(realtbuf, sizeof(realtbuf), "%.3f", realt);
+  snprintf(cputbuf, sizeof(cputbuf), "%.3f", cput);
+  // the speedup needs a run with --jobs=1 to compare the elapsed
+  // times, so only both times and the thread count are shown
+  RPS_INFORMOUT("loaded " << spacecnt2 << " space files in second pass with "
+                << ld_mapobjects.size() << " objects and " << ld_todocount << " todos" << std::endl
+                << "... " << chunkvec.size() << " object chunks filled by " << nbthreads
+                << " threads in " << realtbuf << " elapsed seconds, "
+                << cputbuf << " cpu seconds" << std::endl);
   RPS_DEBUG_LOG(LOAD, "Rps_Loader::load_all_state_files end this@" << (void*)this
                 << std::endl << RPS_FULL_BACKTRACE_HERE(0, "RpsLoader::load_all_state_files"));
 } // end Rps_Loader::load_all_state_files
@@ -768,8 +2231,7 @@ Rps_Loader::string_of_loaded_file(const std::string&relpath)
   for (std::string linbuf; std::getline(inp, linbuf); )
     {
       lincnt++;
-      if (u8_check(reinterpret_cast<const uint8_t*> (linbuf.c_str()),
-                   linbuf.size()))
+      if (rps_utf8_check_count(linbuf.c_str(), linbuf.size(), nullptr))
         {
           RPS_WARN("non UTF8 line#%d in %s:\n%s",
                    lincnt, fullpath.c_str(), linbuf.c_str());
@@ -831,8 +2293,8 @@ Rps_Value::Rps_Value(const Json::Value &jv, Rps_Loader*ld)
       *this = Rps_StringValue(str);
       return;
     }
-  else if (jv.isObject() && jv.size()==1 && jv.isMember("string")
-           && (jcomp=jv["string"]).isString())
+  else if (jv.isObject() && jv.size()==1
+           && ((jcomp=jv["str"]).isString() || (jcomp=jv["string"]).isString()))
     {
       str=jcomp.asString();
       *this = Rps_StringValue(str);
@@ -842,11 +2304,11 @@ Rps_Value::Rps_Value(const Json::Value &jv, Rps_Loader*ld)
            && ((jvtype=jv["vtype"]).isString())
            && !(str=jvtype.asString()).empty())
     {
-      if (str == "set" && siz==2 && jv.isMember("elem")
-          && (jcomp=jv["elem"]).isArray()
-          && (siz=jcomp.size()))
+      if (str == "set" && jv.isMember("elem")
+          && (jcomp=jv["elem"]).isArray())
         {
           std::set<Rps_ObjectRef> setobr;
+          siz = jcomp.size();
           for (int ix=0; ix<(int)siz; ix++)
             {
               auto obrelem = Rps_ObjectRef(jcomp[ix], ld);
@@ -856,30 +2318,28 @@ Rps_Value::Rps_Value(const Json::Value &jv, Rps_Loader*ld)
           *this= Rps_SetValue(setobr);
           return;
         }
-      else if (str == "tuple" && siz==2 && jv.isMember("elem")
-               && (jcomp=jv["comp"]).isArray()
-               && (siz=jcomp.size()))
+      else if (str == "tuple" && jv.isMember("comp")
+               && (jcomp=jv["comp"]).isArray())
         {
-          std::vector<Rps_ObjectRef> vecobr;
-          vecobr.reserve(siz);
+          siz = jcomp.size();
+          Rps_TupleBuilder tupb(siz);
           for (int ix=0; ix<(int)siz; ix++)
-            {
-              auto obrcomp = Rps_ObjectRef(jcomp[ix], ld);
-              vecobr.push_back(obrcomp);
-            };
-          *this= Rps_TupleValue(vecobr);
+            tupb.push_back(Rps_ObjectRef(jcomp[ix], ld));
+          *this= Rps_Value(tupb.seal(), Rps_ValPtrTag{});
           return;
         }
-      else if (str == "instance" &&  jv.isMember("class")
-               && (jcomp=jv["class"]).isString()
+      else if (str == "instance" &&  jv.isMember("iclass")
+               && (jcomp=jv["iclass"]).isString()
               )
         {
           *this = Rps_InstanceZone::load_from_json(ld, jv);
+          return;
         }
       else if (str == "json" && jv.isMember("json")
               )
         {
           *this = Rps_JsonZone::load_from_json(ld, jv);
+          return;
         }
       else if (str == "closure"
                && jv.isMember("fn")
@@ -893,14 +2353,10 @@ Rps_Value::Rps_Value(const Json::Value &jv, Rps_Loader*ld)
           if (jenv.isArray())
             {
               auto siz = jenv.size();
-              std::vector<Rps_Value> vecenv;
-              vecenv.reserve(siz+1);
+              Rps_ClosureBuilder clob(funobr, siz);
               for (int ix=0; ix <(int)siz; ix++)
-                {
-                  auto curval = Rps_Value(jenv[ix], ld);
-                  vecenv.push_back(curval);
-                };
-              Rps_ClosureValue thisclos(funobr, vecenv);;
+                clob.push_back(Rps_Value(jenv[ix], ld));
+              Rps_ClosureValue thisclos(Rps_Value(clob.seal(), Rps_ValPtrTag{}));
               RPS_NOPRINTOUT("closure thisclos=" << thisclos);
               *this = thisclos;
               RPS_NOPRINTOUT("closure this is " << *this << std::endl << "jv=" << jv);
@@ -963,8 +2419,12 @@ Rps_InstanceZone::load_from_json(Rps_Loader*ld, const Json::Value& jv)
     }
   {
     RPS_ASSERT(obclass);
-    std::lock_guard<std::recursive_mutex> guclass (*(obclass->objmtxptr()));
-    auto clpayl = obclass->get_classinfo_payload();
+    // the class may be filled by another loading thread, which could
+    // itself wait for an object we are filling; then the instance is
+    // completed in a todo function, like for a class not yet loaded
+    std::unique_lock<std::recursive_mutex> guclass (*(obclass->objmtxptr()), std::try_to_lock);
+    auto clpayl = (guclass.owns_lock() && !ld->is_being_filled(obclass))
+                  ? obclass->get_classinfo_payload() : nullptr;
     const Rps_SetOb*setat = nullptr;
     if (clpayl
         && (attrmap.empty() || (setat=clpayl->attributes_set())))
@@ -1005,7 +2465,7 @@ void
 Rps_InstanceZone::fill_loaded_instance_from_json(Rps_Loader*ld,Rps_ObjectRef obclass, const Json::Value& jv)
 {
   RPS_ASSERT(ld != nullptr);
-  RPS_ASSERT((int)cnt() == jv["isiz"].asInt());
+  RPS_ASSERT((int)cnt() == jv["isize"].asInt());
   auto jattrs = jv["iattrs"];
   auto nbattrs = jattrs.size();
   auto jcomps = jv["icomps"];
@@ -1033,8 +2493,10 @@ Rps_InstanceZone::fill_loaded_instance_from_json(Rps_Loader*ld,Rps_ObjectRef obc
     }
   {
     RPS_ASSERT(obclass);
-    std::lock_guard<std::recursive_mutex> guclass (*(obclass->objmtxptr()));
-    auto clpayl = obclass->get_classinfo_payload();
+    // never wait for the class, like in load_from_json
+    std::unique_lock<std::recursive_mutex> guclass (*(obclass->objmtxptr()), std::try_to_lock);
+    auto clpayl = (guclass.owns_lock() && !ld->is_being_filled(obclass))
+                  ? obclass->get_classinfo_payload() : nullptr;
     const Rps_SetOb*attrset = nullptr;
     if (clpayl
         && (attrmap.empty() || (attrset=clpayl->attributes_set())))
@@ -1059,10 +2521,15 @@ Rps_InstanceZone::fill_loaded_instance_from_json(Rps_Loader*ld,Rps_ObjectRef obc
             sonarr[2*ix] = curat;
             sonarr[2*ix+1] = curval;
           }
+        // components come after the slots of every class attribute,
+        // like in make_from_attributes_components
+        const Rps_SetOb*classattrset = clpayl->attributes_set();
+        unsigned nbclassattrs = classattrset?classattrset->cardinal():0;
+        RPS_ASSERT(2*nbclassattrs+nbcomps == cnt());
         for (int cix=0; cix<(int)nbcomps; cix++)
           {
             Rps_Value curcomp = compvec[cix];
-            sonarr[2*nbattrs+cix] = curcomp;
+            sonarr[2*nbclassattrs+cix] = curcomp;
           }
       }
     else
@@ -1078,31 +2545,482 @@ Rps_InstanceZone::fill_loaded_instance_from_json(Rps_Loader*ld,Rps_ObjectRef obc
 
 
 
-Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)
-  : Rps_ObjectRef(nullptr)
+Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)
+  : Rps_ObjectRef(nullptr)
+{
+  RPS_ASSERT(ld != nullptr);
+  std::string str = "";
+  Rps_Id oid;
+  if (jv.isString() && !((str=jv.asString()).empty()) && (oid = Rps_Id(str)).valid())
+    {
+      Rps_ObjectRef obr= ld->find_object_by_oid(oid);
+      if (!obr)
+        {
+          RPS_WARNOUT("unknown oid " << oid);
+          throw  std::runtime_error(std::string{"unknown oid "} + oid.to_string());
+        }
+      *this = obr;
+      return;
+    }
+  RPS_WARNOUT("partly unimplemented Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)"
+              << std::endl << " jv=" << jv
+              << RPS_FULL_BACKTRACE_HERE(2,"strange ObjectRef::Rps_ObjectRef"));
+  throw  std::runtime_error("partly unimplemented Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)");
+#warning partly unimplemented Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)
+} // end Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)
+
+
+
+
+
+//////////////////////////////////////////////// dumper JSON emitter
+/// The dumper does not build a jsoncpp DOM for every object, nor
+/// pretty-print it thru a Json::StreamWriter into the std::ofstream:
+/// it appends the JSON text of the object to a buffer, reused by
+/// each writing thread, and writes that buffer in big blocks. The
+/// text is byte for byte what the Json::StreamWriter of
+/// du_jsonwriterbuilder, with a one space indentation and no
+/// comments, would write, so the space files don't change; in
+/// particular members of objects are sorted, short arrays of scalars
+/// fit on one line, and nested arrays and objects start on their own
+/// line. But integral doubles have no ".0" appended, as in the
+/// committed persistore/ files, see make test-dump-roundtrip. Values
+/// which are not scalars, and payload contents, still go thru a
+/// Json::Value, written by write_value.
+class Rps_DumperJsonEmitter
+{
+  std::string dje_buf;		// the emitted text
+  size_t dje_depth;		// the indentation depth
+  bool dje_indented;		// the line is already indented
+  static constexpr unsigned dje_rightmargin = 74;
+  void write_indent(void)
+  {
+    dje_buf.push_back('\n');
+    dje_buf.append(dje_depth, ' ');
+  };
+  void write_with_indent(const char*str)
+  {
+    if (!dje_indented)
+      write_indent();
+    dje_buf.append(str);
+    dje_indented = false;
+  };
+  bool is_scalar_array(const Json::Value&jv) const;
+public:
+  Rps_DumperJsonEmitter() : dje_buf(), dje_depth(0), dje_indented(true)
+  {
+    dje_buf.reserve(1<<16);
+  };
+  std::string& buffer(void)
+  {
+    return dje_buf;
+  };
+  /// start a new root value, like Json::StreamWriter::write does
+  void begin_root(void)
+  {
+    dje_depth = 0;
+    dje_indented = true;
+  };
+  /// scalars are appended where they go
+  void write_null(void)
+  {
+    dje_buf.append("null");
+  };
+  void write_bool(bool b)
+  {
+    dje_buf.append(b?"true":"false");
+  };
+  void write_int(std::int64_t i);
+  void write_uint(std::uint64_t u);
+  void write_real(double d);
+  void write_string(const char*str, size_t len);
+  void write_string(std::string_view sv)
+  {
+    write_string(sv.data(), sv.size());
+  };
+  void write_oid(const Rps_Id&oid)
+  {
+    char cbuf[Rps_Id::buflen];
+    oid.to_cbuf24(cbuf);
+    write_string(cbuf, strlen(cbuf));
+  };
+  void write_empty_array(void)
+  {
+    dje_buf.append("[]");
+  };
+  void write_value(const Json::Value&jv);
+  /// objects are written by open_object, then for every member,
+  /// sorted by name, member_name followed by its value, then
+  /// close_object; there should be at least one member
+  void open_object(void)
+  {
+    write_with_indent("{");
+    dje_depth++;
+  };
+  void member_name(const char*name, size_t len, bool first)
+  {
+    if (!first)
+      dje_buf.push_back(',');
+    if (!dje_indented)
+      write_indent();
+    write_string(name, len);
+    dje_indented = false;
+    dje_buf.append(" : ");
+  };
+  void close_object(void)
+  {
+    dje_depth--;
+    write_with_indent("}");
+  };
+  /// an array with some non-scalar element, or too long, has one
+  /// element per line: open_multiline_array, then element_start
+  /// before and element_end after each element, then
+  /// close_multiline_array; otherwise it is on one line
+  void open_multiline_array(void)
+  {
+    write_with_indent("[");
+    dje_depth++;
+  };
+  void element_start(bool first)
+  {
+    if (!first)
+      dje_buf.push_back(',');
+    if (!dje_indented)
+      write_indent();
+    dje_indented = true;
+  };
+  void element_end(void)
+  {
+    dje_indented = false;
+  };
+  void close_multiline_array(void)
+  {
+    dje_depth--;
+    write_with_indent("]");
+  };
+  /// a one line array of n scalars is written by appending
+  /// open_line_array(n), then each element preceded by
+  /// line_array_separator but the first one, then calling
+  /// close_line_array with the offset given by open_line_array; it
+  /// returns false, having removed that text, if the line is too
+  /// long, and the array should be written on multiple lines
+  static constexpr size_t dje_nolinearray = (size_t)-1;
+  size_t open_line_array(size_t nbelem)
+  {
+    if (nbelem * 3 >= dje_rightmargin)
+      return dje_nolinearray;
+    size_t off = dje_buf.size();
+    dje_buf.append("[ ");
+    return off;
+  };
+  void line_array_separator(void)
+  {
+    dje_buf.append(", ");
+  };
+  bool close_line_array(size_t off)
+  {
+    RPS_ASSERT(off != dje_nolinearray && off <= dje_buf.size());
+    dje_buf.append(" ]");
+    if (dje_buf.size() - off >= dje_rightmargin)
+      {
+        dje_buf.resize(off);
+        return false;
+      }
+    return true;
+  };
+  /// give up a one line array, e.g. on a non-scalar element
+  void cancel_line_array(size_t off)
+  {
+    RPS_ASSERT(off != dje_nolinearray && off <= dje_buf.size());
+    dje_buf.resize(off);
+  };
+};				// end class Rps_DumperJsonEmitter
+
+void
+Rps_DumperJsonEmitter::write_int(std::int64_t i)
+{
+  char buf[24];
+  auto res = std::to_chars(buf, buf+sizeof(buf), i);
+  dje_buf.append(buf, res.ptr - buf);
+} // end Rps_DumperJsonEmitter::write_int
+
+void
+Rps_DumperJsonEmitter::write_uint(std::uint64_t u)
+{
+  char buf[24];
+  auto res = std::to_chars(buf, buf+sizeof(buf), u);
+  dje_buf.append(buf, res.ptr - buf);
+} // end Rps_DumperJsonEmitter::write_uint
+
+/// like the jsoncpp which wrote persistore/, with 17 significant
+/// digits and no ".0" added to integral doubles, e.g. most mtimes, and
+/// the non finite doubles written as it does
+void
+Rps_DumperJsonEmitter::write_real(double d)
+{
+  if (!std::isfinite(d))
+    {
+      if (std::isnan(d))
+        dje_buf.append("null");
+      else if (d < 0)
+        dje_buf.append("-1e+9999");
+      else
+        dje_buf.append("1e+9999");
+      return;
+    }
+  char buf[40];
+  memset (buf, 0, sizeof(buf));
+  int len = snprintf(buf, sizeof(buf), "%.17g", d);
+  RPS_ASSERT(len > 0 && len < (int)sizeof(buf));
+  for (int ix=0; ix<len; ix++)
+    if (buf[ix] == ',')
+      buf[ix] = '.';
+  dje_buf.append(buf, len);
+} // end Rps_DumperJsonEmitter::write_real
+
+/// Check that doubles, notably infinite or out of range ones, are
+/// read back by the loader tape as written by the dumper emitter;
+/// gives the number of mismatches. A negative zero is written as -0,
+/// which is read, like by jsoncpp, as the integer 0, so is not
+/// checked here.
+int
+rps_json_tape_real_test(void)
+{
+  const double realtab[] =
+  {
+    0.0, 1.0, 3.0, -2.5, 0.1, 1605162639.9200001, 1612033877.0,
+    1e300, -1e300, std::numeric_limits<double>::max(),
+    -std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+    5e-324, -5e-324,
+    HUGE_VAL, -HUGE_VAL,
+  };
+  int nbfail = 0;
+  Rps_DumperJsonEmitter em;
+  Rps_LoaderJsonTape tape;
+  auto check = [&](std::string_view text, double expected)
+  {
+    tape.parse(text);
+    double got = tape.real_at(0);
+    if (got != expected || std::signbit(got) != std::signbit(expected))
+      {
+        RPS_WARNOUT("rps_json_tape_real_test " << text << " read as " << got
+                    << " expecting " << expected);
+        nbfail++;
+      }
+  };
+  for (double d: realtab)
+    {
+      em.buffer().clear();
+      em.begin_root();
+      em.write_real(d);
+      std::string text = em.buffer();
+      check(text, d);
+    }
+  check("1e-9999", 0.0);
+  check("-1e-9999", -0.0);
+  check("12345678901234567890123", 12345678901234567890123.0);
+  if (nbfail == 0)
+    RPS_INFORMOUT("rps_json_tape_real_test: " << sizeof(realtab)/sizeof(realtab[0]) + 3
+                  << " doubles read back as written");
+  return nbfail;
+} // end rps_json_tape_real_test
+
+/// like jsoncpp without emitUTF8: control characters and every non
+/// ASCII code point are written as \u escapes, with surrogate pairs
+/// above the BMP, and bad UTF-8 sequences as U+FFFD
+void
+Rps_DumperJsonEmitter::write_string(const char*str, size_t len)
+{
+  static const char hexdigits[] = "0123456789abcdef";
+  auto appendhex = [&](unsigned cp)
+  {
+    char hbuf[6] = {'\\', 'u', hexdigits[(cp>>12)&0xf], hexdigits[(cp>>8)&0xf],
+                    hexdigits[(cp>>4)&0xf], hexdigits[cp&0xf]
+                   };
+    dje_buf.append(hbuf, 6);
+  };
+  const char*end = str + len;
+  dje_buf.push_back('"');
+  const char*plain = str;
+  for (const char*pc = str; pc < end; pc++)
+    {
+      unsigned char c = (unsigned char) *pc;
+      if (RPS_LIKELY(c >= 0x20 && c < 0x80 && c != '"' && c != '\\'))
+        continue;
+      dje_buf.append(plain, pc - plain);
+      switch (c)
+        {
+        case '"':
+          dje_buf.append("\\\"");
+          break;
+        case '\\':
+          dje_buf.append("\\\\");
+          break;
+        case '\b':
+          dje_buf.append("\\b");
+          break;
+        case '\f':
+          dje_buf.append("\\f");
+          break;
+        case '\n':
+          dje_buf.append("\\n");
+          break;
+        case '\r':
+          dje_buf.append("\\r");
+          break;
+        case '\t':
+          dje_buf.append("\\t");
+          break;
+        default:
+          if (c < 0x20)
+            appendhex(c);
+          else
+            {
+              constexpr unsigned replacement = 0xFFFD;
+              unsigned cp = replacement;
+              const unsigned char*pu = (const unsigned char*)pc;
+              if (c < 0xE0)
+                {
+                  if (end - pc >= 2)
+                    {
+                      cp = ((c & 0x1F) << 6) | (pu[1] & 0x3F);
+                      pc += 1;
+                      if (cp < 0x80)
+                        cp = replacement;
+                    }
+                }
+              else if (c < 0xF0)
+                {
+                  if (end - pc >= 3)
+                    {
+                      cp = ((c & 0x0F) << 12) | ((pu[1] & 0x3F) << 6) | (pu[2] & 0x3F);
+                      pc += 2;
+                      if ((cp >= 0xD800 && cp <= 0xDFFF) || cp < 0x800)
+                        cp = replacement;
+                    }
+                }
+              else if (c < 0xF8)
+                {
+                  if (end - pc >= 4)
+                    {
+                      cp = ((c & 0x07) << 18) | ((pu[1] & 0x3F) << 12)
+                           | ((pu[2] & 0x3F) << 6) | (pu[3] & 0x3F);
+                      pc += 3;
+                      if (cp < 0x10000)
+                        cp = replacement;
+                    }
+                }
+              if (cp < 0x10000)
+                appendhex(cp);
+              else
+                {
+                  cp -= 0x10000;
+                  appendhex(0xD800 + ((cp >> 10) & 0x3FF));
+                  appendhex(0xDC00 + (cp & 0x3FF));
+                }
+            }
+          break;
+        }
+      plain = pc + 1;
+    }
+  dje_buf.append(plain, end - plain);
+  dje_buf.push_back('"');
+} // end Rps_DumperJsonEmitter::write_string
+
+/// an array whose elements are all scalars or empty, which may fit
+/// on one line
+bool
+Rps_DumperJsonEmitter::is_scalar_array(const Json::Value&jv) const
+{
+  for (const Json::Value&jelem: jv)
+    if ((jelem.isArray() || jelem.isObject()) && !jelem.empty())
+      return false;
+  return true;
+} // end Rps_DumperJsonEmitter::is_scalar_array
+
+void
+Rps_DumperJsonEmitter::write_value(const Json::Value&jv)
 {
-  RPS_ASSERT(ld != nullptr);
-  std::string str = "";
-  Rps_Id oid;
-  if (jv.isString() && !((str=jv.asString()).empty()) && (oid = Rps_Id(str)).valid())
+  switch (jv.type())
     {
-      Rps_ObjectRef obr= ld->find_object_by_oid(oid);
-      if (!obr)
+    case Json::nullValue:
+      write_null();
+      return;
+    case Json::intValue:
+      write_int(jv.asLargestInt());
+      return;
+    case Json::uintValue:
+      write_uint(jv.asLargestUInt());
+      return;
+    case Json::realValue:
+      write_real(jv.asDouble());
+      return;
+    case Json::stringValue:
+    {
+      const char*str = nullptr;
+      const char*end = nullptr;
+      if (jv.getString(&str, &end))
+        write_string(str, end - str);
+      return;
+    }
+    case Json::booleanValue:
+      write_bool(jv.asBool());
+      return;
+    case Json::arrayValue:
+    {
+      unsigned siz = jv.size();
+      if (siz == 0)
         {
-          RPS_WARNOUT("unknown oid " << oid);
-          throw  std::runtime_error(std::string{"unknown oid "} + oid.to_string());
+          write_empty_array();
+          return;
         }
-      *this = obr;
+      if (is_scalar_array(jv))
+        {
+          size_t off = open_line_array(siz);
+          if (off != dje_nolinearray)
+            {
+              for (unsigned ix=0; ix<siz; ix++)
+                {
+                  if (ix > 0)
+                    line_array_separator();
+                  write_value(jv[ix]);
+                }
+              if (close_line_array(off))
+                return;
+            }
+        }
+      open_multiline_array();
+      for (unsigned ix=0; ix<siz; ix++)
+        {
+          element_start(ix == 0);
+          write_value(jv[ix]);
+          element_end();
+        }
+      close_multiline_array();
       return;
     }
-  RPS_WARNOUT("partly unimplemented Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)"
-              << std::endl << " jv=" << jv
-              << RPS_FULL_BACKTRACE_HERE(2,"strange ObjectRef::Rps_ObjectRef"));
-  throw  std::runtime_error("partly unimplemented Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)");
-#warning partly unimplemented Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)
-} // end Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)
-
-
+    case Json::objectValue:
+    {
+      if (jv.empty())
+        {
+          dje_buf.append("{}");
+          return;
+        }
+      open_object();
+      bool first = true;
+      for (auto it = jv.begin(); it != jv.end(); it++)
+        {
+          const char*nameend = nullptr;
+          const char*name = it.memberName(&nameend);
+          member_name(name, nameend - name, first);
+          first = false;
+          write_value(*it);
+        }
+      close_object();
+      return;
+    }
+    }
+} // end Rps_DumperJsonEmitter::write_value
 
 
 
@@ -1110,6 +3028,7 @@ Rps_ObjectRef::Rps_ObjectRef(const Json::Value &jv, Rps_Loader*ld)
 class Rps_Dumper
 {
   friend class Rps_PayloadSpace;
+  friend class Rps_Journal;
   friend double rps_dump_start_elapsed_time(Rps_Dumper*);
   friend double rps_dump_start_process_time(Rps_Dumper*);
   friend double rps_dump_start_wallclock_time(Rps_Dumper*);
@@ -1137,11 +3056,47 @@ class Rps_Dumper
   {
     Rps_Id sp_id;
     std::set<Rps_ObjectRef> sp_setob;
-    du_space_st(Rps_Id id) : sp_id(id), sp_setob() {};
+    /// the JSON chunks of objects captured by a concurrent dump
+    std::map<Rps_ObjectRef,std::string> sp_textmap;
+    du_space_st(Rps_Id id) : sp_id(id), sp_setob(), sp_textmap() {};
   };
   std::map<Rps_ObjectRef,std::shared_ptr<du_space_st>> du_spacemap; // map from spaces to objects inside
   std::set<Rps_ObjectRef> du_pluginobset;
   std::set<Rps_ObjectRef> du_constantobset;
+  /// the executable mappings of /proc/self/maps, sorted by address,
+  /// with the oid of the plugin of every rps_*-mod.so among them; it
+  /// is replaced, not mutated, when some code address is outside of
+  /// all of them, e.g. after a dlopen
+  struct du_coderange_st
+  {
+    uintptr_t cr_start;
+    uintptr_t cr_end;
+    Rps_Id cr_plugid;		// invalid outside of plugins
+    mutable std::atomic<bool> cr_scanned; // once its plugin has been scanned
+  };
+  std::shared_ptr<const std::vector<du_coderange_st>> du_coderanges;
+  // the checksum of the written binary snapshot, or empty
+  std::string du_snapshotchecksum;
+  size_t du_snapshotnbobjects;
+  // the size, mtime and checksum of its space files, by space id
+  Json::Value du_snapshotspacesjson;
+  /// with rps_dump_incremental, the spaces whose file was kept as is
+  std::set<Rps_ObjectRef> du_unchangedspaceset;
+  /// with rps_dump_incremental, the objects referred to by the objects
+  /// of every space, found while scanning du_scanningobr
+  std::map<Rps_ObjectRef,std::set<Rps_ObjectRef>> du_spacerefsmap;
+  Rps_ObjectRef du_scanningobr;
+  /// set once the scan is complete: then du_mapobjects and
+  /// du_spacemap are only read, without locking du_mtx, by the
+  /// threads writing space files
+  std::atomic<bool> du_scandone;
+  /// the class name comment of every class of a dumped object,
+  /// computed before writing the space files
+  std::map<Rps_ObjectRef,std::string> du_classnamemap;
+  /// the spaces whose file should be written
+  std::vector<Rps_ObjectRef> du_spacestowrite;
+  /// the manifest, when computed while the agenda is paused
+  Json::Value du_manifestjson;
   // we maintain the set of opened file paths, since they are opened
   // with the temporary suffix above, and renamed by
   // rename_opened_files below.
@@ -1173,10 +3128,31 @@ private:
   void write_generated_constants_file(void);
   void write_manifest_file(void);
   void write_space_file(Rps_ObjectRef spacobr);
+  bool emit_json_value(Rps_DumperJsonEmitter&em, Rps_Value val, bool scalaronly=false);
+  void emit_object_json(Rps_DumperJsonEmitter&em, Rps_ObjectRef obr);
+  void emit_object_chunk(Rps_DumperJsonEmitter&em, Rps_ObjectRef obr);
+  static Rps_DumperJsonEmitter& thread_json_emitter(void);
+  void select_spaces_to_write(void);
+  unsigned run_on_spaces(const std::vector<Rps_ObjectRef>& spacevec,
+                         void (Rps_Dumper::*spacefun)(Rps_ObjectRef));
+  void run_space_worker(const std::vector<Rps_ObjectRef>* pspacevec,
+                        void (Rps_Dumper::*spacefun)(Rps_ObjectRef),
+                        std::atomic<size_t>* pnextspace,
+                        std::exception_ptr* pfailure, int ix);
+  void capture_space_texts(Rps_ObjectRef spacobr);
+  void capture_all_space_texts(void);
+  void complete_capture_while_paused(void);
+  Json::Value make_manifest_json(void);
+  void compute_class_names(void);
+  bool is_space_file_unchanged(Rps_ObjectRef spacobr);
+  void put_space_dump_records(void);
+  void write_snapshot_file(void);
   void scan_object_contents(Rps_ObjectRef obr);
   std::unique_ptr<std::ofstream> open_output_file(const std::string& relpath);
   void rename_opened_files(void);
   void scan_code_addr(const void*);
+  std::shared_ptr<const std::vector<du_coderange_st>> refresh_code_ranges
+      (const std::shared_ptr<const std::vector<du_coderange_st>>& oldranges);
 public:
   std::string get_temporary_suffix(void) const
   {
@@ -1198,6 +3174,7 @@ public:
   Json::Value json_objectref(const Rps_ObjectRef obr);
   bool is_dumpable_objref(const Rps_ObjectRef obr);
   bool is_dumpable_objattr(const Rps_ObjectRef obr);
+  bool is_scanned_objref(const Rps_ObjectRef obr);
   bool is_dumpable_value(const Rps_Value val);
   void scan_space_component(Rps_ObjectRef obrspace, Rps_ObjectRef obrcomp)
   {
@@ -1222,7 +3199,17 @@ Rps_Dumper::Rps_Dumper(const std::string&topdir, Rps_CallFrame*callframe) :
   du_startprocesstime(rps_process_cpu_time()),
   du_startwallclockrealtime(rps_wallclock_real_time()),
   du_startmonotonictime(rps_monotonic_real_time()),
-  du_callframe(callframe), du_openedpathset()
+  du_callframe(callframe),
+  du_snapshotchecksum(), du_snapshotnbobjects(0),
+  du_snapshotspacesjson(Json::objectValue),
+  du_unchangedspaceset(),
+  du_spacerefsmap(),
+  du_scanningobr(nullptr),
+  du_scandone(false),
+  du_classnamemap(),
+  du_spacestowrite(),
+  du_manifestjson(Json::nullValue),
+  du_openedpathset()
 {
   du_jsonwriterbuilder["commentStyle"] = "None";
   du_jsonwriterbuilder["indentation"] = " ";
@@ -1282,6 +3269,8 @@ Rps_Dumper::scan_object(const Rps_ObjectRef obr)
   if (!obr)
     return;
   std::lock_guard<std::recursive_mutex> gu(du_mtx);
+  if (rps_dump_incremental && du_scanningobr && du_scanningobr->get_space())
+    du_spacerefsmap[Rps_ObjectRef(du_scanningobr->get_space())].insert(obr);
   if (du_mapobjects.find(obr->oid()) != du_mapobjects.end())
     return;
   if (!obr->get_space()) // transient
@@ -1313,6 +3302,10 @@ Rps_Dumper::json_value(Rps_Value val)
     return Json::Value(Json::nullValue);
   else if (val.is_int())
     return Json::Value(Json::Int64(val.as_int()));
+  else if (val.is_immediate_double())
+    return Json::Value(val.as_double());
+  else if (val.is_immediate_string())
+    return Rps_String::dump_json_cstr(val.as_cstring());
   else if (val.is_ptr() && is_dumpable_value(val))
     {
       return val.to_ptr()->dump_json(this);
@@ -1326,9 +3319,17 @@ Rps_Dumper::is_dumpable_objref(const Rps_ObjectRef obr)
 {
   if (!obr)
     return false;
-  std::lock_guard<std::recursive_mutex> gu(du_mtx);
-  if (du_mapobjects.find(obr->oid()) != du_mapobjects.end())
-    return true;
+  if (du_scandone.load())
+    {
+      if (du_mapobjects.find(obr->oid()) != du_mapobjects.end())
+        return true;
+    }
+  else
+    {
+      std::lock_guard<std::recursive_mutex> gu(du_mtx);
+      if (du_mapobjects.find(obr->oid()) != du_mapobjects.end())
+        return true;
+    }
   auto obrspace = obr->get_space();
   if (!obrspace) // transient
     return false;
@@ -1343,17 +3344,34 @@ Rps_Dumper::is_dumpable_objattr(const Rps_ObjectRef obr)
     return false;
   if (!is_dumpable_objref(obr))
     return false;
-  std::lock_guard<std::recursive_mutex> gu(du_mtx);
 #warning incomplete Rps_Dumper::is_dumpable_objattr
   return true;
 } // end Rps_Dumper::is_dumpable_objattr
 
 
+/// Weak references, like the owners of an attribute index, are dumped
+/// only if the scan reached their object thru strong ones. A dumper
+/// which does not scan, like the one of the journal, has no scanned
+/// object, and then keeps every dumpable one.
+bool
+Rps_Dumper::is_scanned_objref(const Rps_ObjectRef obr)
+{
+  if (!obr)
+    return false;
+  std::unique_lock<std::recursive_mutex> gu(du_mtx, std::defer_lock);
+  if (!du_scandone.load())
+    gu.lock();
+  if (du_mapobjects.empty())
+    return is_dumpable_objref(obr);
+  return du_mapobjects.find(obr->oid()) != du_mapobjects.end();
+} // end Rps_Dumper::is_scanned_objref
+
+
 bool
 Rps_Dumper::is_dumpable_value(const Rps_Value val)
 {
   if (!val) return true;
-  if (val.is_int() || val.is_string() || val.is_set() || val.is_tuple())
+  if (val.is_int() || val.is_double() || val.is_string() || val.is_set() || val.is_tuple())
     return true;
   if (val.is_closure())
     {
@@ -1411,8 +3429,7 @@ Rps_Dumper::scan_cplusplus_source_file_for_constants(const std::string&relfilena
   for (std::string linbuf; std::getline(ins, linbuf); )
     {
       lincnt++;
-      if (u8_check(reinterpret_cast<const uint8_t*> (linbuf.c_str()),
-                   linbuf.size()))
+      if (rps_utf8_check_count(linbuf.c_str(), linbuf.size(), nullptr))
         {
           RPS_WARNOUT("file " << fullpath << ", line " << lincnt
                       << " non UTF8:" << linbuf);
@@ -1457,50 +3474,118 @@ Rps_Dumper::scan_cplusplus_source_file_for_constants(const std::string&relfilena
 } // end Rps_Dumper::scan_cplusplus_source_file_for_constants
 
 
+/// Parse /proc/self/maps into a new table of executable mappings,
+/// unless another thread already did that since oldranges was got.
+std::shared_ptr<const std::vector<Rps_Dumper::du_coderange_st>>
+Rps_Dumper::refresh_code_ranges(const std::shared_ptr<const std::vector<du_coderange_st>>& oldranges)
+{
+  std::lock_guard<std::recursive_mutex> gu(du_mtx);
+  auto curranges = std::atomic_load(&du_coderanges);
+  if (curranges != oldranges)
+    return curranges;
+  struct plainrange_st
+  {
+    uintptr_t pr_start;
+    uintptr_t pr_end;
+    Rps_Id pr_plugid;
+  };
+  std::vector<plainrange_st> plainvec;
+  std::ifstream mapsin("/proc/self/maps");
+  for (std::string linbuf; std::getline(mapsin, linbuf); )
+    {
+      unsigned long startad = 0, endad = 0;
+      char perms[8];
+      memset (perms, 0, sizeof(perms));
+      int pathpos = -1;
+      if (sscanf(linbuf.c_str(), "%lx-%lx %7s %*s %*s %*s %n",
+                 &startad, &endad, perms, &pathpos) < 3
+          || perms[2] != 'x')
+        continue;
+      Rps_Id plugid;
+      const char*path = (pathpos > 0) ? linbuf.c_str() + pathpos : "";
+      const char*lastslash = strrchr(path, '/');
+      char idbuf[32];
+      memset (idbuf, 0, sizeof(idbuf));
+      int endpos = -1;
+      if (lastslash
+          && sscanf(lastslash+1, "rps_%19[a-zA-Z0-9]-mod.so%n", idbuf, &endpos) >= 1
+          && endpos>20)
+        {
+          const char* endid=nullptr;
+          bool okid=false;
+          Rps_Id id (idbuf, &endid, &okid);
+          if (id.valid() && *endid == (char)0 && okid)
+            plugid = id;
+        }
+      plainvec.push_back(plainrange_st{(uintptr_t)startad, (uintptr_t)endad, plugid});
+    }
+  std::sort(plainvec.begin(), plainvec.end(),
+            [](const plainrange_st&l, const plainrange_st&r)
+  {
+    return l.pr_start < r.pr_start;
+  });
+  auto newranges = std::make_shared<std::vector<du_coderange_st>>(plainvec.size());
+  for (size_t rix=0; rix<plainvec.size(); rix++)
+    {
+      du_coderange_st& currange = (*newranges)[rix];
+      currange.cr_start = plainvec[rix].pr_start;
+      currange.cr_end = plainvec[rix].pr_end;
+      currange.cr_plugid = plainvec[rix].pr_plugid;
+      currange.cr_scanned.store(false);
+    }
+  RPS_DEBUG_LOG(DUMP, "dumper refresh_code_ranges got " << plainvec.size()
+                << " executable mappings");
+  std::shared_ptr<const std::vector<du_coderange_st>> constranges(newranges);
+  std::atomic_store(&du_coderanges, constranges);
+  return constranges;
+} // end Rps_Dumper::refresh_code_ranges
+
+
+/// Find by binary search, without locking, the executable mapping of
+/// a code address, such as an applying function, and scan the plugin
+/// object of that mapping once. The mappings are parsed at the first
+/// call, and again if the address is outside of all of them.
 void
 Rps_Dumper::scan_code_addr(const void*ad)
 {
-  /**
-   * If we wanted to be more efficient, we should parse the
-   * pseudo-file /proc/self/maps at start of dump. See
-   * http://man7.org/linux/man-pages/man5/proc.5.html for more....
-   **/
   if (!ad)
     return;
-  Dl_info di;
-  memset(&di, 0, sizeof(di));
-  std::lock_guard<std::recursive_mutex> gu(du_mtx);
-  if (!dladdr(ad, &di))
-    return;
-  if (!di.dli_fname)
+  uintptr_t uad = (uintptr_t)ad;
+  auto findrange = [uad](const std::vector<du_coderange_st>& ranges)
+                   -> const du_coderange_st*
+  {
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), uad,
+                               [](uintptr_t u, const du_coderange_st&r)
+    {
+      return u < r.cr_start;
+    });
+    if (it == ranges.begin())
+      return nullptr;
+    --it;
+    return (uad < it->cr_end) ? &*it : nullptr;
+  };
+  auto ranges = std::atomic_load(&du_coderanges);
+  const du_coderange_st* currange = ranges ? findrange(*ranges) : nullptr;
+  if (!currange)
+    {
+      ranges = refresh_code_ranges(ranges);
+      currange = findrange(*ranges);
+      if (!currange)
+        return;
+    }
+  if (!currange->cr_plugid.valid() || currange->cr_scanned.load())
     return;
-  const char*lastslash = strrchr(di.dli_fname, '/');
-  if (!lastslash)
+  Rps_ObjectZone* obz = Rps_ObjectZone::find(currange->cr_plugid);
+  if (!obz)
     return;
-  char idbuf[32];
-  memset (idbuf, 0, sizeof(idbuf));
-  int endpos = -1;
-  if (sscanf(lastslash+1, "rps_%19[a-zA-Z0-9]-mod.so%n", idbuf, &endpos) >= 1
-      && endpos>20)
-    {
-      const char* endid=nullptr;
-      bool okid=false;
-      Rps_Id plugid (idbuf, &endid, &okid);
-      if (plugid.valid() && *endid == (char)0 && okid)
-        {
-          Rps_ObjectZone* obz = Rps_ObjectZone::find(plugid);
-          if (obz)
-            {
-              Rps_ObjectRef plugobr(obz);
-              if (du_pluginobset.find(plugobr)
-                  == du_pluginobset.end())
-                {
-                  du_pluginobset.insert(plugobr);
-                  scan_object(plugobr);
-                }
-            };
-        }
+  Rps_ObjectRef plugobr(obz);
+  std::lock_guard<std::recursive_mutex> gu(du_mtx);
+  if (du_pluginobset.find(plugobr) == du_pluginobset.end())
+    {
+      du_pluginobset.insert(plugobr);
+      scan_object(plugobr);
     }
+  currange->cr_scanned.store(true);
 } // end of Rps_Dumper::scan_code_addr
 
 
@@ -1543,6 +3628,12 @@ bool rps_is_dumpable_objattr(Rps_Dumper*du, const Rps_ObjectRef obr)
   return du->is_dumpable_objattr(obr);
 } // end rps_is_dumpable_objattr
 
+bool rps_is_scanned_objref(Rps_Dumper*du, const Rps_ObjectRef obr)
+{
+  RPS_ASSERT(du != nullptr);
+  return du->is_scanned_objref(obr);
+} // end rps_is_scanned_objref
+
 bool rps_is_dumpable_value(Rps_Dumper*du, const Rps_Value val)
 {
 
@@ -1840,50 +3931,336 @@ void
 Rps_Dumper::scan_object_contents(Rps_ObjectRef obr)
 {
   std::lock_guard<std::recursive_mutex> gu(du_mtx);
+  du_scanningobr = obr;
   obr->dump_scan_contents(this);
+  du_scanningobr = nullptr;
   Rps_ObjectRef spacobr(obr->get_space());
   rps_dump_scan_object(this,spacobr);
 } // end Rps_Dumper::scan_object_contents
 
 
 
-void
-Rps_Dumper::scan_every_cplusplus_source_file_for_constants(void)
+void
+Rps_Dumper::scan_every_cplusplus_source_file_for_constants(void)
+{
+  for (const char*const*pcurfilename = rps_files; *pcurfilename; pcurfilename++)
+    {
+      const char*curpath = *pcurfilename;
+      int lencurpath = strlen(curpath);
+      if (lencurpath < 6 || strstr(curpath, "generated/"))
+        continue;
+      if (curpath[lencurpath-3] != '.') continue;
+      if ((curpath[lencurpath-2] == 'h' && curpath[lencurpath-1] == 'h')
+          || (curpath[lencurpath-2] == 'c' && curpath[lencurpath-1] == 'c'))
+        {
+          std::string relfilname = curpath;
+          scan_cplusplus_source_file_for_constants(relfilname);
+        };
+    }
+} // end of scan_every_cplusplus_source_file_for_constants
+
+/// Select the spaces whose file should be written, skipping with
+/// rps_dump_incremental those unchanged since their last dump, and
+/// compute the class name comments. Then the scan is complete, so the
+/// dumper maps are only read, without locking du_mtx.
+void
+Rps_Dumper::select_spaces_to_write(void)
+{
+  std::lock_guard<std::recursive_mutex> gu(du_mtx);
+  RPS_ASSERT(du_scanque.empty());
+  du_spacestowrite.clear();
+  du_unchangedspaceset.clear();
+  for (auto it: du_spacemap)
+    {
+      if (rps_dump_incremental && is_space_file_unchanged(it.first))
+        du_unchangedspaceset.insert(it.first);
+      else
+        du_spacestowrite.push_back(it.first);
+    }
+  compute_class_names();
+  du_scandone.store(true);
+} // end Rps_Dumper::select_spaces_to_write
+
+
+/// Space files are written concurrently by rps_nbjobs threads, each
+/// taking the next space to write and using its own JSON emitter.
+void
+Rps_Dumper::write_all_space_files(void)
+{
+  RPS_DEBUG_LOG(DUMP, "dumper write_all_space_files start");
+  if (!du_scandone.load())
+    select_spaces_to_write();
+  double startrealt = rps_elapsed_real_time();
+  unsigned nbthreads = run_on_spaces(du_spacestowrite, &Rps_Dumper::write_space_file);
+  char realtbuf[32];
+  memset(realtbuf, 0, sizeof(realtbuf));
+  snprintf(realtbuf, sizeof(realtbuf), "%.3f", rps_elapsed_real_time() - startrealt);
+  if (du_unchangedspaceset.empty())
+    RPS_INFORMOUT("wrote " << du_spacestowrite.size() << " space files into " << du_topdir
+                  << " by " << nbthreads << " threads in " << realtbuf << " elapsed seconds");
+  else
+    RPS_INFORMOUT("wrote " << du_spacestowrite.size() << " space files into " << du_topdir
+                  << " by " << nbthreads << " threads in " << realtbuf << " elapsed seconds"
+                  << " and kept " << du_unchangedspaceset.size() << " unchanged ones");
+} // end Rps_Dumper::write_all_space_files
+
+
+/// Apply spacefun to every space of spacevec, in at most rps_nbjobs
+/// threads, including the calling one; the first failure is rethrown.
+/// Gives the number of threads used.
+unsigned
+Rps_Dumper::run_on_spaces(const std::vector<Rps_ObjectRef>& spacevec,
+                          void (Rps_Dumper::*spacefun)(Rps_ObjectRef))
+{
+  RPS_ASSERT(spacefun != nullptr);
+  unsigned nbthreads = (rps_nbjobs > 1) ? (unsigned) rps_nbjobs : 1;
+  if (nbthreads > spacevec.size())
+    nbthreads = spacevec.size() > 0 ? (unsigned) spacevec.size() : 1;
+  std::exception_ptr failure;
+  {
+    std::atomic<size_t> nextspace(0);
+    std::vector<std::thread> thrvec;
+    thrvec.reserve(nbthreads);
+    for (unsigned thix = 1; thix < nbthreads; thix++)
+      thrvec.emplace_back(&Rps_Dumper::run_space_worker, this,
+                          &spacevec, spacefun, &nextspace, &failure, (int)thix);
+    run_space_worker(&spacevec, spacefun, &nextspace, &failure, 0);
+    for (std::thread& thr: thrvec)
+      thr.join();
+  }
+  if (failure)
+    std::rethrow_exception(failure);
+  return nbthreads;
+} // end Rps_Dumper::run_on_spaces
+
+
+/// the body of dumping threads, and of the main thread (with ix 0),
+/// handling spaces; the first failure is kept, and stops them
+void
+Rps_Dumper::run_space_worker(const std::vector<Rps_ObjectRef>* pspacevec,
+                             void (Rps_Dumper::*spacefun)(Rps_ObjectRef),
+                             std::atomic<size_t>* pnextspace,
+                             std::exception_ptr* pfailure, int ix)
+{
+  RPS_ASSERT(pspacevec != nullptr);
+  RPS_ASSERT(spacefun != nullptr);
+  RPS_ASSERT(pnextspace != nullptr);
+  RPS_ASSERT(pfailure != nullptr);
+  if (ix > 0)
+    {
+      char pthname[16];
+      memset (pthname, 0, sizeof(pthname));
+      snprintf(pthname, sizeof(pthname), "rps-duw#%hd", (short) ix);
+      pthread_setname_np(pthread_self(), pthname);
+    }
+  const size_t nbspaces = pspacevec->size();
+  for (;;)
+    {
+      size_t spix = pnextspace->fetch_add(1);
+      if (spix >= nbspaces)
+        break;
+      try
+        {
+          (this->*spacefun)((*pspacevec)[spix]);
+        }
+      catch (...)
+        {
+          std::lock_guard<std::recursive_mutex> gu(du_mtx);
+          if (!*pfailure)
+            *pfailure = std::current_exception();
+          pnextspace->store(nbspaces);
+          break;
+        }
+    }
+} // end Rps_Dumper::run_space_worker
+
+
+/// A concurrent dump, done while the agenda is running, first emits
+/// the chunks of the objects of every space to write without stopping
+/// anything. The chunks of objects mutated meanwhile are emitted
+/// again in complete_capture_while_paused.
+void
+Rps_Dumper::capture_all_space_texts(void)
+{
+  RPS_DEBUG_LOG(DUMP, "dumper capture_all_space_texts start");
+  select_spaces_to_write();
+  double startrealt = rps_elapsed_real_time();
+  unsigned nbthreads = run_on_spaces(du_spacestowrite, &Rps_Dumper::capture_space_texts);
+  char realtbuf[32];
+  memset(realtbuf, 0, sizeof(realtbuf));
+  snprintf(realtbuf, sizeof(realtbuf), "%.3f", rps_elapsed_real_time() - startrealt);
+  RPS_INFORMOUT("captured " << du_spacestowrite.size() << " spaces while running, by "
+                << nbthreads << " threads in " << realtbuf << " elapsed seconds");
+} // end Rps_Dumper::capture_all_space_texts
+
+
+/// emit the chunks of the objects of a space lacking one; each space
+/// is handled by a single thread, so its text map is not locked
+void
+Rps_Dumper::capture_space_texts(Rps_ObjectRef spacobr)
+{
+  RPS_ASSERT(du_scandone.load());
+  auto itspace = du_spacemap.find(spacobr);
+  RPS_ASSERT(itspace != du_spacemap.end());
+  du_space_st* curspa = itspace->second.get();
+  RPS_ASSERT(curspa);
+  Rps_DumperJsonEmitter& em = thread_json_emitter();
+  for (auto curobr: curspa->sp_setob)
+    {
+      if (curspa->sp_textmap.find(curobr) != curspa->sp_textmap.end())
+        continue;
+      em.buffer().clear();
+      emit_object_chunk(em, curobr);
+      curspa->sp_textmap.emplace(curobr, em.buffer());
+    }
+  em.buffer().clear();
+} // end Rps_Dumper::capture_space_texts
+
+
+/// Called while the agenda worker threads are paused, so objects are
+/// not mutated by tasklets. Every object touched since the start of
+/// the dump, or with a payload not touching its owner, is scanned
+/// again, with the roots, and its chunk is emitted again. Objects
+/// which became unreachable during the dump are still dumped.
+void
+Rps_Dumper::complete_capture_while_paused(void)
+{
+  RPS_DEBUG_LOG(DUMP, "dumper complete_capture_while_paused start");
+  double startrealt = rps_elapsed_real_time();
+  std::vector<Rps_ObjectRef> dirtyvec;
+  {
+    std::lock_guard<std::recursive_mutex> gu(du_mtx);
+    du_scandone.store(false);
+    for (auto it: du_mapobjects)
+      {
+        Rps_ObjectRef curobr = it.second;
+        Rps_Payload*payl = curobr->get_payload();
+        if (curobr->get_mtime() >= du_startwallclockrealtime
+            || (payl && !payl->touches_owner_on_mutation()))
+          dirtyvec.push_back(curobr);
+      }
+    /// a dirty object may have moved to another space
+    for (auto it: du_spacemap)
+      for (Rps_ObjectRef dirtyobr: dirtyvec)
+        {
+          it.second->sp_setob.erase(dirtyobr);
+          it.second->sp_textmap.erase(dirtyobr);
+        }
+  }
+  for (Rps_ObjectRef dirtyobr: dirtyvec)
+    scan_object_contents(dirtyobr);
+  scan_roots();
+  scan_loop_pass();
+  select_spaces_to_write();
+  run_on_spaces(du_spacestowrite, &Rps_Dumper::capture_space_texts);
+  write_all_generated_files();
+  du_manifestjson = make_manifest_json();
+  char realtbuf[32];
+  memset(realtbuf, 0, sizeof(realtbuf));
+  snprintf(realtbuf, sizeof(realtbuf), "%.3f", rps_elapsed_real_time() - startrealt);
+  RPS_INFORMOUT("completed dump capture of " << dirtyvec.size()
+                << " mutated objects while paused in " << realtbuf << " elapsed seconds");
+} // end Rps_Dumper::complete_capture_while_paused
+
+
+/// the space files have a comment giving the class name of every
+/// object, computed once per class here, with du_mtx locked
+void
+Rps_Dumper::compute_class_names(void)
+{
+  std::lock_guard<std::recursive_mutex> gu(du_mtx);
+  for (auto it: du_spacemap)
+    for (Rps_ObjectRef curobr: it.second->sp_setob)
+      {
+        Rps_ObjectRef obclass = curobr->get_class();
+        if (!obclass || du_classnamemap.find(obclass) != du_classnamemap.end())
+          continue;
+        Rps_ObjectRef obsymb;
+        {
+          std::lock_guard<std::recursive_mutex> guclass(*(obclass->objmtxptr()));
+          auto classinfo = obclass->get_dynamic_payload<Rps_PayloadClassInfo>();
+          if (classinfo)
+            obsymb = classinfo->symbname();
+        }
+        std::string classname;
+        if (obsymb)
+          {
+            std::lock_guard<std::recursive_mutex> gusymb(*(obsymb->objmtxptr()));
+            auto symb = obsymb->get_dynamic_payload<Rps_PayloadSymbol>();
+            if (symb)
+              classname = symb->symbol_name();
+          }
+        du_classnamemap.insert({obclass, classname});
+      }
+} // end Rps_Dumper::compute_class_names
+
+
+/// A space file can be kept by an incremental dump if the space was
+/// loaded from, or dumped into, the same directory with the same
+/// member objects, and none of them was touched since. Payloads which
+/// don't touch their owner when mutated make their space changed. So
+/// does any object they refer to which is touched since, or which is
+/// not dumped anymore, since the kept file would refer to an unknown
+/// oid.
+bool
+Rps_Dumper::is_space_file_unchanged(Rps_ObjectRef spacobr)
 {
-  for (const char*const*pcurfilename = rps_files; *pcurfilename; pcurfilename++)
+  RPS_ASSERT(spacobr);
+  Rps_PayloadSpace::space_dump_record sdr;
+  if (!Rps_PayloadSpace::dump_record_of_space(spacobr, sdr))
+    return false;
+  if (sdr.sdr_dir != du_topdir)
+    return false;
+  std::string curelpath = std::string{"persistore/sp"} + spacobr->oid().to_string() + "-rps.json";
+  if (access((du_topdir + "/" + curelpath).c_str(), R_OK))
+    return false;
+  std::lock_guard<std::recursive_mutex> gu(du_mtx);
+  const std::set<Rps_ObjectRef>& curspaset = du_spacemap[spacobr]->sp_setob;
+  if (curspaset.size() != sdr.sdr_members.size())
+    return false;
+  // both are sorted by oid
+  auto itmemb = sdr.sdr_members.begin();
+  for (Rps_ObjectRef curobr: curspaset)
     {
-      const char*curpath = *pcurfilename;
-      int lencurpath = strlen(curpath);
-      if (lencurpath < 6 || strstr(curpath, "generated/"))
-        continue;
-      if (curpath[lencurpath-3] != '.') continue;
-      if ((curpath[lencurpath-2] == 'h' && curpath[lencurpath-1] == 'h')
-          || (curpath[lencurpath-2] == 'c' && curpath[lencurpath-1] == 'c'))
-        {
-          std::string relfilname = curpath;
-          scan_cplusplus_source_file_for_constants(relfilname);
-        };
+      if (curobr->oid() != *itmemb++)
+        return false;
+      if (curobr->get_mtime() > sdr.sdr_time)
+        return false;
+      Rps_Payload*payl = curobr->get_payload();
+      if (payl && !payl->touches_owner_on_mutation())
+        return false;
     }
-} // end of scan_every_cplusplus_source_file_for_constants
+  auto itrefs = du_spacerefsmap.find(spacobr);
+  if (itrefs != du_spacerefsmap.end())
+    for (Rps_ObjectRef refobr: itrefs->second)
+      {
+        if (!refobr->get_space()
+            || du_mapobjects.find(refobr->oid()) == du_mapobjects.end()
+            || refobr->get_mtime() > sdr.sdr_time)
+          return false;
+      }
+  return true;
+} // end Rps_Dumper::is_space_file_unchanged
 
+
+/// Once the files are renamed, every dumped space is recorded as
+/// being in the dump directory at the start time of the dump.
 void
-Rps_Dumper::write_all_space_files(void)
+Rps_Dumper::put_space_dump_records(void)
 {
-  RPS_DEBUG_LOG(DUMP, "dumper write_all_space_files start");
-  std::set<Rps_ObjectRef> spaceset;
-  {
-    std::lock_guard<std::recursive_mutex> gu(du_mtx);
-    for (auto it: du_spacemap)
-      spaceset.insert(it.first);
-  }
-  int nbspace = 0;
-  for (Rps_ObjectRef spacobr : spaceset)
+  std::lock_guard<std::recursive_mutex> gu(du_mtx);
+  for (auto it: du_spacemap)
     {
-      write_space_file(spacobr);
-      nbspace++;
+      Rps_PayloadSpace::space_dump_record sdr;
+      sdr.sdr_dir = du_topdir;
+      sdr.sdr_time = du_startwallclockrealtime;
+      sdr.sdr_members.reserve(it.second->sp_setob.size());
+      // the set is sorted by oid
+      for (Rps_ObjectRef curobr: it.second->sp_setob)
+        sdr.sdr_members.push_back(curobr->oid());
+      Rps_PayloadSpace::put_dump_record(it.first, sdr);
     }
-  RPS_INFORMOUT("wrote " << nbspace << " space files into " << du_topdir);
-} // end Rps_Dumper::write_all_space_files
+} // end Rps_Dumper::put_space_dump_records
 
 void
 Rps_Dumper::write_generated_roots_file(void)
@@ -2087,6 +4464,29 @@ Rps_Dumper::write_manifest_file(void)
   RPS_DEBUG_LOG(DUMP, "dumper write_manifest_file start");
   auto pouts = open_output_file(RPS_MANIFEST_JSON);
   rps_emit_gplv3_copyright_notice(*pouts, RPS_MANIFEST_JSON, "//!! ", "");
+  /// a concurrent dump computed it while the agenda was paused
+  Json::Value jmanifest = du_manifestjson.isNull() ? make_manifest_json() : du_manifestjson;
+  /// the loader uses the binary snapshot only if it has that checksum
+  if (!du_snapshotchecksum.empty())
+    {
+      Json::Value jsnapshot(Json::objectValue);
+      jsnapshot["file"] = Json::Value (RPS_SNAPSHOT_BIN);
+      jsnapshot["checksum"] = Json::Value (du_snapshotchecksum);
+      jsnapshot["nbobjects"] = Json::Value ((Json::UInt64)du_snapshotnbobjects);
+      jsnapshot["spaces"] = du_snapshotspacesjson;
+      jmanifest["snapshot"] = jsnapshot;
+    }
+  jsonwriter->write(jmanifest, pouts.get());
+  *pouts << std::endl <<  std::endl << "//// end of RefPerSys manifest file" << std::endl;
+  RPS_DEBUG_LOG(DUMP, "dumper write_manifest_file ending ... " << rps_gitid << std::endl);
+} // end Rps_Dumper::write_manifest_file
+
+
+/// the manifest, but its binary snapshot member
+Json::Value
+Rps_Dumper::make_manifest_json(void)
+{
+  std::lock_guard<std::recursive_mutex> gu(du_mtx);
   Json::Value jmanifest(Json::objectValue);
   jmanifest["format"] = Json::Value (RPS_MANIFEST_FORMAT);
   {
@@ -2098,7 +4498,7 @@ Rps_Dumper::write_manifest_file(void)
       nbroots++;
     });
     jmanifest["globalroots"] = jglobalroots;
-    RPS_DEBUG_LOG(DUMP, "dumper write_manifest_file wrote " << nbroots << " global roots.");
+    RPS_DEBUG_LOG(DUMP, "dumper make_manifest_json got " << nbroots << " global roots.");
   }
   {
     int nbspaces=0;
@@ -2110,7 +4510,7 @@ Rps_Dumper::write_manifest_file(void)
         nbspaces++;
       }
     jmanifest["spaceset"] = jspaceset;
-    RPS_DEBUG_LOG(DUMP, "dumper write_manifest_file wrote " << nbspaces << " spaces.");
+    RPS_DEBUG_LOG(DUMP, "dumper make_manifest_json got " << nbspaces << " spaces.");
   }
   {
     int nbconst=0;
@@ -2122,7 +4522,7 @@ Rps_Dumper::write_manifest_file(void)
         nbconst++;
       }
     jmanifest["constset"] = jconstset;
-    RPS_DEBUG_LOG(DUMP, "dumper write_manifest_file wrote " << nbconst << " constants.");
+    RPS_DEBUG_LOG(DUMP, "dumper make_manifest_json got " << nbconst << " constants.");
   }
   {
     int nbplugins=0;
@@ -2134,13 +4534,12 @@ Rps_Dumper::write_manifest_file(void)
         nbplugins++;
       }
     jmanifest["plugins"] = jplugins;
-    RPS_DEBUG_LOG(DUMP, "dumper write_manifest_file wrote " << nbplugins << " plugins.");
+    RPS_DEBUG_LOG(DUMP, "dumper make_manifest_json got " << nbplugins << " plugins.");
   }
   {
     Json::Value jglobalnames(Json::arrayValue);
     int namecnt = 0;
-    //  std::ofstream& out = *pouts;
-    rps_each_root_object([=, &pouts, &namecnt, &jglobalnames](Rps_ObjectRef obr)
+    rps_each_root_object([=, &namecnt, &jglobalnames](Rps_ObjectRef obr)
     {
       Rps_PayloadSymbol* cursym = obr->get_dynamic_payload<Rps_PayloadSymbol>();
       if (!cursym || cursym->symbol_is_weak())
@@ -2152,101 +4551,453 @@ Rps_Dumper::write_manifest_file(void)
       namecnt++;
     });
     jmanifest["globalnames"] = jglobalnames;
-    RPS_DEBUG_LOG(DUMP, "dumper write_manifest_file wrote " << namecnt << " global names.");
+    RPS_DEBUG_LOG(DUMP, "dumper make_manifest_json got " << namecnt << " global names.");
   }
   /// this is not used for loading, but could be useful for other purposes.
   jmanifest["origitid"] = Json::Value (rps_gitid);
-  jsonwriter->write(jmanifest, pouts.get());
-  *pouts << std::endl <<  std::endl << "//// end of RefPerSys manifest file" << std::endl;
-  RPS_DEBUG_LOG(DUMP, "dumper write_manifest_file ending ... " << rps_gitid << std::endl);
-} // end Rps_Dumper::write_manifest_file
+  /// the loader compares it with RPS_STRING_HASH_VERSION
+  jmanifest["stringhashversion"] = Json::Value (RPS_STRING_HASH_VERSION);
+  return jmanifest;
+} // end Rps_Dumper::make_manifest_json
 
 
+/// Stream the JSON text of a value, exactly as the Json::Value given
+/// by rps_dump_json_value would be written. With scalaronly, nothing
+/// is written and false is returned if that would be a non-empty
+/// array or object.
+bool
+Rps_Dumper::emit_json_value(Rps_DumperJsonEmitter&em, Rps_Value val, bool scalaronly)
+{
+  if (!val || val.is_empty() || !is_dumpable_value(val))
+    em.write_null();
+  else if (val.is_int())
+    em.write_int(val.as_int());
+  else if (val.is_immediate_double())
+    em.write_real(val.as_double());
+  else if (val.is_string())
+    {
+      // see Rps_String::dump_json_cstr
+      const char*cstr = val.as_cstring();
+      if (cstr[0] == '_')
+        {
+          if (scalaronly)
+            return false;
+          em.open_object();
+          em.member_name("str", 3, true);
+          em.write_string(cstr, strlen(cstr));
+          em.close_object();
+        }
+      else
+        em.write_string(cstr, strlen(cstr));
+    }
+  else if (val.is_object())
+    em.write_oid(val.to_object()->oid());
+  else if (val.is_ptr())
+    {
+      Json::Value jv = val.to_ptr()->dump_json(this);
+      if (scalaronly && (jv.isArray() || jv.isObject()) && !jv.empty())
+        return false;
+      em.write_value(jv);
+    }
+  else
+    em.write_null();
+  return true;
+} // end Rps_Dumper::emit_json_value
+
+
+/// Stream the JSON text of a dumped object, exactly as the
+/// Json::Value built by Rps_ObjectZone::dump_json_content, with its
+/// "oid", would be written. Its members are sorted, and those of the
+/// payload, which still builds a Json::Value, are merged with the
+/// others, replacing them on the same name.
 void
-Rps_Dumper::write_space_file(Rps_ObjectRef spacobr)
+Rps_Dumper::emit_object_json(Rps_DumperJsonEmitter&em, Rps_ObjectRef obr)
+{
+  RPS_ASSERT(obr);
+  Rps_ObjectZone*obz = obr.optr();
+  std::lock_guard<std::recursive_mutex> gu(obz->ob_mtx);
+  Rps_ObjectZone* obcla = obz->ob_class.load();
+  RPS_ASSERT(obcla != nullptr);
+  Rps_Payload*payl = obz->ob_payload.load();
+  if (payl && payl->owner() != obz)
+    payl = nullptr;
+  Json::Value jpayl(Json::objectValue);
+  std::string paylname;
+  if (payl)
+    {
+      paylname = payl->payload_type_name();
+      payl->dump_json_content(this, jpayl);
+    }
+  // the object's own members, sorted by name
+  enum objmember_en { om_applying, om_attrs, om_class, om_comps, om_magicattr,
+                      om_mtime, om_oid, om_payload, om__last
+                    };
+  static const char*const membernames[om__last] =
+  {
+    "applying", "attrs", "class", "comps", "magicattr",
+    "mtime", "oid", "payload"
+  };
+  bool present[om__last] =
+  {
+    obz->ob_applyingfun.load() != nullptr, !obz->ob_attrs.empty(), true, !obz->ob_comps.empty(),
+    obz->ob_magicgetterfun.load() != nullptr, true, true, payl != nullptr
+  };
+  auto emit_own_member = [&](objmember_en om)
+  {
+    switch (om)
+      {
+      case om_applying:
+      case om_magicattr:
+        em.write_bool(true);
+        break;
+      case om_attrs:
+      {
+        bool first = true;
+        for (auto& atit: obz->ob_attrs)
+          {
+            Rps_ObjectRef atob = atit.first;
+            Rps_Value atval = atit.second;
+            if (!is_dumpable_objref(atob) || !is_dumpable_objattr(atob)
+                || !is_dumpable_value(atval))
+              continue;
+            if (first)
+              em.open_multiline_array();
+            em.element_start(first);
+            first = false;
+            em.open_object();
+            em.member_name("at", 2, true);
+            em.write_oid(atob->oid());
+            em.member_name("va", 2, false);
+            emit_json_value(em, atval);
+            em.close_object();
+            em.element_end();
+          }
+        if (first)
+          em.write_empty_array();
+        else
+          em.close_multiline_array();
+      }
+      break;
+      case om_class:
+        if (is_dumpable_objref(obcla))
+          em.write_oid(obcla->oid());
+        else
+          em.write_null();
+        break;
+      case om_comps:
+      {
+        const std::vector<Rps_Value>& comps = obz->ob_comps;
+        size_t nbcomps = comps.size();
+        size_t off = em.open_line_array(nbcomps);
+        if (off != Rps_DumperJsonEmitter::dje_nolinearray)
+          {
+            bool scalars = true;
+            for (size_t ix=0; ix<nbcomps && scalars; ix++)
+              {
+                if (ix > 0)
+                  em.line_array_separator();
+                scalars = emit_json_value(em, comps[ix], true);
+              }
+            if (!scalars)
+              em.cancel_line_array(off);
+            else if (em.close_line_array(off))
+              break;
+          }
+        em.open_multiline_array();
+        for (size_t ix=0; ix<nbcomps; ix++)
+          {
+            em.element_start(ix == 0);
+            emit_json_value(em, comps[ix]);
+            em.element_end();
+          }
+        em.close_multiline_array();
+      }
+      break;
+      case om_mtime:
+      {
+        // see Rps_ObjectZone::dump_json_content for the centisecond
+        char mtbuf[32];
+        snprintf(mtbuf, sizeof(mtbuf), "%.2f", obz->get_mtime());
+        em.write_real(atof(mtbuf));
+      }
+      break;
+      case om_oid:
+        em.write_oid(obz->oid());
+        break;
+      case om_payload:
+        em.write_string(paylname.c_str(), paylname.size());
+        break;
+      default:
+        RPS_FATALOUT("Rps_Dumper::emit_object_json bad member #" << (int)om);
+      }
+  };
+  em.open_object();
+  bool first = true;
+  int omix = 0;
+  auto pit = jpayl.begin();
+  const auto pend = jpayl.end();
+  for (;;)
+    {
+      while (omix < om__last && !present[omix])
+        omix++;
+      if (omix >= om__last && pit == pend)
+        break;
+      const char*pnameend = nullptr;
+      const char*pname = (pit != pend) ? pit.memberName(&pnameend) : nullptr;
+      int cmp = 0;	// <0 for the own member, >0 for the payload one
+      if (omix >= om__last)
+        cmp = 1;
+      else if (!pname)
+        cmp = -1;
+      else
+        cmp = std::string_view(membernames[omix]).compare(std::string_view(pname, pnameend-pname));
+      if (cmp < 0)
+        {
+          em.member_name(membernames[omix], strlen(membernames[omix]), first);
+          emit_own_member((objmember_en)omix);
+          omix++;
+        }
+      else
+        {
+          em.member_name(pname, pnameend-pname, first);
+          em.write_value(*pit);
+          pit++;
+          if (cmp == 0)
+            omix++;
+        }
+      first = false;
+    }
+  em.close_object();
+} // end Rps_Dumper::emit_object_json
+
+
+/// each dumping thread reuses its emitter for every space
+Rps_DumperJsonEmitter&
+Rps_Dumper::thread_json_emitter(void)
+{
+  static thread_local Rps_DumperJsonEmitter em;
+  return em;
+} // end Rps_Dumper::thread_json_emitter
+
+
+/// append to the emitter buffer the chunk of an object, from its
+/// //+ob line to its //-ob line
+void
+Rps_Dumper::emit_object_chunk(Rps_DumperJsonEmitter&em, Rps_ObjectRef obr)
 {
-  du_space_st* curspa = nullptr;
+  RPS_ASSERT(obr);
+  std::string& buf = em.buffer();
+  char oidbuf[Rps_Id::buflen];
+  obr->oid().to_cbuf24(oidbuf);
+  buf.append("\n\n//+ob").append(oidbuf).append("\n");
+  /// output a comment giving the class name for readability
   {
-    std::lock_guard<std::recursive_mutex> gu(du_mtx);
-    curspa = du_spacemap[spacobr].get();
+    Rps_ObjectRef obclass = obr->get_class();
+    auto itclass = obclass ? du_classnamemap.find(obclass) : du_classnamemap.end();
+    if (itclass != du_classnamemap.end() && !itclass->second.empty())
+      buf.append("//∈" /*U+2208 ELEMENT OF*/).append(itclass->second).append("\n");
+    else
+      RPS_WARNOUT("Rps_Dumper::emit_object_chunk no obsymb for obr " << oidbuf);
   }
+  em.begin_root();
+  emit_object_json(em, obr);
+  buf.append("\n//-ob").append(oidbuf).append("\n");
+} // end Rps_Dumper::emit_object_chunk
+
+
+/// The space file is written thru a Rps_DumperJsonEmitter, whose
+/// buffer goes to the file by big blocks. The chunks captured by a
+/// concurrent dump are copied as is.
+void
+Rps_Dumper::write_space_file(Rps_ObjectRef spacobr)
+{
+  RPS_ASSERT(du_scandone.load());
+  auto itspace = du_spacemap.find(spacobr);
+  RPS_ASSERT(itspace != du_spacemap.end());
+  const du_space_st* curspa = itspace->second.get();
   RPS_ASSERT(curspa);
-  std::string curelpath;
-  std::set<Rps_ObjectRef> curspaset;
-  Rps_Id spacid;
-  std::unique_ptr<std::ofstream> pouts;
-  std::unique_ptr<Json::StreamWriter> jsonwriter(du_jsonwriterbuilder.newStreamWriter());
-  {
-    std::lock_guard<std::recursive_mutex> gu(du_mtx);
-    spacid = curspa->sp_id;
-    curelpath = std::string{"persistore/sp"} + spacid.to_string() + "-rps.json";
-    pouts = open_output_file(curelpath);
-    curspaset = curspa->sp_setob;
-  }
+  const Rps_Id spacid = curspa->sp_id;
+  const std::set<Rps_ObjectRef>& curspaset = curspa->sp_setob;
+  std::string curelpath = std::string{"persistore/sp"} + spacid.to_string() + "-rps.json";
+  std::unique_ptr<std::ofstream> pouts = open_output_file(curelpath);
   RPS_ASSERT(pouts);
   rps_emit_gplv3_copyright_notice(*pouts, curelpath, "//// ", "");
-  *pouts << std::endl;
+  Rps_DumperJsonEmitter& em = thread_json_emitter();
+  std::string& buf = em.buffer();
+  constexpr size_t flushsize = 1<<16;
+  buf.clear();
+  buf.append("\n");
   // emit the prologue
   {
-    *pouts << std::endl
-           << "///!!! prologue of RefPerSys space file:" << std::endl;
+    buf.append("\n///!!! prologue of RefPerSys space file:\n");
     Json::Value jprologue(Json::objectValue);
     jprologue["format"] = Json::Value (RPS_MANIFEST_FORMAT);
     jprologue["spaceid"] = Json::Value (spacid.to_string());
     jprologue["nbobjects"] = Json::Value ((int)(curspaset.size()));
-    jsonwriter->write(jprologue, pouts.get());
-    *pouts << std::endl;
+    em.begin_root();
+    em.write_value(jprologue);
+    buf.append("\n");
   }
   int count = 0;
   for (auto curobr: curspaset)
     {
-      *pouts << std::endl << std::endl;
       ++count;
-      *pouts << "//+ob" << curobr->oid().to_string() << std::endl;
-      RPS_NOPRINTOUT("Rps_Dumper::write_space_file emits " << (curobr->oid().to_string())
-                     << " of hi=" <<  (curobr->oid().hi())
+      RPS_NOPRINTOUT("Rps_Dumper::write_space_file emits " << curobr->oid()
                      << " #" << count);
-      /// output a comment giving the class name for readability
+      auto ittext = curspa->sp_textmap.find(curobr);
+      if (ittext != curspa->sp_textmap.end())
+        buf.append(ittext->second);
+      else
+        emit_object_chunk(em, curobr);
+      if (buf.size() >= flushsize)
+        {
+          pouts->write(buf.data(), buf.size());
+          buf.clear();
+        }
+    }
+  buf.append("\n\n//// end of RefPerSys generated space file ").append(curelpath).append("\n");
+  pouts->write(buf.data(), buf.size());
+  buf.clear();
+  pouts->flush();
+  if (pouts->fail())
+    throw std::runtime_error(std::string("failed to write space file ")
+                             + temporary_opened_path(curelpath));
+  RPS_DEBUG_LOG(DUMP, "dumper write_space_file end " << curelpath << " with " << count << " objects." << std::endl);
+} // end Rps_Dumper::write_space_file
+
+
+/// Write the binary snapshot from the space files just written, still
+/// under their temporary names, or kept unchanged by an incremental
+/// dump: their object chunks are found and parsed into tapes exactly
+/// like the loader would do.
+void
+Rps_Dumper::write_snapshot_file(void)
+{
+  RPS_DEBUG_LOG(DUMP, "dumper write_snapshot_file start");
+  double startrealt = rps_elapsed_real_time();
+  std::vector<Rps_Id> spacidvec;
+  {
+    std::lock_guard<std::recursive_mutex> gu(du_mtx);
+    for (auto it: du_spacemap)
+      spacidvec.push_back(it.second->sp_id);
+  }
+  std::vector<Rps_SnapshotSpace> spacevec;
+  std::vector<Rps_SnapshotObject> objvec;
+  std::vector<std::uint64_t> wordvec;
+  std::string strpool;
+  std::unordered_map<std::string,std::uint64_t> internmap;
+  auto internfun = [&](std::string_view sv)
+  {
+    std::string str(sv);
+    auto it = internmap.find(str);
+    if (it != internmap.end())
+      return it->second;
+    std::uint64_t off = strpool.size();
+    strpool.append(sv);
+    internmap.insert({str, off});
+    return off;
+  };
+  Rps_LoaderJsonTape tape;
+  for (Rps_Id spacid: spacidvec)
+    {
+      std::string curelpath = std::string{"persistore/sp"} + spacid.to_string() + "-rps.json";
+      std::string spacepath;
       {
-        Rps_ObjectRef obclass = curobr->get_class();
-        Rps_ObjectRef obsymb;
-        if (obclass)
-          {
-            RPS_NOPRINTOUT("Rps_Dumper::write_space_file obclass " << obclass->oid().to_string()
-                           << " for obr " <<curobr->oid().to_string());
-            usleep(1000);
-            std::lock_guard<std::recursive_mutex> gu(*(obclass->objmtxptr()));
-            auto classinfo = obclass->get_dynamic_payload<Rps_PayloadClassInfo>();
-            if (classinfo)
-              obsymb = classinfo->symbname();
-          };
-        if (obsymb)
-          {
-            RPS_NOPRINTOUT("Rps_Dumper::write_space_file obsymb " << obsymb->oid().to_string()
-                           << " for obr " <<curobr->oid().to_string());
-            std::lock_guard<std::recursive_mutex> gu(*(obsymb->objmtxptr()));
-            auto symb = obsymb->get_dynamic_payload<Rps_PayloadSymbol>();
-            if (symb)
-              *pouts << "//∈" /*U+2208 ELEMENT OF*/
-                     << symb->symbol_name() << std::endl;
-          }
+        std::lock_guard<std::recursive_mutex> gu(du_mtx);
+        if (du_openedpathset.find(curelpath) != du_openedpathset.end())
+          spacepath = temporary_opened_path(curelpath);
         else
-          RPS_WARNOUT("Rps_Dumper::write_space_file no obsymb for obr "
-                      <<curobr->oid().to_string());
-
+          spacepath = du_topdir + "/" + curelpath;
+      }
+      std::string_view spaceview = rps_map_readonly_file(spacepath);
+      const char*filestart = spaceview.data();
+      const char*fileend = filestart + spaceview.size();
+      std::uint32_t spaceix = (std::uint32_t) spacevec.size();
+      spacevec.push_back(Rps_SnapshotSpace{spacid.hi(), spacid.lo(), spaceview.size(),
+                                           rps_snapshot_checksum(filestart, spaceview.size())});
+      /// renaming the temporary file keeps its size and mtime
+      {
+        std::uint64_t filesize = 0;
+        std::int64_t mtimens = 0;
+        if (!rps_file_stamp(spacepath, &filesize, &mtimens))
+          throw std::runtime_error(std::string("cannot stat space file ") + spacepath);
+        Json::Value jstamp(Json::objectValue);
+        jstamp["size"] = Json::Value ((Json::UInt64)filesize);
+        jstamp["mtime_ns"] = Json::Value ((Json::Int64)mtimens);
+        jstamp["checksum"] = Json::Value (rps_snapshot_checksum_string(spacevec.back().sns_checksum));
+        du_snapshotspacesjson[spacid.to_string()] = jstamp;
       }
-      Json::Value jobject(Json::objectValue);
-      jobject["oid"] = Json::Value (curobr->oid().to_string());
-      curobr->dump_json_content(this,jobject);
-      jsonwriter->write(jobject, pouts.get());
-      *pouts << std::endl;
-      *pouts << "//-ob" << curobr->oid().to_string() << std::endl;
+      // each chunk goes from its //+ob line to the next one
+      const char*curp = filestart;
+      if (spaceview.substr(0, 5) != "//+ob")
+        {
+          const char*nl = (const char*)memmem(filestart, spaceview.size(), "\n//+ob", 6);
+          curp = nl ? (nl+1) : fileend;
+        }
+      unsigned lincnt = 1 + (unsigned) std::count(filestart, curp, '\n');
+      while (curp < fileend)
+        {
+          const char*nextp = (const char*)memmem(curp+1, fileend-(curp+1), "\n//+ob", 6);
+          nextp = nextp ? (nextp+1) : fileend;
+          Rps_Id curobjid;
+          if (fileend - curp > 5 + (long)Rps_Id::nbchars)
+            curobjid = Rps_Id(std::string(curp+5, Rps_Id::nbchars));
+          if (!curobjid.valid())
+            RPS_FATALOUT("Rps_Dumper::write_snapshot_file bad object line#" << lincnt
+                         << " in " << curelpath);
+          std::string_view chunkview(curp, nextp - curp);
+          try
+            {
+              tape.parse(chunkview);
+            }
+          catch (const std::exception& exc)
+            {
+              RPS_FATALOUT("Rps_Dumper::write_snapshot_file failed to parse object " << curobjid
+                           << " line#" << lincnt << " in " << curelpath << ": " << exc.what());
+            }
+          objvec.push_back(Rps_SnapshotObject{curobjid.hi(), curobjid.lo(), spaceix, lincnt,
+                                              (std::uint64_t)(curp - filestart), chunkview.size(),
+                                              wordvec.size(), tape.nb_words()});
+          tape.relocate_strings(wordvec, internfun);
+          lincnt += (unsigned) std::count(curp, nextp, '\n');
+          curp = nextp;
+        }
+      if (spaceview.size() > 0)
+        munmap((void*)spaceview.data(), spaceview.size());
     }
-
-  *pouts << std::endl << std::endl;
-  *pouts << "//// end of RefPerSys generated space file " << curelpath << std::endl;
-  RPS_DEBUG_LOG(DUMP, "dumper write_space_file end " << curelpath << " with " << count << " objects." << std::endl);
-} // end Rps_Dumper::write_space_file
+  strpool.resize((strpool.size() + sizeof(std::uint64_t) - 1) & ~(sizeof(std::uint64_t) - 1));
+  Rps_SnapshotHeader snaphdr;
+  memset (&snaphdr, 0, sizeof(snaphdr));
+  memcpy(snaphdr.snh_magic, RPS_SNAPSHOT_MAGIC, sizeof(snaphdr.snh_magic));
+  snaphdr.snh_version = RPS_SNAPSHOT_VERSION;
+  snaphdr.snh_nbspaces = spacevec.size();
+  snaphdr.snh_nbobjects = objvec.size();
+  snaphdr.snh_nbwords = wordvec.size();
+  snaphdr.snh_strbytes = strpool.size();
+  std::string snapbuf;
+  snapbuf.reserve(sizeof(snaphdr) + spacevec.size()*sizeof(Rps_SnapshotSpace)
+                  + objvec.size()*sizeof(Rps_SnapshotObject)
+                  + wordvec.size()*sizeof(std::uint64_t) + strpool.size());
+  snapbuf.append((const char*)&snaphdr, sizeof(snaphdr));
+  snapbuf.append((const char*)spacevec.data(), spacevec.size()*sizeof(Rps_SnapshotSpace));
+  snapbuf.append((const char*)objvec.data(), objvec.size()*sizeof(Rps_SnapshotObject));
+  snapbuf.append((const char*)wordvec.data(), wordvec.size()*sizeof(std::uint64_t));
+  snapbuf.append(strpool);
+  auto pouts = open_output_file(RPS_SNAPSHOT_BIN);
+  pouts->write(snapbuf.data(), snapbuf.size());
+  pouts->close();
+  if (pouts->fail())
+    throw std::runtime_error(std::string("failed to write binary snapshot ")
+                             + temporary_opened_path(RPS_SNAPSHOT_BIN));
+  du_snapshotchecksum = rps_snapshot_checksum_string(rps_snapshot_checksum(snapbuf.data(), snapbuf.size()));
+  du_snapshotnbobjects = objvec.size();
+  char realtbuf[32];
+  memset(realtbuf, 0, sizeof(realtbuf));
+  snprintf(realtbuf, sizeof(realtbuf), "%.3f", rps_elapsed_real_time() - startrealt);
+  RPS_INFORMOUT("wrote binary snapshot " << RPS_SNAPSHOT_BIN << " of " << snapbuf.size()
+                << " bytes with " << objvec.size() << " objects, " << internmap.size()
+                << " interned strings in " << realtbuf << " elapsed seconds");
+} // end Rps_Dumper::write_snapshot_file
 
 
 
@@ -2306,8 +5057,15 @@ void rps_dump_into (const std::string dirpath, Rps_CallFrame* callframe)
   {
     RPS_ASSERT(strrchr(realdirpath.c_str(), '/') != nullptr);
   }
+  /// When the agenda is running, its worker threads go on during most
+  /// of the dump: they are only paused to complete its capture, and
+  /// garbage collection is deferred meanwhile.
+  bool concurrent = Rps_Agenda::is_running();
+  bool paused = false;
+  if (concurrent)
+    Rps_Agenda::defer_garbage_collection();
   Rps_Dumper dumper(realdirpath, &_);
-  RPS_INFORMOUT("start dumping into " << dumper.get_top_dir()
+  RPS_INFORMOUT("start " << (concurrent?"concurrent ":"") << "dumping into " << dumper.get_top_dir()
                 << " with temporary suffix " << dumper.get_temporary_suffix());
   try
     {
@@ -2342,10 +5100,32 @@ void rps_dump_into (const std::string dirpath, Rps_CallFrame* callframe)
                     << (rps_process_cpu_time() - startcputime)
                     << " cpu seconds." << std::endl
                     << Rps_ShowCallFrame(&_));
-      dumper.write_all_space_files();
-      dumper.write_all_generated_files();
+      if (concurrent)
+        {
+          dumper.capture_all_space_texts();
+          double pausedelapsed = rps_elapsed_real_time();
+          Rps_Agenda::pause_workers();
+          paused = true;
+          dumper.complete_capture_while_paused();
+          Rps_Agenda::resume_workers();
+          paused = false;
+          RPS_INFORMOUT("dump into " << dumper.get_top_dir() << " paused the agenda during "
+                        << (rps_elapsed_real_time() - pausedelapsed) << " wallclock seconds");
+          dumper.write_all_space_files();
+        }
+      else
+        {
+          dumper.write_all_space_files();
+          dumper.write_all_generated_files();
+        }
+      if (rps_dump_snapshot)
+        dumper.write_snapshot_file();
       dumper.write_manifest_file();
       dumper.rename_opened_files();
+      dumper.put_space_dump_records();
+      rps_journal_after_dump(realdirpath, rps_dump_start_wallclock_time(&dumper));
+      if (concurrent)
+        Rps_Agenda::allow_garbage_collection();
       double endelapsed = rps_elapsed_real_time();
       double endcputime = rps_process_cpu_time();
       RPS_INFORMOUT("dump into " << dumper.get_top_dir()
@@ -2362,11 +5142,344 @@ void rps_dump_into (const std::string dirpath, Rps_CallFrame* callframe)
                   << typeid(exc).name()
                   << ":"
                   << exc.what());
+      if (paused)
+        Rps_Agenda::resume_workers();
+      if (concurrent)
+        Rps_Agenda::allow_garbage_collection();
       throw;
     };
   ///
 } // end of rps_dump_into
 
+//////////////////////////////////////////////// write-ahead journal
+/// With --journal, every object touched after loading is noted, and
+/// the journal thread appends, every jr_groupdelay, the chunks of the
+/// noted objects as a group to the RPS_JOURNAL_FILE of the load
+/// directory, then fdatasync-s it. Several mutations of the same
+/// object in a group give only one chunk, of its latest state, emitted
+/// like in space files; transient objects are not journaled. The
+/// noted objects are marked by the garbage collector till their group
+/// is written. So every persistent payload should touch its owner
+/// when mutated, see Rps_Payload::touches_owner_on_mutation. Any dump
+/// into a directory with a journal drops the
+/// chunks emitted before it started, even without --journal, since
+/// the loader replays every journal it finds.
+std::atomic<bool> rps_journal_active;
+
+class Rps_Journal
+{
+  friend void rps_journal_note_mutation(Rps_ObjectZone*obz);
+  friend void rps_journal_start(const std::string& dirpath);
+  friend void rps_journal_stop(void);
+  friend void rps_journal_after_dump(const std::string& dirpath, double dumpstarttime);
+  friend void rps_journal_gc_mark(Rps_GarbageCollector*gc);
+  /// jr_mtx protects the noted objects, and jr_filemtx the file
+  static std::mutex jr_mtx;
+  static std::mutex jr_filemtx;
+  static std::condition_variable jr_condvar;
+  static std::string jr_dir;
+  static int jr_fd;
+  static bool jr_stopping;
+  static std::set<Rps_ObjectRef> jr_noteset;
+  static std::vector<Rps_ObjectRef> jr_groupvec;
+  static std::unique_ptr<Rps_Dumper> jr_dumper;
+  static std::thread jr_thread;
+  static unsigned long jr_nbgroups;
+  static unsigned long jr_nbchunks;
+  static constexpr std::chrono::milliseconds jr_groupdelay{20};
+  static std::string journal_path(void)
+  {
+    return jr_dir + "/" + RPS_JOURNAL_FILE;
+  };
+  static void open_journal_file(void);
+  static void write_to_journal(const std::string& buf);
+  static void commit_group(void);
+  static void run_journal_thread(void);
+  static void drop_chunks_before(const std::string& journalpath, double dumpstarttime);
+};				// end class Rps_Journal
+
+std::mutex Rps_Journal::jr_mtx;
+std::mutex Rps_Journal::jr_filemtx;
+std::condition_variable Rps_Journal::jr_condvar;
+std::string Rps_Journal::jr_dir;
+int Rps_Journal::jr_fd = -1;
+bool Rps_Journal::jr_stopping;
+std::set<Rps_ObjectRef> Rps_Journal::jr_noteset;
+std::vector<Rps_ObjectRef> Rps_Journal::jr_groupvec;
+std::unique_ptr<Rps_Dumper> Rps_Journal::jr_dumper;
+std::thread Rps_Journal::jr_thread;
+unsigned long Rps_Journal::jr_nbgroups;
+unsigned long Rps_Journal::jr_nbchunks;
+
+void
+Rps_Journal::open_journal_file(void)
+{
+  std::string journalpath = journal_path();
+  jr_fd = open(journalpath.c_str(), O_WRONLY|O_APPEND|O_CREAT|O_CLOEXEC, 0640);
+  if (jr_fd < 0)
+    RPS_FATAL("failed to open journal %s: %m", journalpath.c_str());
+  struct stat journalstat;
+  memset (&journalstat, 0, sizeof(journalstat));
+  if (!fstat(jr_fd, &journalstat) && journalstat.st_size == 0)
+    write_to_journal("//// write-ahead journal of RefPerSys, replayed by its loader\n");
+} // end Rps_Journal::open_journal_file
+
+void
+Rps_Journal::write_to_journal(const std::string& buf)
+{
+  RPS_ASSERT(jr_fd >= 0);
+  size_t off = 0;
+  while (off < buf.size())
+    {
+      ssize_t wcnt = write(jr_fd, buf.data() + off, buf.size() - off);
+      if (wcnt < 0 && errno == EINTR)
+        continue;
+      if (wcnt <= 0)
+        RPS_FATAL("failed to write %zd bytes into journal %s: %m",
+                  buf.size() - off, journal_path().c_str());
+      off += wcnt;
+    }
+} // end Rps_Journal::write_to_journal
+
+/// Emit and write the chunks of the objects noted till now as a
+/// group, then sync the journal. Mutations noted meanwhile go to the
+/// next group.
+void
+Rps_Journal::commit_group(void)
+{
+  std::lock_guard<std::mutex> gufile(jr_filemtx);
+  {
+    std::lock_guard<std::mutex> gu(jr_mtx);
+    RPS_ASSERT(jr_groupvec.empty());
+    jr_groupvec.assign(jr_noteset.begin(), jr_noteset.end());
+    jr_noteset.clear();
+  }
+  if (jr_groupvec.empty() || jr_fd < 0)
+    {
+      std::lock_guard<std::mutex> gu(jr_mtx);
+      jr_groupvec.clear();
+      return;
+    }
+  Rps_DumperJsonEmitter& em = Rps_Dumper::thread_json_emitter();
+  std::string& buf = em.buffer();
+  buf.clear();
+  unsigned nbchunks = 0;
+  char oidbuf[Rps_Id::buflen];
+  char spacidbuf[Rps_Id::buflen];
+  char timebuf[32];
+  for (Rps_ObjectRef curobr: jr_groupvec)
+    {
+      Rps_ObjectRef obrspace = curobr->get_space();
+      if (!obrspace)
+        continue;
+      curobr->oid().to_cbuf24(oidbuf);
+      obrspace->oid().to_cbuf24(spacidbuf);
+      snprintf(timebuf, sizeof(timebuf), "%.3f", rps_wallclock_real_time());
+      buf.append("//+jr").append(oidbuf).append(" ").append(spacidbuf)
+      .append(" ").append(timebuf).append("\n");
+      em.begin_root();
+      jr_dumper->emit_object_json(em, curobr);
+      buf.append("\n//-jr").append(oidbuf).append("\n");
+      nbchunks++;
+    }
+  if (nbchunks > 0)
+    {
+      char groupbuf[64];
+      snprintf(groupbuf, sizeof(groupbuf), "//=jrgroup %u\n", nbchunks);
+      buf.append(groupbuf);
+      write_to_journal(buf);
+      if (fdatasync(jr_fd))
+        RPS_FATAL("failed to sync journal %s: %m", journal_path().c_str());
+      jr_nbgroups++;
+      jr_nbchunks += nbchunks;
+    }
+  buf.clear();
+  std::lock_guard<std::mutex> gu(jr_mtx);
+  jr_groupvec.clear();
+} // end Rps_Journal::commit_group
+
+void
+Rps_Journal::run_journal_thread(void)
+{
+  pthread_setname_np(pthread_self(), "rps-journal");
+  for (;;)
+    {
+      bool stopping = false;
+      {
+        std::unique_lock<std::mutex> lk(jr_mtx);
+        jr_condvar.wait_for(lk, jr_groupdelay, []
+        {
+          return jr_stopping;
+        });
+        stopping = jr_stopping;
+      }
+      commit_group();
+      if (stopping)
+        break;
+    }
+} // end Rps_Journal::run_journal_thread
+
+/// Rewrite some journal with only the committed chunks emitted after
+/// the start of a dump, in a single group. The new journal and its
+/// directory are synced before it is used.
+void
+Rps_Journal::drop_chunks_before(const std::string& journalpath, double dumpstarttime)
+{
+  std::lock_guard<std::mutex> gufile(jr_filemtx);
+  std::string_view journalview = rps_map_readonly_file(journalpath);
+  std::string newbuf("//// write-ahead journal of RefPerSys, replayed by its loader\n");
+  unsigned nbkept = 0;
+  rps_journal_each_committed_chunk(journalview, [&](const Rps_JournalChunk&jc)
+  {
+    if (jc.jc_time < dumpstarttime)
+      return;
+    newbuf.append(jc.jc_view);
+    nbkept++;
+  });
+  if (journalview.size() > 0)
+    munmap((void*)journalview.data(), journalview.size());
+  if (nbkept > 0)
+    {
+      char groupbuf[64];
+      snprintf(groupbuf, sizeof(groupbuf), "//=jrgroup %u\n", nbkept);
+      newbuf.append(groupbuf);
+    }
+  std::string temppath = journalpath + "%";
+  int tempfd = open(temppath.c_str(), O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0640);
+  if (tempfd < 0)
+    throw std::runtime_error(std::string("failed to open journal ") + temppath
+                             + ":" + strerror(errno));
+  size_t off = 0;
+  while (off < newbuf.size())
+    {
+      ssize_t wcnt = write(tempfd, newbuf.data() + off, newbuf.size() - off);
+      if (wcnt < 0 && errno == EINTR)
+        continue;
+      if (wcnt <= 0)
+        {
+          int e = errno;
+          close(tempfd);
+          throw std::runtime_error(std::string("failed to write journal ") + temppath
+                                   + ":" + strerror(e));
+        }
+      off += wcnt;
+    }
+  if (fsync(tempfd))
+    {
+      int e = errno;
+      close(tempfd);
+      throw std::runtime_error(std::string("failed to sync journal ") + temppath
+                               + ":" + strerror(e));
+    }
+  close(tempfd);
+  if (rename(temppath.c_str(), journalpath.c_str()))
+    throw std::runtime_error(std::string("failed to rename journal ") + temppath
+                             + " to " + journalpath + ":" + strerror(errno));
+  /// the rename is durable only once the directory is synced
+  {
+    std::string dirpath = journalpath.substr(0, journalpath.rfind('/'));
+    int dirfd = open(dirpath.c_str(), O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+    if (dirfd < 0 || fsync(dirfd))
+      {
+        int e = errno;
+        if (dirfd >= 0)
+          close(dirfd);
+        throw std::runtime_error(std::string("failed to sync directory ") + dirpath
+                                 + " of journal:" + strerror(e));
+      }
+    close(dirfd);
+  }
+  if (jr_fd >= 0 && journalpath == journal_path())
+    {
+      close(jr_fd);
+      jr_fd = -1;
+      open_journal_file();
+    }
+  RPS_INFORMOUT("kept " << nbkept << " chunks in journal " << journalpath
+                << " after dump");
+} // end Rps_Journal::drop_chunks_before
+
+void
+rps_journal_note_mutation(Rps_ObjectZone*obz)
+{
+  RPS_ASSERT(obz);
+  RPS_ASSERT(obz->get_mtime() >= 0.0); // not a dying object
+  std::lock_guard<std::mutex> gu(Rps_Journal::jr_mtx);
+  Rps_Journal::jr_noteset.insert(Rps_ObjectRef(obz));
+} // end rps_journal_note_mutation
+
+void
+rps_journal_gc_mark(Rps_GarbageCollector*gc)
+{
+  RPS_ASSERT(gc);
+  if (!rps_journal_active.load())
+    return;
+  std::lock_guard<std::mutex> gu(Rps_Journal::jr_mtx);
+  for (Rps_ObjectRef obr: Rps_Journal::jr_noteset)
+    gc->mark_obj(obr);
+  for (Rps_ObjectRef obr: Rps_Journal::jr_groupvec)
+    gc->mark_obj(obr);
+} // end rps_journal_gc_mark
+
+void
+rps_journal_start(const std::string& dirpath)
+{
+  RPS_ASSERT(rps_is_main_thread());
+  if (rps_journal_active.load())
+    return;
+  char* rp = realpath(dirpath.c_str(), nullptr);
+  if (!rp)
+    RPS_FATAL("cannot journal into %s: %m", dirpath.c_str());
+  Rps_Journal::jr_dir = rp;
+  free (rp);
+  Rps_Journal::open_journal_file();
+  /// that dumper is only used to emit the object chunks
+  Rps_Journal::jr_dumper = std::make_unique<Rps_Dumper>(Rps_Journal::jr_dir, nullptr);
+  Rps_Journal::jr_stopping = false;
+  rps_journal_active.store(true);
+  Rps_Journal::jr_thread = std::thread(Rps_Journal::run_journal_thread);
+  RPS_INFORMOUT("journaling mutated objects into " << Rps_Journal::journal_path());
+} // end rps_journal_start
+
+void
+rps_journal_stop(void)
+{
+  RPS_ASSERT(rps_is_main_thread());
+  if (!rps_journal_active.load())
+    return;
+  {
+    std::lock_guard<std::mutex> gu(Rps_Journal::jr_mtx);
+    Rps_Journal::jr_stopping = true;
+  }
+  Rps_Journal::jr_condvar.notify_all();
+  Rps_Journal::jr_thread.join();
+  rps_journal_active.store(false);
+  close(Rps_Journal::jr_fd);
+  Rps_Journal::jr_fd = -1;
+  Rps_Journal::jr_dumper.reset();
+  RPS_INFORMOUT("stopped journal " << Rps_Journal::journal_path() << " after "
+                << Rps_Journal::jr_nbgroups << " groups of "
+                << Rps_Journal::jr_nbchunks << " chunks");
+} // end rps_journal_stop
+
+/// after a successful dump into some directory, the chunks of its
+/// journal emitted before the dump started are not needed anymore,
+/// and would revert the dumped state if replayed by the next load
+void
+rps_journal_after_dump(const std::string& dirpath, double dumpstarttime)
+{
+  std::string journalpath = dirpath + "/" + RPS_JOURNAL_FILE;
+  if (rps_journal_active.load() && dirpath == Rps_Journal::jr_dir)
+    {
+      /// what the dump got is journaled before dropping the older chunks
+      Rps_Journal::commit_group();
+      Rps_Journal::drop_chunks_before(journalpath, dumpstarttime);
+    }
+  else if (!access(journalpath.c_str(), F_OK))
+    Rps_Journal::drop_chunks_before(journalpath, dumpstarttime);
+} // end rps_journal_after_dump
+
+
 //////////////////////////////////////////////////////////////// load
 
 void
@@ -2398,6 +5511,16 @@ Rps_Loader::parse_manifest_file(void)
               "%s",
               manifpath.c_str (), RPS_MANIFEST_FORMAT,
               manifjson["format"].toStyledString().c_str());
+  /// the string hash version, absent in manifests dumped with version 1.
+  /// Nothing persistent depends yet on string hashes, so we just tell.
+  {
+    int strhashversion = 1;
+    if (manifjson.isMember("stringhashversion"))
+      strhashversion = manifjson["stringhashversion"].asInt();
+    if (strhashversion != RPS_STRING_HASH_VERSION)
+      RPS_INFORMOUT("manifest " << manifpath << " was dumped with string hash version "
+                    << strhashversion << " but current one is " << RPS_STRING_HASH_VERSION);
+  }
   /// parse spaceset
   {
     auto spsetjson = manifjson["spaceset"];
@@ -2414,6 +5537,32 @@ Rps_Loader::parse_manifest_file(void)
         ld_spaceset.insert({curspid});
       }
   }
+  /// the optional binary snapshot, used only if its checksum is that one
+  if (manifjson.isMember("snapshot"))
+    {
+      auto snapjson = manifjson["snapshot"];
+      if (snapjson.isObject() && snapjson["file"].asString() == RPS_SNAPSHOT_BIN)
+        {
+          ld_snapshotchecksum = snapjson["checksum"].asString();
+          /// without them, every space file is checksummed by load_snapshot
+          const Json::Value& stampsjson = snapjson["spaces"];
+          if (stampsjson.isObject())
+            for (const std::string& spacidstr: stampsjson.getMemberNames())
+              {
+                const Json::Value& stampjson = stampsjson[spacidstr];
+                Rps_Id spacid(spacidstr);
+                if (!spacid.valid() || !stampjson.isObject())
+                  continue;
+                ld_snapshotstamps[spacid] =
+                  snapstamp_st{(std::uint64_t) stampjson["size"].asUInt64(),
+                               (std::int64_t) stampjson["mtime_ns"].asInt64(),
+                               (std::uint64_t) strtoull(stampjson["checksum"].asString().c_str(),
+                                                        nullptr, 16)};
+              }
+        }
+      else
+        RPS_WARNOUT("manifest " << manifpath << " has unexpected snapshot " << snapjson);
+    }
   /// parse globalroots
   {
     auto globrootsjson = manifjson["globalroots"];
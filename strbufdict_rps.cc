@@ -267,6 +267,7 @@ Rps_PayloadStringDict::add(const std::string&str, Rps_Value val)
     dict_map.insert({str,val});
   else if (!str.empty() && !val)
     dict_map.erase(str);
+  touch_owner();
 } // end Rps_PayloadStringDict::add
 
 Rps_Value
@@ -285,12 +286,14 @@ void
 Rps_PayloadStringDict::remove(const std::string&str)
 {
   dict_map.erase(str);
+  touch_owner();
 } // end Rps_PayloadStringDict::remove
 
 void
 Rps_PayloadStringDict::set_transient(bool transient)
 {
   dict_is_transient = transient;
+  touch_owner();
 } // end PayloadStringDict::set_transient
 
 void
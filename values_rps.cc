@@ -195,7 +195,6 @@ Rps_QuasiZone::clear_all_gcmarks(Rps_GarbageCollector&gc)
 } // end of Rps_QuasiZone::clear_all_gcmarks
 
 
-std::mutex Rps_LazyHashedZoneValue::lazy_mtxarr[Rps_LazyHashedZoneValue::lazy_nbmutexes];
 
 
 
@@ -205,11 +204,14 @@ Rps_SetOb::Rps_SetOb(const std::set<Rps_ObjectRef>& setob, Rps_SetTag)
   : Rps_SetOb::Rps_SetOb((unsigned) setob.size(), Rps_SetTag{})
 {
   int ix=0;
+  hasher hs;
   for (auto ob : setob)
     {
       RPS_ASSERT (ob);
+      hs.add(ob);
       _seqob[ix++] = ob;
     }
+  put_precomputed_hash(hs.result());
 } // end Rps_SetOb::Rps_SetOb
 
 
@@ -219,7 +221,7 @@ const Rps_SetOb*
 Rps_SetOb::make(const std::set<Rps_ObjectRef>& setob)
 {
   auto setsiz = setob.size();
-  if (RPS_UNLIKELY(setsiz >= Rps_SeqObjRef::maxsize))
+  if (RPS_UNLIKELY(setsiz > Rps_SeqObjRef::maxsize))
     throw std::length_error("Rps_SetOb::make with too many elements");
   for (auto ob : setob)
     if (RPS_UNLIKELY(!ob))
@@ -232,14 +234,144 @@ Rps_SetOb::make(const std::set<Rps_ObjectRef>& setob)
 
 
 
+Rps_SetOb*
+Rps_SetOb::allocate_for(size_t nbelem)
+{
+  if (RPS_UNLIKELY(nbelem > Rps_SeqObjRef::maxsize))
+    throw std::length_error("Rps_SetOb with too many elements");
+  return rps_allocate_with_wordgap<Rps_SetOb,unsigned,Rps_SetTag>
+         ((unsigned)nbelem, (unsigned)nbelem, Rps_SetTag{});
+} // end Rps_SetOb::allocate_for
+
+
+/// the order of the elements is only known once they are all sorted,
+/// so the hash is computed here, while they are still in cache
+void
+Rps_SetOb::shrink_to(unsigned card)
+{
+  RPS_ASSERT(card <= _seqlen);
+  if (card < _seqlen)
+    memset ((void*)(_seqob+card), 0, sizeof(Rps_ObjectRef)*(_seqlen-card));
+  _seqlen = card;
+  hasher hs;
+  for (unsigned ix=0; ix<card; ix++)
+    hs.add(_seqob[ix]);
+  put_precomputed_hash(hs.result());
+} // end Rps_SetOb::shrink_to
+
+
+/// LSD radix sort, byte per byte, on the high word of oids; the rare
+/// runs of equal high words are then sorted on the low word.
+void
+Rps_SetOb::radix_sort_elements(Rps_ObjectRef*arr, unsigned nbelem)
+{
+  struct keyed_st
+  {
+    uint64_t kd_hi;
+    uint64_t kd_lo;
+    Rps_ObjectZone*kd_ob;
+  };
+  std::vector<keyed_st> keyvec(2*(size_t)nbelem);
+  keyed_st*src = keyvec.data();
+  keyed_st*dst = src + nbelem;
+  for (unsigned ix=0; ix<nbelem; ix++)
+    {
+      Rps_Id oid = arr[ix]->oid();
+      src[ix] = keyed_st{oid.hi(), oid.lo(), arr[ix].optr()};
+    }
+  for (unsigned shift = 0; shift < 64; shift += 8)
+    {
+      unsigned count[256];
+      memset(count, 0, sizeof(count));
+      for (unsigned ix=0; ix<nbelem; ix++)
+        count[(src[ix].kd_hi >> shift) & 0xff]++;
+      // skip the pass when all keys share that byte
+      if (count[(src[0].kd_hi >> shift) & 0xff] == nbelem)
+        continue;
+      unsigned pos = 0;
+      for (unsigned dig=0; dig<256; dig++)
+        {
+          unsigned c = count[dig];
+          count[dig] = pos;
+          pos += c;
+        }
+      for (unsigned ix=0; ix<nbelem; ix++)
+        dst[count[(src[ix].kd_hi >> shift) & 0xff]++] = src[ix];
+      std::swap(src, dst);
+    }
+  for (unsigned ix=0; ix<nbelem; )
+    {
+      unsigned endix = ix+1;
+      while (endix<nbelem && src[endix].kd_hi == src[ix].kd_hi)
+        endix++;
+      if (RPS_UNLIKELY(endix > ix+1))
+        std::sort(src+ix, src+endix,
+                  [](const keyed_st&l, const keyed_st&r)
+        {
+          return l.kd_lo < r.kd_lo;
+        });
+      ix = endix;
+    }
+  for (unsigned ix=0; ix<nbelem; ix++)
+    arr[ix] = Rps_ObjectRef(src[ix].kd_ob);
+} // end Rps_SetOb::radix_sort_elements
+
+
+/// sort in place the nbelem non-empty objects at arr, remove
+/// duplicates, and return their new count.
+unsigned
+Rps_SetOb::sort_dedup_elements(Rps_ObjectRef*arr, unsigned nbelem)
+{
+  if (nbelem <= 1)
+    return nbelem;
+  if (nbelem <= small_sort_threshold)
+    {
+      for (unsigned ix=1; ix<nbelem; ix++)
+        {
+          Rps_ObjectRef curob = arr[ix];
+          int jx = (int)ix - 1;
+          while (jx >= 0 && curob < arr[jx])
+            {
+              arr[jx+1] = arr[jx];
+              jx--;
+            }
+          arr[jx+1] = curob;
+        }
+    }
+  else if (nbelem < radix_sort_threshold)
+    std::sort(arr, arr+nbelem);
+  else
+    radix_sort_elements(arr, nbelem);
+  unsigned card = 1;
+  for (unsigned ix=1; ix<nbelem; ix++)
+    if (arr[ix] != arr[card-1])
+      arr[card++] = arr[ix];
+  return card;
+} // end Rps_SetOb::sort_dedup_elements
+
+
+const Rps_SetOb*
+Rps_SetOb::make_from_range(const Rps_ObjectRef*beg, const Rps_ObjectRef*end)
+{
+  size_t nbelem = 0;
+  for (const Rps_ObjectRef*pob = beg; pob < end; pob++)
+    if (*pob)
+      nbelem++;
+  Rps_SetOb*setob = allocate_for(nbelem);
+  Rps_ObjectRef*arr = setob->raw_data();
+  unsigned ix = 0;
+  for (const Rps_ObjectRef*pob = beg; pob < end; pob++)
+    if (*pob)
+      arr[ix++] = *pob;
+  setob->shrink_to(sort_dedup_elements(arr, ix));
+  return setob;
+} // end Rps_SetOb::make_from_range
+
+
 const Rps_SetOb*
 Rps_SetOb::make(const std::initializer_list<Rps_ObjectRef>&elemil)
 {
-  std::set<Rps_ObjectRef>elemset;
-  for (auto elem: elemil)
-    if (elem)
-      elemset.insert(elem);
-  return make(elemset);
+  return make_from_range(elemil.begin(), elemil.end());
 } // end of Rps_SetOb::make with initializer_list
 
 
@@ -247,40 +379,424 @@ Rps_SetOb::make(const std::initializer_list<Rps_ObjectRef>&elemil)
 const Rps_SetOb*
 Rps_SetOb::make(const std::vector<Rps_ObjectRef>&vecob)
 {
-  std::set<Rps_ObjectRef>elemset;
-  for (auto ob: vecob)
-    if (ob)
-      elemset.insert(ob);
-  return make(elemset);
+  return make_from_range(vecob.data(), vecob.data()+vecob.size());
 } // end of Rps_SetOb::make with vector
 
 
+/// The elements of the given sets are already sorted, so when there
+/// are few of them they are merged in linear time. The other
+/// elements, from objects and tuples, are first put at the end of the
+/// new set and sorted there; the merged output, written from the
+/// start, never overwrites one of them before reading it.
 const Rps_SetOb*
-Rps_SetOb::collect(const std::vector<Rps_Value>&vecval)
+Rps_SetOb::collect_from_range(const Rps_Value*beg, const Rps_Value*end)
 {
-  std::set<Rps_ObjectRef>elemset;
-  for (auto val: vecval)
+  size_t nbloose = 0;
+  size_t nbinsets = 0;
+  unsigned nbsets = 0;
+  for (const Rps_Value*pv = beg; pv < end; pv++)
     {
+      Rps_Value val = *pv;
       if (val.is_object())
-        elemset.insert(Rps_ObjectRef(val.as_object()));
+        nbloose++;
       else if (val.is_tuple())
         {
-          auto tup = val.as_tuple();
-          for (auto ob: *tup)
+          for (auto ob: *val.as_tuple())
             if (ob)
-              elemset.insert(ob);
+              nbloose++;
         }
       else if (val.is_set())
         {
-          auto set = val.as_set();
-          for (auto ob: *set)
-            elemset.insert(ob);
+          unsigned card = val.as_set()->cardinal();
+          if (card > 0)
+            {
+              nbinsets += card;
+              nbsets++;
+            }
+        }
+    }
+  size_t total = nbinsets + nbloose;
+  Rps_SetOb*setob = allocate_for(total);
+  Rps_ObjectRef*arr = setob->raw_data();
+  if (nbsets > collect_merge_maxsets)
+    {
+      unsigned ix = 0;
+      for (const Rps_Value*pv = beg; pv < end; pv++)
+        {
+          Rps_Value val = *pv;
+          if (val.is_object())
+            arr[ix++] = Rps_ObjectRef(val.as_object());
+          else if (val.is_tuple())
+            {
+              for (auto ob: *val.as_tuple())
+                if (ob)
+                  arr[ix++] = ob;
+            }
+          else if (val.is_set())
+            {
+              for (auto ob: *val.as_set())
+                arr[ix++] = ob;
+            }
         }
+      RPS_ASSERT(ix == total);
+      setob->shrink_to(sort_dedup_elements(arr, ix));
+      return setob;
     }
-  return make(elemset);
+  Rps_ObjectRef*loose = arr + nbinsets;
+  {
+    unsigned ix = 0;
+    for (const Rps_Value*pv = beg; pv < end; pv++)
+      {
+        Rps_Value val = *pv;
+        if (val.is_object())
+          loose[ix++] = Rps_ObjectRef(val.as_object());
+        else if (val.is_tuple())
+          {
+            for (auto ob: *val.as_tuple())
+              if (ob)
+                loose[ix++] = ob;
+          }
+      }
+    RPS_ASSERT(ix == nbloose);
+  }
+  unsigned nbsortedloose = sort_dedup_elements(loose, nbloose);
+  struct run_st
+  {
+    const Rps_ObjectRef*run_cur;
+    const Rps_ObjectRef*run_end;
+  } runs[collect_merge_maxsets+1];
+  unsigned nbruns = 0;
+  for (const Rps_Value*pv = beg; pv < end; pv++)
+    if (pv->is_set() && pv->as_set()->cardinal() > 0)
+      {
+        const Rps_SetOb*curset = pv->as_set();
+        runs[nbruns++] = run_st{curset->begin(), curset->end()};
+      }
+  if (nbsortedloose > 0)
+    runs[nbruns++] = run_st{loose, loose+nbsortedloose};
+  unsigned card = 0;
+  for (;;)
+    {
+      int minix = -1;
+      for (unsigned rix=0; rix<nbruns; rix++)
+        if (runs[rix].run_cur < runs[rix].run_end
+            && (minix < 0 || *runs[rix].run_cur < *runs[minix].run_cur))
+          minix = (int)rix;
+      if (minix < 0)
+        break;
+      Rps_ObjectRef minob = *(runs[minix].run_cur++);
+      if (card == 0 || arr[card-1] != minob)
+        arr[card++] = minob;
+    }
+  setob->shrink_to(card);
+  return setob;
+} // end Rps_SetOb::collect_from_range
+
+
+const Rps_SetOb*
+Rps_SetOb::collect(const std::vector<Rps_Value>&vecval)
+{
+  return collect_from_range(vecval.data(), vecval.data()+vecval.size());
 } // end of Rps_SetOb::collect with vector
 
 
+const Rps_SetOb*
+Rps_SetOb::collect(const std::initializer_list<Rps_Value>&valil)
+{
+  return collect_from_range(valil.begin(), valil.end());
+} // end of Rps_SetOb::collect with initializer_list
+
+
+const Rps_SetOb*
+Rps_SetOb::set_union(const Rps_SetOb*set1, const Rps_SetOb*set2)
+{
+  unsigned card1 = set1?set1->cardinal():0;
+  unsigned card2 = set2?set2->cardinal():0;
+  if (card2 == 0)
+    return set1?set1:&the_empty_set();
+  if (card1 == 0)
+    return set2;
+  if (card1 < card2)
+    {
+      std::swap(set1, set2);
+      std::swap(card1, card2);
+    }
+  // now set2 is the smaller one
+  Rps_SetOb*setob = allocate_for((size_t)card1 + card2);
+  Rps_ObjectRef*out = setob->raw_data();
+  const Rps_ObjectRef*p1 = set1->begin();
+  const Rps_ObjectRef*e1 = set1->end();
+  const Rps_ObjectRef*p2 = set2->begin();
+  const Rps_ObjectRef*e2 = set2->end();
+  bool galloping = card1 / card2 >= gallop_size_ratio;
+  while (p1 < e1 && p2 < e2)
+    {
+      if (galloping)
+        {
+          const Rps_ObjectRef*nx1 = gallop_lower_bound(p1, e1, *p2);
+          out = std::copy(p1, nx1, out);
+          p1 = nx1;
+          if (p1 < e1 && *p1 == *p2)
+            p1++;
+          *out++ = *p2++;
+        }
+      else if (*p1 < *p2)
+        *out++ = *p1++;
+      else if (*p2 < *p1)
+        *out++ = *p2++;
+      else
+        {
+          *out++ = *p1++;
+          p2++;
+        }
+    }
+  out = std::copy(p1, e1, out);
+  out = std::copy(p2, e2, out);
+  // when set2 was a subset of set1, the merge copied set1, so share it
+  // and leave the copy to the garbage collector
+  if ((unsigned)(out - setob->raw_data()) == card1)
+    return set1;
+  setob->shrink_to(out - setob->raw_data());
+  return setob;
+} // end Rps_SetOb::set_union
+
+
+const Rps_SetOb*
+Rps_SetOb::set_intersection(const Rps_SetOb*set1, const Rps_SetOb*set2)
+{
+  unsigned card1 = set1?set1->cardinal():0;
+  unsigned card2 = set2?set2->cardinal():0;
+  if (card1 == 0 || card2 == 0)
+    return &the_empty_set();
+  if (card1 < card2)
+    {
+      std::swap(set1, set2);
+      std::swap(card1, card2);
+    }
+  // now set2 is the smaller one, and bounds the result
+  if (*(set1->end()-1) < *set2->begin() || *(set2->end()-1) < *set1->begin())
+    return &the_empty_set();
+  Rps_SetOb*setob = allocate_for(card2);
+  Rps_ObjectRef*out = setob->raw_data();
+  const Rps_ObjectRef*p1 = set1->begin();
+  const Rps_ObjectRef*e1 = set1->end();
+  const Rps_ObjectRef*p2 = set2->begin();
+  const Rps_ObjectRef*e2 = set2->end();
+  bool galloping = card1 / card2 >= gallop_size_ratio;
+  while (p1 < e1 && p2 < e2)
+    {
+      if (galloping)
+        {
+          p1 = gallop_lower_bound(p1, e1, *p2);
+          if (p1 < e1 && *p1 == *p2)
+            *out++ = *p1++;
+          p2++;
+        }
+      else if (*p1 < *p2)
+        p1++;
+      else if (*p2 < *p1)
+        p2++;
+      else
+        {
+          *out++ = *p1++;
+          p2++;
+        }
+    }
+  // the merge found all of set2 in set1, so share it
+  if ((unsigned)(out - setob->raw_data()) == card2)
+    return set2;
+  setob->shrink_to(out - setob->raw_data());
+  return setob;
+} // end Rps_SetOb::set_intersection
+
+
+const Rps_SetOb*
+Rps_SetOb::set_difference(const Rps_SetOb*set1, const Rps_SetOb*set2)
+{
+  unsigned card1 = set1?set1->cardinal():0;
+  unsigned card2 = set2?set2->cardinal():0;
+  if (card1 == 0)
+    return &the_empty_set();
+  if (card2 == 0
+      || *(set1->end()-1) < *set2->begin() || *(set2->end()-1) < *set1->begin())
+    return set1;
+  Rps_SetOb*setob = allocate_for(card1);
+  Rps_ObjectRef*out = setob->raw_data();
+  const Rps_ObjectRef*p1 = set1->begin();
+  const Rps_ObjectRef*e1 = set1->end();
+  const Rps_ObjectRef*p2 = set2->begin();
+  const Rps_ObjectRef*e2 = set2->end();
+  if (card2 / card1 >= gallop_size_ratio)
+    {
+      // few elements to keep or drop, gallop in the big set2
+      for (; p1 < e1 && p2 < e2; p1++)
+        {
+          p2 = gallop_lower_bound(p2, e2, *p1);
+          if (p2 == e2 || *p2 != *p1)
+            *out++ = *p1;
+        }
+    }
+  else if (card1 / card2 >= gallop_size_ratio)
+    {
+      // few elements to drop, copy the runs between them
+      for (; p2 < e2 && p1 < e1; p2++)
+        {
+          const Rps_ObjectRef*nx1 = gallop_lower_bound(p1, e1, *p2);
+          out = std::copy(p1, nx1, out);
+          p1 = nx1;
+          if (p1 < e1 && *p1 == *p2)
+            p1++;
+        }
+    }
+  else
+    {
+      while (p1 < e1 && p2 < e2)
+        {
+          if (*p1 < *p2)
+            *out++ = *p1++;
+          else if (*p2 < *p1)
+            p2++;
+          else
+            {
+              p1++;
+              p2++;
+            }
+        }
+    }
+  out = std::copy(p1, e1, out);
+  // the merge dropped nothing, the sets are disjoint, so share set1
+  if ((unsigned)(out - setob->raw_data()) == card1)
+    return set1;
+  setob->shrink_to(out - setob->raw_data());
+  return setob;
+} // end Rps_SetOb::set_difference
+
+
+bool
+Rps_SetOb::is_subset_of(const Rps_SetOb*superset) const
+{
+  unsigned card = cardinal();
+  unsigned supercard = superset?superset->cardinal():0;
+  if (card == 0 || superset == this)
+    return true;
+  if (card > supercard)
+    return false;
+  const Rps_ObjectRef*ps = superset->begin();
+  const Rps_ObjectRef*es = superset->end();
+  // the bounds are checked first, they often refute quickly
+  if (*begin() < *ps || *(es-1) < *(end()-1))
+    return false;
+  bool galloping = supercard / card >= gallop_size_ratio;
+  for (const Rps_ObjectRef*p = begin(); p < end(); p++)
+    {
+      if (galloping)
+        ps = gallop_lower_bound(ps, es, *p);
+      else
+        while (ps < es && *ps < *p)
+          ps++;
+      if (ps == es || *ps != *p)
+        return false;
+      ps++;
+    }
+  return true;
+} // end Rps_SetOb::is_subset_of
+
+
+bool
+Rps_SetOb::intersects(const Rps_SetOb*otherset) const
+{
+  unsigned card1 = cardinal();
+  unsigned card2 = otherset?otherset->cardinal():0;
+  if (card1 == 0 || card2 == 0)
+    return false;
+  const Rps_ObjectRef*p1 = begin();
+  const Rps_ObjectRef*e1 = end();
+  const Rps_ObjectRef*p2 = otherset->begin();
+  const Rps_ObjectRef*e2 = otherset->end();
+  if (*(e1-1) < *p2 || *(e2-1) < *p1)
+    return false;
+  if (card1 > card2)
+    {
+      std::swap(p1, p2);
+      std::swap(e1, e2);
+      std::swap(card1, card2);
+    }
+  bool galloping = card2 / card1 >= gallop_size_ratio;
+  while (p1 < e1 && p2 < e2)
+    {
+      if (galloping)
+        {
+          p2 = gallop_lower_bound(p2, e2, *p1);
+          if (p2 < e2 && *p2 == *p1)
+            return true;
+          p1++;
+        }
+      else if (*p1 < *p2)
+        p1++;
+      else if (*p2 < *p1)
+        p2++;
+      else
+        return true;
+    }
+  return false;
+} // end Rps_SetOb::intersects
+
+
+const uint32_t*
+Rps_SetOb::side_index(void) const
+{
+  uint32_t*sidix = _seqsideindex.load(std::memory_order_acquire);
+  if (RPS_LIKELY(sidix != nullptr))
+    return sidix;
+  unsigned card = cardinal();
+  RPS_ASSERT(card >= sideindex_threshold);
+  // at most half full, so probe sequences stay short
+  uint32_t nbslots = 4;
+  while (nbslots < 2*card)
+    nbslots *= 2;
+  uint32_t mask = nbslots - 1;
+  int shift = 64 - __builtin_ctz(nbslots);
+  uint32_t*newix = new uint32_t[nbslots+1];
+  memset(newix, 0, sizeof(uint32_t)*(nbslots+1));
+  newix[0] = mask;
+  for (unsigned ix=0; ix<card; ix++)
+    {
+      uint32_t slot = (uint32_t)(sideindex_hash(_seqob[ix].optr()) >> shift);
+      while (newix[1+slot] != 0)
+        slot = (slot+1) & mask;
+      newix[1+slot] = ix+1;
+    }
+  // several threads might build it concurrently, the first one wins
+  if (_seqsideindex.compare_exchange_strong(sidix, newix,
+      std::memory_order_acq_rel))
+    {
+      count_side_allocation(sizeof(uint32_t)*(nbslots+1));
+      return newix;
+    }
+  delete[] newix;
+  return sidix;
+} // end Rps_SetOb::side_index
+
+
+int
+Rps_SetOb::side_index_find(const uint32_t*sidix, const Rps_ObjectZone*obz) const
+{
+  RPS_ASSERT(sidix != nullptr);
+  uint32_t mask = sidix[0];
+  int shift = 64 - __builtin_ctz(mask+1);
+  uint32_t slot = (uint32_t)(sideindex_hash(obz) >> shift);
+  for (;;)
+    {
+      uint32_t ixp1 = sidix[1+slot];
+      if (ixp1 == 0)
+        return -1;
+      if (_seqob[ixp1-1].optr() == obz)
+        return (int)(ixp1-1);
+      slot = (slot+1) & mask;
+    }
+} // end Rps_SetOb::side_index_find
+
+
 
 
 
@@ -309,95 +825,168 @@ Rps_SetOb::compute_class(Rps_CallFrame*) const
 const Rps_TupleOb*
 Rps_TupleOb::make(const std::vector<Rps_ObjectRef>& vecob)
 {
-  unsigned nbob = 0;
-  {
-    for (auto ob: vecob)
-      if (ob)
-        nbob++;
-  }
-  if (RPS_UNLIKELY(nbob > maxsize))
+  if (RPS_UNLIKELY(vecob.size() > maxsize))
     throw std::length_error("Rps_TupleOb::make too many objects");
-  if (RPS_LIKELY(nbob == vecob.size()))
-    {
-      auto tup =
-        rps_allocate_with_wordgap<Rps_TupleOb, unsigned, Rps_TupleTag>
-        (nbob, nbob, Rps_TupleTag{});
-      auto rd = tup->raw_data();
-      for (int ix=0; ix<(int)nbob; ix++) rd[ix] = vecob[ix];
-      return tup;
-    }
-  else
-    {
-      std::vector<Rps_ObjectRef> vec;
-      vec.reserve(nbob);
-      for (auto ob: vecob)
-        if (ob)
-          vec.push_back(ob);
-      return make(vec);
-    }
+  Rps_TupleBuilder tupb(vecob.size());
+  for (auto ob: vecob)
+    tupb.push_back(ob);
+  return tupb.seal();
 } // end Rps_TupleOb::make from vector
 
 const Rps_TupleOb*
 Rps_TupleOb::make(const std::initializer_list<Rps_ObjectRef>&compil)
 {
-  std::vector<Rps_ObjectRef> vec(compil);
-  return make(vec);
+  Rps_TupleBuilder tupb(compil.size());
+  for (auto ob: compil)
+    tupb.push_back(ob);
+  return tupb.seal();
 } // end of Rps_TupleOb::make from initializer_list
 
+// the number of objects Rps_TupleOb::collect would give for val
+static inline size_t
+rps_tuple_collect_count(const Rps_Value val)
+{
+  if (val.is_object())
+    return 1;
+  else if (val.is_tuple())
+    return val.as_tuple()->cnt();
+  else if (val.is_set())
+    return val.as_set()->cnt();
+  return 0;
+} // end rps_tuple_collect_count
+
 const Rps_TupleOb*
 Rps_TupleOb::collect(const std::vector<Rps_Value>& vecval)
 {
-  unsigned nbcomp = 0;
+  size_t nbcomp = 0;
   for (auto v : vecval)
-    {
-      if (v.is_object() && v.to_object() != nullptr)
-        nbcomp++;
-      else if (v.is_tuple())
-        nbcomp += v.to_tuple()->cnt();
-      else if (v.is_set())
-        nbcomp += v.to_set()->cnt();
-      else continue;
-      if (RPS_UNLIKELY(nbcomp > maxsize))
-        throw std::length_error("Rps_TupleOb::collect too many objects");
-    }
-  std::vector<Rps_ObjectRef> vecob;
-  vecob.reserve(nbcomp);
+    nbcomp += rps_tuple_collect_count(v);
+  if (RPS_UNLIKELY(nbcomp > maxsize))
+    throw std::length_error("Rps_TupleOb::collect too many objects");
+  Rps_TupleBuilder tupb(nbcomp);
   for (auto v : vecval)
-    {
-      if (v.is_object())
-        {
-          auto ob = v.to_object();
-          if (ob)
-            vecob.push_back(ob);
-        }
-      else if (v.is_tuple())
-        {
-          auto tup = v.to_tuple();
-          for (auto ob : *tup)
-            if (ob)
-              vecob.push_back(ob);
-        }
-      else if (v.is_set())
-        {
-          auto set = v.to_set();
-          for (auto ob : *set)
-            if (ob)
-              vecob.push_back(ob);
-        }
-      else continue;
-    }
-  return make(vecob);
+    tupb.append(v);
+  return tupb.seal();
 } // end of Rps_TupleOb::collect from vector
 
 
 const Rps_TupleOb*
 Rps_TupleOb::collect(const std::initializer_list<Rps_Value>&valil)
 {
-  std::vector<Rps_Value> vecval(valil);
-  return collect(vecval);
+  size_t nbcomp = 0;
+  for (auto v : valil)
+    nbcomp += rps_tuple_collect_count(v);
+  if (RPS_UNLIKELY(nbcomp > maxsize))
+    throw std::length_error("Rps_TupleOb::collect too many objects");
+  Rps_TupleBuilder tupb(nbcomp);
+  for (auto v : valil)
+    tupb.append(v);
+  return tupb.seal();
 } // end Rps_TupleOb::collect from initializer_list
 
 
+//////////////////////////////////////// tuple builders
+Rps_TupleBuilder::Rps_TupleBuilder(unsigned capacity)
+  : tupb_tuple(nullptr), tupb_count(0),
+    tupb_gccount(Rps_GarbageCollector::count())
+{
+  if (capacity > 0)
+    reallocate(capacity);
+} // end Rps_TupleBuilder::Rps_TupleBuilder
+
+void
+Rps_TupleBuilder::reallocate(unsigned newcap)
+{
+  RPS_ASSERT(newcap >= tupb_count);
+  check_gc_marked();
+  if (RPS_UNLIKELY(newcap > Rps_TupleOb::maxsize))
+    throw std::length_error("Rps_TupleBuilder with too many objects");
+  Rps_TupleOb*newtup =
+    Rps_QuasiZone::rps_allocate_with_wordgap<Rps_TupleOb, unsigned, Rps_TupleTag>
+    (newcap, newcap, Rps_TupleTag{});
+  // the old zone, never given, becomes garbage
+  if (tupb_count > 0)
+    memcpy((void*)newtup->_seqob, (const void*)tupb_tuple->_seqob,
+           tupb_count*sizeof(Rps_ObjectRef));
+  tupb_tuple = newtup;
+} // end Rps_TupleBuilder::reallocate
+
+void
+Rps_TupleBuilder::grow(unsigned mincapacity)
+{
+  unsigned oldcap = capacity();
+  unsigned newcap = (oldcap > 0) ? 2*oldcap : default_capacity;
+  if (newcap < mincapacity)
+    newcap = mincapacity;
+  reallocate(newcap);
+} // end Rps_TupleBuilder::grow
+
+void
+Rps_TupleBuilder::append(const Rps_TupleOb*tup)
+{
+  if (!tup)
+    return;
+  if (tupb_count + tup->cnt() > capacity())
+    grow(tupb_count + tup->cnt());
+  for (auto ob: *tup)
+    if (ob)
+      {
+        tupb_hasher.add(ob);
+        tupb_tuple->_seqob[tupb_count++] = ob;
+      }
+} // end Rps_TupleBuilder::append of tuple
+
+void
+Rps_TupleBuilder::append(const Rps_SetOb*set)
+{
+  if (!set)
+    return;
+  if (tupb_count + set->cnt() > capacity())
+    grow(tupb_count + set->cnt());
+  for (auto ob: *set)
+    {
+      tupb_hasher.add(ob);
+      tupb_tuple->_seqob[tupb_count++] = ob;
+    }
+} // end Rps_TupleBuilder::append of set
+
+void
+Rps_TupleBuilder::append(Rps_Value val)
+{
+  if (val.is_object())
+    push_back(Rps_ObjectRef(val.as_object()));
+  else if (val.is_tuple())
+    append(val.as_tuple());
+  else if (val.is_set())
+    append(val.as_set());
+} // end Rps_TupleBuilder::append of value
+
+void
+Rps_TupleBuilder::gc_mark(Rps_GarbageCollector&gc) const
+{
+  // the unused tail of the zone is cleared, so marking it all is fine
+  if (tupb_tuple)
+    gc.mark_value(Rps_Value(tupb_tuple, Rps_Value::Rps_ValPtrTag{}));
+  tupb_gccount = Rps_GarbageCollector::count();
+} // end Rps_TupleBuilder::gc_mark
+
+const Rps_TupleOb*
+Rps_TupleBuilder::seal(void)
+{
+  if (!tupb_tuple)
+    reallocate(0);
+  check_gc_marked();
+  Rps_TupleOb*tup = tupb_tuple;
+  RPS_ASSERT(tupb_count <= tup->_seqlen);
+  tup->_seqlen = tupb_count;
+  tup->put_precomputed_hash(tupb_hasher.result());
+  tupb_tuple = nullptr;
+  tupb_count = 0;
+  tupb_hasher = Rps_TupleOb::hasher();
+  return tup;
+} // end Rps_TupleBuilder::seal
+
+
 
 Rps_ObjectRef
 Rps_TupleOb::compute_class( Rps_CallFrame*) const
@@ -426,15 +1015,10 @@ Rps_ClosureZone::make(Rps_ObjectRef connob, const std::initializer_list<Rps_Valu
 {
   if (!connob)
     return nullptr;
-  auto nbsons = valil.size();
-  Rps_ClosureZone* cloz
-    = Rps_QuasiZone::rps_allocate_with_wordgap<Rps_ClosureZone,unsigned,Rps_ObjectRef,Rps_ClosureTag>((nbsons*sizeof(Rps_Value)/sizeof(void*)),
-        (unsigned)nbsons, connob,  Rps_ClosureTag{});
-  int ix=0;
-  Rps_Value*sonarr = cloz->raw_data_sons();
+  Rps_ClosureBuilder clob(connob, valil.size());
   for (auto val: valil)
-    sonarr[ix++] = val;
-  return cloz;
+    clob.push_back(val);
+  return clob.seal();
 } // end ClosureZone::make
 
 Rps_ClosureZone*
@@ -442,15 +1026,10 @@ Rps_ClosureZone::make(Rps_ObjectRef connob, const std::vector<Rps_Value>& valvec
 {
   if (!connob)
     return nullptr;
-  auto nbsons = valvec.size();
-  Rps_ClosureZone* cloz
-    = Rps_QuasiZone::rps_allocate_with_wordgap<Rps_ClosureZone,unsigned,Rps_ObjectRef,Rps_ClosureTag>((nbsons*sizeof(Rps_Value)/sizeof(void*)),
-        (unsigned)nbsons, connob, Rps_ClosureTag{});
-  int ix=0;
-  Rps_Value*sonarr = cloz->raw_data_sons();
+  Rps_ClosureBuilder clob(connob, valvec.size());
   for (auto val: valvec)
-    sonarr[ix++] = val;
-  return cloz;
+    clob.push_back(val);
+  return clob.seal();
 } // end ClosureZone::make
 
 
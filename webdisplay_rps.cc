@@ -289,7 +289,7 @@ rpsapply_0TwK4TkhEGZ03oTa5m(Rps_CallFrame*callerframe, ///
         }
       else   // too deep
         {
-          *pout << "<span class='json_rpscl'>JSON_" << _f.val0v.as_json()->json().size() << "</span>";
+          *pout << "<span class='json_rpscl'>JSON_" << _f.val0v.as_json()->size() << "</span>";
         }
       return Rps_TwoValues{ _f.webob1};
     }
@@ -360,7 +360,7 @@ rps_web_display_html_for_objref(Rps_CallFrame*callerframe,
   if (_f.namev.is_string())
     {
       *pout << "<span class='namedob_rpscl' rps_obid='" << _f.obdisp0->oid() << "'>"
-            << Rps_Html_Nl2br_String(_f.namev.to_string()->cppstring())
+            << Rps_Html_Nl2br_String(_f.namev.to_cppstring())
             << "</span>";
     }
   else   // no name
@@ -883,7 +883,7 @@ rpsapply_42cCN1FRQSS03bzbTz(Rps_CallFrame*callerframe, ///
     }
   else   // too deep
     {
-      *pout << "<span class='json_rpscl'>JSON_" << _f.jsrecv.as_json()->json().size() << "</span>";
+      *pout << "<span class='json_rpscl'>JSON_" << _f.jsrecv.as_json()->size() << "</span>";
     }
   return Rps_TwoValues{ _f.obweb};
 } // end of rpsapply_42cCN1FRQSS03bzbTz !method json/display_value_web